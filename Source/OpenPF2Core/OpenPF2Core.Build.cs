@@ -28,6 +28,7 @@ public class OpenPF2Core: ModuleRules
 				"CoreUObject",
 				"Engine",
 				"GameplayAbilities",
+				"NetCore",
 				"Slate",
 				"SlateCore",
 			}
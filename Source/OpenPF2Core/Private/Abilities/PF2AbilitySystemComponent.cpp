@@ -1,26 +1,73 @@
-// OpenPF2 for UE Game Logic, Copyright 2021-2022, Guy Elsmore-Paddock. All Rights Reserved.
+﻿// OpenPF2 for UE Game Logic, Copyright 2021-2022, Guy Elsmore-Paddock. All Rights Reserved.
 //
 // This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
 // distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "Abilities/PF2AbilitySystemComponent.h"
 
+#include <Engine/Engine.h>
+#include <Engine/World.h>
+#include <HAL/IConsoleManager.h>
+#include <Net/UnrealNetwork.h>
+#include <Net/Core/PushModel/PushModel.h>
+#include <Async/ParallelFor.h>
 #include <UObject/ConstructorHelpers.h>
+#include <UObject/UObjectIterator.h>
 
 #include "PF2CharacterConstants.h"
 #include "PF2CharacterInterface.h"
+#include "Abilities/PF2AttributeSet.h"
+#include "Abilities/PF2CompositeGameplayEffectSubsystem.h"
+#include "Abilities/PF2DerivedStatistics.h"
+#include "Abilities/PF2PassiveEffectBatch.h"
 #include "Utilities/PF2ArrayUtilities.h"
 #include "Utilities/PF2EnumUtilities.h"
 
-UPF2AbilitySystemComponent::UPF2AbilitySystemComponent()
-{
-	const FString DynamicTagsGeFilename =
-		PF2CharacterConstants::GetBlueprintPath(*PF2CharacterConstants::GeDynamicTagsName);
-
-	const ConstructorHelpers::FObjectFinder<UClass> DynamicTagsGeFinder(*DynamicTagsGeFilename);
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GDumpPassiveEffectStatsCommand(
+	TEXT("OpenPF2.DumpPassiveEffectStats"),
+	TEXT(
+		"Dumps the passive GE work done by ASCs in the current world, by trigger, followed by the ASCs that spent the "
+		"most time on passive GEs. Usage: OpenPF2.DumpPassiveEffectStats [MaxAscs=10]"
+	),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+		[](const TArray<FString>& Args, UWorld* World, FOutputDevice& Output)
+		{
+			const int32 MaxAscs = (Args.Num() == 0) ? 10 : FMath::Max(0, FCString::Atoi(*Args[0]));
 
-	this->DynamicTagsEffect = DynamicTagsGeFinder.Object;
+			if (World != nullptr)
+			{
+				UPF2AbilitySystemComponent::DumpPassiveEffectStats(World, MaxAscs, Output);
+			}
+		}
+	)
+);
 
+static FAutoConsoleCommandWithWorld GResetPassiveEffectStatsCommand(
+	TEXT("OpenPF2.ResetPassiveEffectStats"),
+	TEXT("Discards the passive GE stats of all ASCs in the current world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		for (UPF2AbilitySystemComponent* Asc : TObjectRange<UPF2AbilitySystemComponent>())
+		{
+			if (Asc->GetWorld() == World)
+			{
+				Asc->ResetPassiveEffectStats();
+			}
+		}
+	})
+);
+
+UPF2AbilitySystemComponent::UPF2AbilitySystemComponent() :
+	bCombinePassiveGameplayEffects(false),
+	PassiveEffectBatchDepth(0),
+	bPassiveEffectBatchActivationRequested(false),
+	bPassiveEffectBatchLevelChanged(false),
+	LastStateSnapshotId(0),
+	bRestoringStateSnapshot(false),
+	bAttributeChangeFeedBound(false),
+	bAttributeValueCallbacksBound(false),
+	bDerivedStatisticsReplicationDirty(false)
+{
 	for (const auto& Ability : TEnumRange<EPF2CharacterAbilityScoreType>())
 	{
 		const FString AbilityName = PF2EnumUtilities::ToString(Ability);
@@ -38,6 +85,127 @@ UPF2AbilitySystemComponent::UPF2AbilitySystemComponent()
 	}
 }
 
+void UPF2AbilitySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPF2AbilitySystemComponent, DynamicTags, Params);
+}
+
+void UPF2AbilitySystemComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// Inputs are normally handled at the end of the frame in which they changed, but one that changed after that (e.g.,
+	// in a timer) still has to make it into this update.
+	if (this->bDerivedStatisticsReplicationDirty)
+	{
+		this->UpdateDerivedStatisticsForReplication();
+	}
+}
+
+void UPF2AbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor)
+{
+	// Cached passive GE specs were made for the old source, so they cannot be re-used for the new one.
+	this->PassiveEffectSpecCache.Reset();
+
+	Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
+
+	this->BindAttributeValueCallbacks();
+	this->BindAttributeChangeFeed();
+}
+
+void UPF2AbilitySystemComponent::OnUnregister()
+{
+	Super::OnUnregister();
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(this->AttributeChangeFeedFlushHandle);
+	this->AttributeChangeFeedFlushHandle.Reset();
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(this->DerivedStatisticsUpdateHandle);
+	this->DerivedStatisticsUpdateHandle.Reset();
+}
+
+void UPF2AbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	const FGameplayAbilitySpecHandle    Handle = AbilitySpec.Handle;
+	const TArray<FGameplayAbilitySpec>& Specs  = this->ActivatableAbilities.Items;
+	const int32                         Index  = &AbilitySpec - Specs.GetData();
+	FGameplayTagContainer               IndexTags;
+
+	Super::OnGiveAbility(AbilitySpec);
+
+	if (AbilitySpec.Ability == nullptr)
+	{
+		return;
+	}
+
+	this->AbilitySpecsByClass.FindOrAdd(AbilitySpec.Ability->GetClass()).Add(Handle);
+
+	// Index each tag under all of its parents too, so that looking up a parent tag finds abilities with child tags.
+	for (const FGameplayTag& Tag : AbilitySpec.Ability->AbilityTags)
+	{
+		IndexTags.AppendTags(Tag.GetGameplayTagParents());
+	}
+
+	for (const FGameplayTag& Tag : IndexTags)
+	{
+		this->AbilitySpecsByTag.FindOrAdd(Tag).Add(Handle);
+	}
+
+	if (Specs.IsValidIndex(Index))
+	{
+		this->AbilitySpecIndices.Add(Handle, Index);
+	}
+}
+
+void UPF2AbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	const FGameplayAbilitySpecHandle Handle = AbilitySpec.Handle;
+
+	if (AbilitySpec.Ability != nullptr)
+	{
+		const TSubclassOf<UGameplayAbility> AbilityClass = AbilitySpec.Ability->GetClass();
+		auto*                               ClassSpecs   = this->AbilitySpecsByClass.Find(AbilityClass);
+
+		if (ClassSpecs != nullptr)
+		{
+			ClassSpecs->Remove(Handle);
+
+			if (ClassSpecs->Num() == 0)
+			{
+				this->AbilitySpecsByClass.Remove(AbilityClass);
+			}
+		}
+
+		for (const FGameplayTag& Tag : AbilitySpec.Ability->AbilityTags)
+		{
+			for (const FGameplayTag& IndexTag : Tag.GetGameplayTagParents())
+			{
+				TArray<FGameplayAbilitySpecHandle>* TagSpecs = this->AbilitySpecsByTag.Find(IndexTag);
+
+				if (TagSpecs != nullptr)
+				{
+					TagSpecs->Remove(Handle);
+
+					if (TagSpecs->Num() == 0)
+					{
+						this->AbilitySpecsByTag.Remove(IndexTag);
+					}
+				}
+			}
+		}
+	}
+
+	this->AbilitySpecIndices.Remove(Handle);
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
 UAbilitySystemComponent* UPF2AbilitySystemComponent::ToAbilitySystemComponent()
 {
 	return Cast<UAbilitySystemComponent>(this);
@@ -45,6 +213,8 @@ UAbilitySystemComponent* UPF2AbilitySystemComponent::ToAbilitySystemComponent()
 
 void UPF2AbilitySystemComponent::AddPassiveGameplayEffect(const TSubclassOf<UGameplayEffect> Effect)
 {
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::AddPassiveEffect);
+
 	const FName WeightGroup = PF2GameplayAbilityUtilities::GetWeightGroupOfGameplayEffect(Effect);
 
 	this->AddPassiveGameplayEffectWithWeight(WeightGroup, Effect);
@@ -54,87 +224,175 @@ void UPF2AbilitySystemComponent::AddPassiveGameplayEffectWithWeight(
 	const FName                        WeightGroup,
 	const TSubclassOf<UGameplayEffect> Effect)
 {
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::AddPassiveEffect);
+
 	// Special case: If this is the first time a GE from this weight group is being added, and other weight groups are
 	// active, let's assume that we want to enable the new weight group.
 	if ((this->PassiveGameplayEffects.Num(WeightGroup) == 0) && this->ArePassiveGameplayEffectsActive())
 	{
-		this->ActivatedWeightGroups.Add(WeightGroup);
+		this->ActivatedWeightGroups.Add(WeightGroup, PF2GameplayAbilityUtilities::GetWeightGroupOrdinal(WeightGroup));
 	}
 
 	this->InvokeAndReapplyPassiveGEsInSubsequentWeightGroups(WeightGroup, [this, WeightGroup, Effect]
 	{
+		this->RecordPassiveGameplayEffectsForSnapshot();
+
 		this->PassiveGameplayEffects.Add(WeightGroup, Effect);
-		this->CachedPassiveGameplayEffectsToApply.Empty();
+		this->ClearPassiveGameplayEffectsCache();
 
-		if (this->ActivatedWeightGroups.Contains(WeightGroup))
+		// Activate the new passive GE since it's being put into an active group. During a batch, the whole group gets
+		// re-applied when the batch ends, so there is no need to activate the GE now.
+		if (this->ActivatedWeightGroups.Contains(WeightGroup) && !this->IsPassiveGameplayEffectBatchOpen())
 		{
-			// Activate the new passive GE since it's being put into an active group.
-			this->ActivatePassiveGameplayEffect(WeightGroup, Effect);
+			// Stackable GEs (e.g., ability boosts) and composite GEs are active at most once per weight group, so the
+			// GE is replaced rather than being activated a second time.
+			this->ReplacePassiveGameplayEffects(
+				*this->GetPassiveEffectPlan(),
+				{FPassiveEffectKey(WeightGroup, Effect)}
+			);
 		}
 	});
 }
 
-void UPF2AbilitySystemComponent::SetPassiveGameplayEffects(const TMultiMap<FName, TSubclassOf<UGameplayEffect>> Effects)
+void UPF2AbilitySystemComponent::SetPassiveGameplayEffects(
+	const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& Effects)
 {
-	this->InvokeAndReapplyAllPassiveGEs([this, Effects]
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::SetPassiveEffects);
+
+	const TSharedRef<const FPF2PassiveEffectPlan>  OldPlan = this->GetPassiveEffectPlan();
+	TMultiMap<FName, TSubclassOf<UGameplayEffect>> RemovedEffects,
+	                                               AddedEffects;
+
+	DiffPassiveGameplayEffects(this->PassiveGameplayEffects, Effects, RemovedEffects, AddedEffects);
+
+	if ((RemovedEffects.Num() == 0) && (AddedEffects.Num() == 0))
 	{
-		this->PassiveGameplayEffects = Effects;
-		this->CachedPassiveGameplayEffectsToApply.Empty();
-	});
+		// Nothing has changed.
+		return;
+	}
+
+	this->RecordPassiveGameplayEffectsForSnapshot();
+
+	this->PassiveGameplayEffects = Effects;
+	this->ClearPassiveGameplayEffectsCache();
+
+	if (!this->ArePassiveGameplayEffectsActive())
+	{
+		// Nothing to re-apply.
+		return;
+	}
+
+	if (this->IsPassiveGameplayEffectBatchOpen())
+	{
+		for (const auto& EffectInfo : RemovedEffects)
+		{
+			this->PassiveEffectBatchDirtyWeightGroups.Add(EffectInfo.Key);
+		}
+
+		for (const auto& EffectInfo : AddedEffects)
+		{
+			// Same special case as AddPassiveGameplayEffectWithWeight(): a brand-new weight group is activated along
+			// with the other weight groups.
+			if (OldPlan->GetEntriesInWeightGroup(EffectInfo.Key).Num() == 0)
+			{
+				this->ActivatedWeightGroups.Add(
+					EffectInfo.Key,
+					PF2GameplayAbilityUtilities::GetWeightGroupOrdinal(EffectInfo.Key)
+				);
+			}
+
+			this->PassiveEffectBatchDirtyWeightGroups.Add(EffectInfo.Key);
+		}
+	}
+	else
+	{
+		this->ApplyPassiveGameplayEffectChanges(*OldPlan, RemovedEffects, AddedEffects);
+	}
 }
 
 void UPF2AbilitySystemComponent::RemoveAllPassiveGameplayEffects()
 {
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::RemovePassiveEffects);
+
 	this->DeactivateAllPassiveGameplayEffects();
 
+	if (this->PassiveGameplayEffects.Num() != 0)
+	{
+		this->RecordPassiveGameplayEffectsForSnapshot();
+	}
+
 	this->PassiveGameplayEffects.Empty();
-	this->CachedPassiveGameplayEffectsToApply.Empty();
+	this->ClearPassiveGameplayEffectsCache();
+	this->PassiveEffectSpecCache.Reset();
 }
 
 void UPF2AbilitySystemComponent::ActivateAllPassiveGameplayEffects()
 {
-	const TMultiMap<FName, TSubclassOf<UGameplayEffect>> EffectsToApply = this->GetPassiveGameplayEffectsToApply();
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::ActivatePassiveEffects);
 
-	TSet<FName> AllWeightGroups,
-	            InactiveGroups;
-
-	EffectsToApply.GetKeys(AllWeightGroups);
+	if (this->IsPassiveGameplayEffectBatchOpen())
+	{
+		// Defer activation until the batch ends, so all changes in the batch are applied in a single pass.
+		this->bPassiveEffectBatchActivationRequested = true;
+		return;
+	}
 
-	InactiveGroups = AllWeightGroups.Difference(this->ActivatedWeightGroups);
+	const TSharedRef<const FPF2PassiveEffectPlan> Plan = this->GetPassiveEffectPlan();
 
-	for (const auto& InactiveGroup : InactiveGroups)
+	// Groups that are already active are skipped by ActivatePassiveGameplayEffects().
+	for (const FPF2PassiveEffectPlanSpan& Span : Plan->GetWeightGroupSpans())
 	{
-		this->ActivatePassiveGameplayEffects(InactiveGroup);
+		this->ActivatePassiveGameplayEffects(Span.WeightGroup);
 	}
 }
 
 void UPF2AbilitySystemComponent::DeactivateAllPassiveGameplayEffects()
 {
-	FGameplayEffectQuery Query;
+	FPF2PassiveEffectStatsScope StatsScope(
+		this->PassiveEffectStats,
+		EPF2PassiveEffectTrigger::DeactivatePassiveEffects
+	);
 
-	Query.EffectSource = this;
+	// Take ownership of the handles first, in case removing a GE triggers logic that applies passive GEs again.
+	const TMap<FName, TArray<FPF2ActivePassiveEffect>> EffectsToRemove = MoveTemp(this->ActivePassiveEffects);
+
+	this->ActivePassiveEffects.Reset();
+
+	for (const auto& GroupEffects : EffectsToRemove)
+	{
+		for (const FPF2ActivePassiveEffect& ActiveEffect : GroupEffects.Value)
+		{
+			this->RemovePassiveGameplayEffect(ActiveEffect.Handle);
+		}
+	}
 
-	this->RemoveActiveEffects(Query);
 	this->ActivatedWeightGroups.Empty();
+
+	// Cancel any activation that was requested earlier in the current batch.
+	this->bPassiveEffectBatchActivationRequested = false;
 }
 
 TSet<FName> UPF2AbilitySystemComponent::ActivatePassiveGameplayEffectsAfter(const FName StartingWeightGroup)
 {
-	const TMultiMap<FName, TSubclassOf<UGameplayEffect>> EffectsToApply = this->GetPassiveGameplayEffectsToApply();
-
-	TSet<FName> AllWeightGroups,
-	            InactiveGroups,
-	            ActivatedGroups;
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::ActivatePassiveEffects);
 
-	EffectsToApply.GetKeys(AllWeightGroups);
+	const TSharedRef<const FPF2PassiveEffectPlan> Plan            = this->GetPassiveEffectPlan();
+	const int32                                   StartingOrdinal = this->GetWeightGroupOrdinal(StartingWeightGroup);
+	TSet<FName>                                   ActivatedGroups;
 
-	InactiveGroups = AllWeightGroups.Difference(this->ActivatedWeightGroups);
-
-	for (const auto& InactiveGroup : InactiveGroups)
+	for (const FPF2PassiveEffectPlanSpan& Span : Plan->GetWeightGroupSpans())
 	{
-		if (StartingWeightGroup.LexicalLess(InactiveGroup) && this->ActivatePassiveGameplayEffects(InactiveGroup))
+		const FName WeightGroup = Span.WeightGroup;
+		const bool  bIsAfter    = PF2GameplayAbilityUtilities::IsWeightGroupBefore(
+			StartingWeightGroup,
+			StartingOrdinal,
+			WeightGroup,
+			Span.WeightGroupOrdinal
+		);
+
+		if (bIsAfter && this->ActivatePassiveGameplayEffects(WeightGroup))
 		{
-			ActivatedGroups.Add(InactiveGroup);
+			ActivatedGroups.Add(WeightGroup);
 		}
 	}
 
@@ -143,14 +401,29 @@ TSet<FName> UPF2AbilitySystemComponent::ActivatePassiveGameplayEffectsAfter(cons
 
 TSet<FName> UPF2AbilitySystemComponent::DeactivatePassiveGameplayEffectsAfter(const FName StartingWeightGroup)
 {
+	FPF2PassiveEffectStatsScope StatsScope(
+		this->PassiveEffectStats,
+		EPF2PassiveEffectTrigger::DeactivatePassiveEffects
+	);
+
+	const int32 StartingOrdinal = this->GetWeightGroupOrdinal(StartingWeightGroup);
 	TSet<FName> DeactivatedGroups;
 
-	// We have to make a copy of the set because we'll be modifying it in the loop.
-	TSet<FName> WeightGroups = this->ActivatedWeightGroups;
+	// We have to make a copy of the map because we'll be modifying it in the loop.
+	const TMap<FName, int32> WeightGroups = this->ActivatedWeightGroups;
 
-	for (const FName& ActiveGroup : WeightGroups)
+	for (const auto& WeightGroupInfo : WeightGroups)
 	{
-		if (StartingWeightGroup.LexicalLess(ActiveGroup) && this->DeactivatePassiveGameplayEffects(ActiveGroup))
+		const FName ActiveGroup   = WeightGroupInfo.Key;
+		const int32 ActiveOrdinal = WeightGroupInfo.Value;
+		const bool  bIsAfter      = PF2GameplayAbilityUtilities::IsWeightGroupBefore(
+			StartingWeightGroup,
+			StartingOrdinal,
+			ActiveGroup,
+			ActiveOrdinal
+		);
+
+		if (bIsAfter && this->DeactivatePassiveGameplayEffects(ActiveGroup))
 		{
 			DeactivatedGroups.Add(ActiveGroup);
 		}
@@ -161,23 +434,34 @@ TSet<FName> UPF2AbilitySystemComponent::DeactivatePassiveGameplayEffectsAfter(co
 
 bool UPF2AbilitySystemComponent::ActivatePassiveGameplayEffects(const FName WeightGroup)
 {
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::ActivatePassiveEffects);
+
 	if (this->ActivatedWeightGroups.Contains(WeightGroup))
 	{
 		return false;
 	}
 	else
 	{
-		const TMultiMap<FName, TSubclassOf<UGameplayEffect>> AllEffects   = this->GetPassiveGameplayEffectsToApply();
-		TArray<TSubclassOf<UGameplayEffect>>                 GroupEffects;
+		const TSharedRef<const FPF2PassiveEffectPlan>      Plan    = this->GetPassiveEffectPlan();
+		const TArrayView<const FPF2PassiveEffectPlanEntry> Entries = Plan->GetEntriesInWeightGroup(WeightGroup);
+		int32                                              Ordinal;
 
-		AllEffects.MultiFind(WeightGroup, GroupEffects, true);
+		for (const FPF2PassiveEffectPlanEntry& Entry : Entries)
+		{
+			this->ActivatePassiveGameplayEffect(Entry);
+		}
 
-		for (const auto& GameplayEffect : GroupEffects)
+		if (Entries.Num() == 0)
+		{
+			// A weight group can be activated before any GEs are added to it.
+			Ordinal = PF2GameplayAbilityUtilities::GetWeightGroupOrdinal(WeightGroup);
+		}
+		else
 		{
-			this->ActivatePassiveGameplayEffect(WeightGroup, GameplayEffect);
+			Ordinal = Entries[0].WeightGroupOrdinal;
 		}
 
-		this->ActivatedWeightGroups.Add(WeightGroup);
+		this->ActivatedWeightGroups.Add(WeightGroup, Ordinal);
 
 		return true;
 	}
@@ -185,23 +469,29 @@ bool UPF2AbilitySystemComponent::ActivatePassiveGameplayEffects(const FName Weig
 
 bool UPF2AbilitySystemComponent::DeactivatePassiveGameplayEffects(const FName WeightGroup)
 {
+	FPF2PassiveEffectStatsScope StatsScope(
+		this->PassiveEffectStats,
+		EPF2PassiveEffectTrigger::DeactivatePassiveEffects
+	);
+
 	if (!this->ActivatedWeightGroups.Contains(WeightGroup))
 	{
 		return false;
 	}
 	else
 	{
-		FGameplayEffectQuery Query;
-		int32                NumRemoved;
+		TArray<FPF2ActivePassiveEffect> EffectsToRemove;
+		int32                           NumRemoved = 0;
 
-		Query.EffectSource = this;
-
-		Query.EffectTagQuery =
-			FGameplayTagQuery::MakeQuery_MatchAnyTags(
-				FGameplayTagContainer(PF2GameplayAbilityUtilities::GetTag(WeightGroup))
-			);
+		this->ActivePassiveEffects.RemoveAndCopyValue(WeightGroup, EffectsToRemove);
 
-		NumRemoved = this->RemoveActiveEffects(Query);
+		for (const FPF2ActivePassiveEffect& ActiveEffect : EffectsToRemove)
+		{
+			if (this->RemovePassiveGameplayEffect(ActiveEffect.Handle))
+			{
+				++NumRemoved;
+			}
+		}
 
 		this->ActivatedWeightGroups.Remove(WeightGroup);
 
@@ -211,7 +501,7 @@ bool UPF2AbilitySystemComponent::DeactivatePassiveGameplayEffects(const FName We
 
 void UPF2AbilitySystemComponent::AddDynamicTag(const FGameplayTag Tag)
 {
-	this->InvokeAndReapplyAllPassiveGEs([this, Tag]
+	this->InvokeAndReapplyPassiveGEsAffectedByDynamicTags([this, Tag]
 	{
 		UE_LOG(
 			LogPf2Core,
@@ -227,7 +517,7 @@ void UPF2AbilitySystemComponent::AddDynamicTag(const FGameplayTag Tag)
 
 void UPF2AbilitySystemComponent::AppendDynamicTags(const FGameplayTagContainer Tags)
 {
-	this->InvokeAndReapplyAllPassiveGEs([this, Tags]
+	this->InvokeAndReapplyPassiveGEsAffectedByDynamicTags([this, Tags]
 	{
 		UE_LOG(
 			LogPf2Core,
@@ -243,7 +533,7 @@ void UPF2AbilitySystemComponent::AppendDynamicTags(const FGameplayTagContainer T
 
 void UPF2AbilitySystemComponent::SetDynamicTags(const FGameplayTagContainer Tags)
 {
-	this->InvokeAndReapplyAllPassiveGEs([this, Tags]
+	this->InvokeAndReapplyPassiveGEsAffectedByDynamicTags([this, Tags]
 	{
 		UE_LOG(
 			LogPf2Core,
@@ -259,7 +549,7 @@ void UPF2AbilitySystemComponent::SetDynamicTags(const FGameplayTagContainer Tags
 
 void UPF2AbilitySystemComponent::RemoveDynamicTag(const FGameplayTag Tag)
 {
-	this->InvokeAndReapplyAllPassiveGEs([this, Tag]
+	this->InvokeAndReapplyPassiveGEsAffectedByDynamicTags([this, Tag]
 	{
 		UE_LOG(
 			LogPf2Core,
@@ -275,7 +565,7 @@ void UPF2AbilitySystemComponent::RemoveDynamicTag(const FGameplayTag Tag)
 
 void UPF2AbilitySystemComponent::RemoveDynamicTags(const FGameplayTagContainer Tags)
 {
-	this->InvokeAndReapplyAllPassiveGEs([this, Tags]
+	this->InvokeAndReapplyPassiveGEsAffectedByDynamicTags([this, Tags]
 	{
 		UE_LOG(
 			LogPf2Core,
@@ -291,7 +581,7 @@ void UPF2AbilitySystemComponent::RemoveDynamicTags(const FGameplayTagContainer T
 
 void UPF2AbilitySystemComponent::RemoveAllDynamicTags()
 {
-	this->InvokeAndReapplyAllPassiveGEs([this]
+	this->InvokeAndReapplyPassiveGEsAffectedByDynamicTags([this]
 	{
 		UE_LOG(
 			LogPf2Core,
@@ -304,206 +594,1536 @@ void UPF2AbilitySystemComponent::RemoveAllDynamicTags()
 	});
 }
 
-FGameplayTagContainer UPF2AbilitySystemComponent::GetActiveGameplayTags() const
+void UPF2AbilitySystemComponent::BeginPassiveGameplayEffectBatch()
 {
-	FGameplayTagContainer Tags;
-
-	Tags.Reset();
-
-	this->GetOwnedGameplayTags(Tags);
+	if (this->PassiveEffectBatchDepth == 0)
+	{
+		this->PassiveEffectBatchInitialDynamicTags = this->DynamicTags;
+	}
 
-	return Tags;
+	++this->PassiveEffectBatchDepth;
 }
 
-FORCEINLINE int32 UPF2AbilitySystemComponent::GetCharacterLevel() const
+void UPF2AbilitySystemComponent::EndPassiveGameplayEffectBatch()
 {
-	IPF2CharacterInterface* OwningCharacter = Cast<IPF2CharacterInterface>(this->GetOwnerActor());
+	checkf(
+		this->PassiveEffectBatchDepth > 0,
+		TEXT("EndPassiveGameplayEffectBatch() was called without a matching call to BeginPassiveGameplayEffectBatch().")
+	);
 
-	if (OwningCharacter == nullptr)
-	{
-		return 1;
-	}
-	else
+	--this->PassiveEffectBatchDepth;
+
+	if (this->PassiveEffectBatchDepth == 0)
 	{
-		return OwningCharacter->GetCharacterLevel();
+		FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::Batch);
+
+		this->ReconcilePassiveGameplayEffectBatch();
 	}
 }
 
-TMap<EPF2CharacterAbilityScoreType, FPF2AttributeModifierSnapshot> UPF2AbilitySystemComponent::GetAbilityScoreValues() const
+FPF2StateSnapshotHandle UPF2AbilitySystemComponent::TakeStateSnapshot()
 {
-	const UPF2AttributeSet* AttributeSet =
-		Cast<UPF2AttributeSet>(this->GetAttributeSubobject(UPF2AttributeSet::StaticClass()));
+	++this->LastStateSnapshotId;
 
-	const TMap<EPF2CharacterAbilityScoreType, FPF2AttributeModifierSnapshot> Values =
-		{
-			{
-				EPF2CharacterAbilityScoreType::AbStrength,
-				FPF2AttributeModifierSnapshot(
-					AttributeSet->AbStrength.GetCurrentValue(),
-					AttributeSet->AbStrengthModifier.GetCurrentValue()
-				)
-			},
-			{
-				EPF2CharacterAbilityScoreType::AbDexterity,
-				FPF2AttributeModifierSnapshot(
-					AttributeSet->AbDexterity.GetCurrentValue(),
-					AttributeSet->AbDexterityModifier.GetCurrentValue()
-				)
-			},
-			{
-				EPF2CharacterAbilityScoreType::AbConstitution,
-				FPF2AttributeModifierSnapshot(
-					AttributeSet->AbConstitution.GetCurrentValue(),
-					AttributeSet->AbConstitutionModifier.GetCurrentValue()
-				)
-			},
-			{
-				EPF2CharacterAbilityScoreType::AbIntelligence,
-				FPF2AttributeModifierSnapshot(
-					AttributeSet->AbIntelligence.GetCurrentValue(),
-					AttributeSet->AbIntelligenceModifier.GetCurrentValue()
-				)
-			},
-			{
-				EPF2CharacterAbilityScoreType::AbWisdom,
-				FPF2AttributeModifierSnapshot(
-					AttributeSet->AbWisdom.GetCurrentValue(),
-					AttributeSet->AbWisdomModifier.GetCurrentValue()
-				)
-			},
-			{
-				EPF2CharacterAbilityScoreType::AbCharisma,
-				FPF2AttributeModifierSnapshot(
-					AttributeSet->AbCharisma.GetCurrentValue(),
-					AttributeSet->AbCharismaModifier.GetCurrentValue()
-				)
-			},
-		};
+	this->StateSnapshotLayers.Emplace(this->LastStateSnapshotId);
 
-	return Values;
+	return FPF2StateSnapshotHandle(this->LastStateSnapshotId);
 }
 
-TArray<UPF2AbilityBoostBase*> UPF2AbilitySystemComponent::GetPendingAbilityBoosts() const
+bool UPF2AbilitySystemComponent::RestoreStateSnapshot(const FPF2StateSnapshotHandle Snapshot)
 {
-	TArray<UPF2AbilityBoostBase*> MatchingGameplayAbilities;
-	TArray<FGameplayAbilitySpec*> MatchingGameplayAbilitySpecs;
+	const int32 LayerIndex = this->FindStateSnapshotLayer(Snapshot);
 
-	this->GetActivatableGameplayAbilitySpecsByAllMatchingTags(
-		FGameplayTagContainer(PF2GameplayAbilityUtilities::GetTag(FName("GameplayAbility.Type.AbilityBoost"))),
-		MatchingGameplayAbilitySpecs,
-		false
-	);
+	if (LayerIndex == INDEX_NONE)
+	{
+		return false;
+	}
+	else
+	{
+		const FPF2StateSnapshotLayer Layer = this->PopStateSnapshotLayers(LayerIndex);
+		TGuardValue<bool>            RestoringGuard(this->bRestoringStateSnapshot, true);
 
-	MatchingGameplayAbilities =
-		PF2ArrayUtilities::Map<UPF2AbilityBoostBase*>(
-			MatchingGameplayAbilitySpecs,
-			[](const FGameplayAbilitySpec* AbilitySpec)
+		{
+			// Collect the changes to tags and passive GEs so that affected passive GEs get re-applied only once.
+			FPF2PassiveEffectBatch PassiveEffectBatch(this);
+
+			if (Layer.DynamicTags.IsSet())
 			{
-				return Cast<UPF2AbilityBoostBase>(AbilitySpec->Ability);
+				this->SetDynamicTags(Layer.DynamicTags.GetValue());
 			}
-		);
-
-	return MatchingGameplayAbilities;
-}
-
-void UPF2AbilitySystemComponent::ApplyAbilityBoost(const EPF2CharacterAbilityScoreType TargetAbilityScore)
-{
-	const TSubclassOf<UGameplayEffect> BoostEffect = this->AbilityBoostEffects[TargetAbilityScore];
 
-	// Allow boost GE to override the default weight group.
-	const FName WeightGroup =
-		PF2GameplayAbilityUtilities::GetWeightGroupOfGameplayEffect(
-			BoostEffect,
-			PF2CharacterConstants::GeWeightGroups::AbilityBoosts
-		);
+			if (Layer.PassiveGameplayEffects.IsSet())
+			{
+				this->SetPassiveGameplayEffects(Layer.PassiveGameplayEffects.GetValue());
+			}
+		}
 
-	UE_LOG(
-		LogPf2Core,
-		VeryVerbose,
-		TEXT("Applying a boost to ability ('%s') through ASC for character ('%s') via GE ('%s')."),
-		*(PF2EnumUtilities::ToString(TargetAbilityScore)),
-		*(this->GetOwnerActor()->GetName()),
-		*(BoostEffect->GetName())
-	);
+		// Base values are restored last, in case re-applying passive GEs touched any of them.
+		for (const TPair<FGameplayAttribute, float>& AttributeValue : Layer.AttributeBaseValues)
+		{
+			this->SetNumericAttributeBase(AttributeValue.Key, AttributeValue.Value);
+		}
 
-	this->AddPassiveGameplayEffectWithWeight(WeightGroup, BoostEffect);
+		return true;
+	}
 }
 
-TMultiMap<FName, TSubclassOf<UGameplayEffect>> UPF2AbilitySystemComponent::GetPassiveGameplayEffectsToApply()
+bool UPF2AbilitySystemComponent::ReleaseStateSnapshot(const FPF2StateSnapshotHandle Snapshot)
 {
-	if (this->CachedPassiveGameplayEffectsToApply.Num() == 0)
+	const int32 LayerIndex = this->FindStateSnapshotLayer(Snapshot);
+
+	if (LayerIndex == INDEX_NONE)
 	{
-		this->CachedPassiveGameplayEffectsToApply = this->BuildPassiveGameplayEffectsToApply();
+		return false;
 	}
+	else
+	{
+		const FPF2StateSnapshotLayer Layer = this->PopStateSnapshotLayers(LayerIndex);
 
-	return this->CachedPassiveGameplayEffectsToApply;
-}
+		// The next-older snapshot (if any) now has to be able to undo the changes that this snapshot covered.
+		if (this->StateSnapshotLayers.Num() != 0)
+		{
+			Layer.MergeInto(this->StateSnapshotLayers.Last());
+		}
+
+		return true;
+	}
+}
+
+void UPF2AbilitySystemComponent::RecordAttributeBaseValueForSnapshot(const FGameplayAttribute& Attribute,
+                                                                     const float               OldValue)
+{
+	FPF2StateSnapshotLayer* Layer = this->GetStateSnapshotLayerForChange();
+
+	if ((Layer != nullptr) && !Layer->AttributeBaseValues.Contains(Attribute))
+	{
+		Layer->AttributeBaseValues.Add(Attribute, OldValue);
+	}
+}
+
+void UPF2AbilitySystemComponent::ScheduleDerivedStatisticsUpdate()
+{
+	if (!FPF2DerivedStatistics::IsEnabled())
+	{
+		return;
+	}
+
+	if (this->IsOwnerActorAuthoritative())
+	{
+		this->bDerivedStatisticsReplicationDirty = true;
+	}
+
+	if (!this->DerivedStatisticsUpdateHandle.IsValid())
+	{
+		this->DerivedStatisticsUpdateHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+			this,
+			&UPF2AbilitySystemComponent::UpdateDerivedStatistics
+		);
+	}
+}
+
+void UPF2AbilitySystemComponent::ActivateAllPassiveGameplayEffectsInParallel(
+	const TArray<UPF2AbilitySystemComponent*>& AbilitySystemComponents)
+{
+	TArray<UPF2AbilitySystemComponent*>             Ascs;
+	TArray<TSharedRef<const FPF2PassiveEffectPlan>> Plans;
+	TArray<FPF2DerivedStatisticInputs>              StatisticInputs;
+	TArray<FPF2PrecalculatedDerivedStatistics>      Statistics;
+	TArray<int32>                                   WaveAscIndices;
+	int32                                           MaxNumSpans = 0;
+
+	check(IsInGameThread());
+
+	Ascs.Reserve(AbilitySystemComponents.Num());
+	Plans.Reserve(AbilitySystemComponents.Num());
+
+	for (UPF2AbilitySystemComponent* Asc : AbilitySystemComponents)
+	{
+		if (Asc == nullptr)
+		{
+			continue;
+		}
+
+		if (Asc->IsPassiveGameplayEffectBatchOpen())
+		{
+			// Activation is deferred until the batch ends, so there is nothing to precalculate.
+			Asc->ActivateAllPassiveGameplayEffects();
+			continue;
+		}
+
+		const TSharedRef<const FPF2PassiveEffectPlan> Plan = Asc->GetPassiveEffectPlan();
+
+		MaxNumSpans = FMath::Max(MaxNumSpans, Plan->GetWeightGroupSpans().Num());
+
+		Ascs.Add(Asc);
+		Plans.Add(Plan);
+	}
+
+	StatisticInputs.SetNum(Ascs.Num());
+	Statistics.SetNum(Ascs.Num());
+	WaveAscIndices.Reserve(Ascs.Num());
+
+	// Weight groups are activated in waves, so that the statistics for each weight group are calculated only after all
+	// of the weight groups before it have been applied to the same ASC.
+	for (int32 SpanIndex = 0; SpanIndex < MaxNumSpans; ++SpanIndex)
+	{
+		WaveAscIndices.Reset();
+
+		// Copy the inputs of each calculation on the game thread, so that the calculations do not touch any ASC.
+		for (int32 AscIndex = 0; AscIndex < Ascs.Num(); ++AscIndex)
+		{
+			UPF2AbilitySystemComponent*              Asc          = Ascs[AscIndex];
+			const TArray<FPF2PassiveEffectPlanSpan>& Spans        = Plans[AscIndex]->GetWeightGroupSpans();
+			const UPF2AttributeSet*                  AttributeSet = Asc->GetSet<UPF2AttributeSet>();
+
+			if ((SpanIndex >= Spans.Num()) || Asc->ActivatedWeightGroups.Contains(Spans[SpanIndex].WeightGroup))
+			{
+				continue;
+			}
+
+			if (AttributeSet == nullptr)
+			{
+				// Without the attribute set, there is nothing from which to calculate statistics.
+				StatisticInputs[AscIndex] = FPF2DerivedStatisticInputs();
+			}
+			else
+			{
+				StatisticInputs[AscIndex] = FPF2DerivedStatisticInputs(
+					*AttributeSet,
+					Asc->GetOwnedGameplayTags(),
+					Asc->GetCharacterLevel()
+				);
+			}
+
+			WaveAscIndices.Add(AscIndex);
+		}
+
+		ParallelFor(WaveAscIndices.Num(), [&StatisticInputs, &Statistics, &WaveAscIndices](const int32 WaveIndex)
+		{
+			const int32                       AscIndex = WaveAscIndices[WaveIndex];
+			const FPF2DerivedStatisticInputs& Inputs   = StatisticInputs[AscIndex];
+
+			if (Inputs.AbilityModifiers.Num() == 0)
+			{
+				Statistics[AscIndex].Reset();
+			}
+			else
+			{
+				FPF2DerivedStatistics::Calculate(Inputs, Statistics[AscIndex]);
+			}
+		});
+
+		for (const int32 AscIndex : WaveAscIndices)
+		{
+			UPF2AbilitySystemComponent*      Asc  = Ascs[AscIndex];
+			const FPF2PassiveEffectPlan&     Plan = *Plans[AscIndex];
+			const FPF2PassiveEffectPlanSpan& Span = Plan.GetWeightGroupSpans()[SpanIndex];
+
+			// Scopes have to nest strictly, so each ASC only has a scope open while its own GEs are being applied.
+			FPF2PassiveEffectStatsScope StatsScope(
+				Asc->PassiveEffectStats,
+				EPF2PassiveEffectTrigger::ActivatePassiveEffects
+			);
+
+			// MMCs of derived statistics use these values for as long as the tags of the ASC stay the same.
+			Asc->PrecalculatedDerivedStatistics = MoveTemp(Statistics[AscIndex]);
+
+			for (const FPF2PassiveEffectPlanEntry& Entry : Plan.GetEntriesInSpan(Span))
+			{
+				Asc->ActivatePassiveGameplayEffect(Entry);
+			}
+
+			Asc->ActivatedWeightGroups.Add(Span.WeightGroup, Span.WeightGroupOrdinal);
+			Asc->PrecalculatedDerivedStatistics.Reset();
+		}
+	}
+}
+
+TMap<EPF2PassiveEffectTrigger, FPF2PassiveEffectStats> UPF2AbilitySystemComponent::GetPassiveEffectStatsForWorld(
+	const UObject* WorldContextObject)
+{
+	const UWorld*                                          World =
+		GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	TMap<EPF2PassiveEffectTrigger, FPF2PassiveEffectStats> WorldStats;
+
+	if (World != nullptr)
+	{
+		for (const UPF2AbilitySystemComponent* Asc : TObjectRange<UPF2AbilitySystemComponent>())
+		{
+			if (Asc->GetWorld() == World)
+			{
+				for (const auto& TriggerStats : Asc->GetPassiveEffectStats())
+				{
+					WorldStats.FindOrAdd(TriggerStats.Key) += TriggerStats.Value;
+				}
+			}
+		}
+	}
+
+	return WorldStats;
+}
+
+void UPF2AbilitySystemComponent::DumpPassiveEffectStats(const UWorld* World, const int32 MaxAscs, FOutputDevice& Output)
+{
+	TArray<TPair<const UPF2AbilitySystemComponent*, FPF2PassiveEffectStats>> AscTotals;
+
+	const auto WriteStats = [&Output](const FString& Label, const FPF2PassiveEffectStats& Stats)
+	{
+		Output.Logf(
+			TEXT("  %-32s calls=%6d cycles=%6d removed=%7d applied=%7d updated=%7d mmcs=%8d time=%9.3fms"),
+			*Label,
+			Stats.NumCalls,
+			Stats.NumReapplyCycles,
+			Stats.NumEffectsRemoved,
+			Stats.NumEffectsApplied,
+			Stats.NumEffectsLevelUpdated,
+			Stats.NumMagnitudeEvaluations,
+			Stats.WallTimeSeconds * 1000.0
+		);
+	};
+
+	Output.Logf(TEXT("Passive GE stats for world ('%s'), by trigger:"), *World->GetName());
+
+	for (const auto& TriggerStats : GetPassiveEffectStatsForWorld(World))
+	{
+		WriteStats(PF2EnumUtilities::ToString(TriggerStats.Key), TriggerStats.Value);
+	}
+
+	for (const UPF2AbilitySystemComponent* Asc : TObjectRange<UPF2AbilitySystemComponent>())
+	{
+		if (Asc->GetWorld() == World)
+		{
+			FPF2PassiveEffectStats AscTotal;
+
+			for (const auto& TriggerStats : Asc->GetPassiveEffectStats())
+			{
+				AscTotal += TriggerStats.Value;
+			}
+
+			AscTotals.Emplace(Asc, AscTotal);
+		}
+	}
+
+	AscTotals.Sort([](const auto& A, const auto& B)
+	{
+		return A.Value.WallTimeSeconds > B.Value.WallTimeSeconds;
+	});
+
+	Output.Logf(TEXT("Top %d of %d ASC(s) by passive GE time:"), FMath::Min(MaxAscs, AscTotals.Num()), AscTotals.Num());
+
+	for (int32 AscIndex = 0; AscIndex < FMath::Min(MaxAscs, AscTotals.Num()); ++AscIndex)
+	{
+		const UPF2AbilitySystemComponent* Asc      = AscTotals[AscIndex].Key;
+		const AActor*                     Owner    = Asc->GetOwner();
+		const FString                     AscLabel = (Owner == nullptr) ? Asc->GetName() : Owner->GetName();
+
+		WriteStats(AscLabel, AscTotals[AscIndex].Value);
+
+		for (const auto& TriggerStats : Asc->GetPassiveEffectStats())
+		{
+			WriteStats(TEXT("  ") + PF2EnumUtilities::ToString(TriggerStats.Key), TriggerStats.Value);
+		}
+	}
+}
+
+FGameplayAbilitySpec* UPF2AbilitySystemComponent::FindAbilitySpecByClass(
+	const TSubclassOf<UGameplayAbility> AbilityClass) const
+{
+	const auto* ClassSpecs = this->AbilitySpecsByClass.Find(AbilityClass);
+
+	if (ClassSpecs != nullptr)
+	{
+		for (const FGameplayAbilitySpecHandle& Handle : *ClassSpecs)
+		{
+			FGameplayAbilitySpec* Spec = this->FindIndexedAbilitySpec(Handle);
+
+			if (Spec != nullptr)
+			{
+				return Spec;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+TArray<FGameplayAbilitySpec*> UPF2AbilitySystemComponent::FindAbilitySpecsByTags(
+	const FGameplayTagContainer& Tags) const
+{
+	TArray<FGameplayAbilitySpec*>             MatchingSpecs;
+	const TArray<FGameplayAbilitySpecHandle>* Candidates = nullptr;
+
+	if (Tags.IsEmpty())
+	{
+		// Every ability matches an empty set of tags.
+		for (const FGameplayAbilitySpec& Spec : this->ActivatableAbilities.Items)
+		{
+			MatchingSpecs.Add(const_cast<FGameplayAbilitySpec*>(&Spec));
+		}
+
+		return MatchingSpecs;
+	}
+
+	// Only the abilities indexed under the least common of the tags need to be checked against the other tags.
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const TArray<FGameplayAbilitySpecHandle>* TagSpecs = this->AbilitySpecsByTag.Find(Tag);
+
+		if (TagSpecs == nullptr)
+		{
+			// No ability has this tag, so no ability can have all of the tags.
+			return MatchingSpecs;
+		}
+
+		if ((Candidates == nullptr) || (TagSpecs->Num() < Candidates->Num()))
+		{
+			Candidates = TagSpecs;
+		}
+	}
+
+	for (const FGameplayAbilitySpecHandle& Handle : *Candidates)
+	{
+		FGameplayAbilitySpec* Spec = this->FindIndexedAbilitySpec(Handle);
+
+		if ((Spec != nullptr) && (Spec->Ability != nullptr) && Spec->Ability->AbilityTags.HasAll(Tags))
+		{
+			MatchingSpecs.Add(Spec);
+		}
+	}
+
+	return MatchingSpecs;
+}
+
+TArray<FGameplayAbilitySpecHandle> UPF2AbilitySystemComponent::GiveAbilities(
+	const TArray<FGameplayAbilitySpec>& Specs)
+{
+	TArray<FGameplayAbilitySpecHandle> Handles;
+
+	if (!this->IsOwnerActorAuthoritative())
+	{
+		// Same as GiveAbility(), abilities can only be granted by the server.
+		UE_LOG(
+			LogPf2CoreAbilities,
+			Warning,
+			TEXT("GiveAbilities() called with %d abilities on a client for character ('%s'), which is not allowed."),
+			Specs.Num(),
+			*(this->GetOwnerActor()->GetName())
+		);
+
+		return Handles;
+	}
+
+	Handles.Reserve(Specs.Num());
+
+	// Grow the list of abilities once for all of the specs, instead of once for each spec.
+	this->ActivatableAbilities.Items.Reserve(this->ActivatableAbilities.Items.Num() + Specs.Num());
+
+	{
+		// Each spec goes through GiveAbility(), so that it is validated, instanced, replicated, and announced exactly
+		// like any other ability. While the list is locked, GiveAbility() only queues each spec; all of the queued specs
+		// are then granted in order when the lock is released.
+		ABILITYLIST_SCOPE_LOCK();
+
+		for (const FGameplayAbilitySpec& Spec : Specs)
+		{
+			// Invalid specs are logged and skipped by GiveAbility(), which returns an invalid handle for them.
+			Handles.Add(this->GiveAbility(Spec));
+		}
+	}
+
+	UE_LOG(
+		LogPf2CoreAbilities,
+		VeryVerbose,
+		TEXT("Granted %d abilities in bulk to ASC on character ('%s')."),
+		Specs.Num(),
+		*(this->GetOwnerActor()->GetName())
+	);
+
+	return Handles;
+}
+
+FGameplayTagContainer UPF2AbilitySystemComponent::GetActiveGameplayTags() const
+{
+	FGameplayTagContainer Tags;
+
+	Tags.Reset();
+
+	this->GetOwnedGameplayTags(Tags);
+
+	return Tags;
+}
+
+FORCEINLINE int32 UPF2AbilitySystemComponent::GetCharacterLevel() const
+{
+	IPF2CharacterInterface* OwningCharacter = Cast<IPF2CharacterInterface>(this->GetOwnerActor());
+
+	if (OwningCharacter == nullptr)
+	{
+		return 1;
+	}
+	else
+	{
+		return OwningCharacter->GetCharacterLevel();
+	}
+}
+
+TMap<EPF2CharacterAbilityScoreType, FPF2AttributeModifierSnapshot> UPF2AbilitySystemComponent::GetAbilityScoreValues() const
+{
+	const UPF2AttributeSet* AttributeSet =
+		Cast<UPF2AttributeSet>(this->GetAttributeSubobject(UPF2AttributeSet::StaticClass()));
+
+	const TMap<EPF2CharacterAbilityScoreType, FPF2AttributeModifierSnapshot> Values =
+		{
+			{
+				EPF2CharacterAbilityScoreType::AbStrength,
+				FPF2AttributeModifierSnapshot(
+					AttributeSet->AbStrength.GetCurrentValue(),
+					AttributeSet->AbStrengthModifier.GetCurrentValue()
+				)
+			},
+			{
+				EPF2CharacterAbilityScoreType::AbDexterity,
+				FPF2AttributeModifierSnapshot(
+					AttributeSet->AbDexterity.GetCurrentValue(),
+					AttributeSet->AbDexterityModifier.GetCurrentValue()
+				)
+			},
+			{
+				EPF2CharacterAbilityScoreType::AbConstitution,
+				FPF2AttributeModifierSnapshot(
+					AttributeSet->AbConstitution.GetCurrentValue(),
+					AttributeSet->AbConstitutionModifier.GetCurrentValue()
+				)
+			},
+			{
+				EPF2CharacterAbilityScoreType::AbIntelligence,
+				FPF2AttributeModifierSnapshot(
+					AttributeSet->AbIntelligence.GetCurrentValue(),
+					AttributeSet->AbIntelligenceModifier.GetCurrentValue()
+				)
+			},
+			{
+				EPF2CharacterAbilityScoreType::AbWisdom,
+				FPF2AttributeModifierSnapshot(
+					AttributeSet->AbWisdom.GetCurrentValue(),
+					AttributeSet->AbWisdomModifier.GetCurrentValue()
+				)
+			},
+			{
+				EPF2CharacterAbilityScoreType::AbCharisma,
+				FPF2AttributeModifierSnapshot(
+					AttributeSet->AbCharisma.GetCurrentValue(),
+					AttributeSet->AbCharismaModifier.GetCurrentValue()
+				)
+			},
+		};
+
+	return Values;
+}
+
+TArray<UPF2AbilityBoostBase*> UPF2AbilitySystemComponent::GetPendingAbilityBoosts() const
+{
+	TArray<UPF2AbilityBoostBase*> MatchingGameplayAbilities;
+	TArray<FGameplayAbilitySpec*> MatchingGameplayAbilitySpecs;
+
+	MatchingGameplayAbilitySpecs =
+		this->FindAbilitySpecsByTags(
+			FGameplayTagContainer(PF2GameplayAbilityUtilities::GetTag(FName("GameplayAbility.Type.AbilityBoost")))
+		);
+
+	MatchingGameplayAbilities =
+		PF2ArrayUtilities::Map<UPF2AbilityBoostBase*>(
+			MatchingGameplayAbilitySpecs,
+			[](const FGameplayAbilitySpec* AbilitySpec)
+			{
+				return Cast<UPF2AbilityBoostBase>(AbilitySpec->Ability);
+			}
+		);
+
+	return MatchingGameplayAbilities;
+}
+
+void UPF2AbilitySystemComponent::ApplyAbilityBoost(const EPF2CharacterAbilityScoreType TargetAbilityScore)
+{
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::AbilityBoost);
+
+	const TSubclassOf<UGameplayEffect> BoostEffect = this->AbilityBoostEffects[TargetAbilityScore];
+
+	// Allow boost GE to override the default weight group.
+	const FName WeightGroup =
+		PF2GameplayAbilityUtilities::GetWeightGroupOfGameplayEffect(
+			BoostEffect,
+			PF2CharacterConstants::GeWeightGroups::AbilityBoosts
+		);
+
+	UE_LOG(
+		LogPf2Core,
+		VeryVerbose,
+		TEXT("Applying a boost to ability ('%s') through ASC for character ('%s') via GE ('%s')."),
+		*(PF2EnumUtilities::ToString(TargetAbilityScore)),
+		*(this->GetOwnerActor()->GetName()),
+		*(BoostEffect->GetName())
+	);
+
+	this->AddPassiveGameplayEffectWithWeight(WeightGroup, BoostEffect);
+}
+
+void UPF2AbilitySystemComponent::UpdatePassiveGameplayEffectsForLevelChange()
+{
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::LevelChange);
+
+	if (!this->ArePassiveGameplayEffectsActive())
+	{
+		// Nothing to update; the new level will be used when passive GEs are next activated.
+		return;
+	}
+
+	if (this->IsPassiveGameplayEffectBatchOpen())
+	{
+		this->bPassiveEffectBatchLevelChanged = true;
+		return;
+	}
+
+	const int32                                   CharacterLevel   = this->GetCharacterLevel();
+	const TSharedRef<const FPF2PassiveEffectPlan> Plan             = this->GetPassiveEffectPlan();
+	const FPF2PassiveEffectDependencyGraph&       Graph            = Plan->GetDependencyGraph();
+	const TSet<TSubclassOf<UGameplayEffect>>      EffectsToReapply = Graph.GetEffectsToReapplyOnLevelChange();
+	int32                                         NumUpdated       = 0;
+
+	for (const auto& GroupEffects : this->ActivePassiveEffects)
+	{
+		for (const FPF2ActivePassiveEffect& ActiveEffect : GroupEffects.Value)
+		{
+			const bool bReadsLevel =
+				ActiveEffect.Effects.ContainsByPredicate([&Graph](const TSubclassOf<UGameplayEffect>& Effect)
+				{
+					return Graph.DoesEffectReadLevel(Effect);
+				});
+
+			// GEs that must be re-applied are skipped here, including composite GEs that combine any of them.
+			if (bReadsLevel && !ActiveEffect.ContainsAnyEffect(EffectsToReapply))
+			{
+				this->SetActiveGameplayEffectLevel(ActiveEffect.Handle, CharacterLevel);
+				this->PassiveEffectStats.RecordEffectLevelUpdated();
+
+				++NumUpdated;
+			}
+		}
+	}
+
+	UE_LOG(
+		LogPf2Core,
+		VeryVerbose,
+		TEXT("Updated %d passive GE(s) in place; re-applying %d passive GE(s) for level (%d) of character ('%s')."),
+		NumUpdated,
+		EffectsToReapply.Num(),
+		CharacterLevel,
+		*(this->GetOwnerActor()->GetName())
+	);
+
+	if (EffectsToReapply.Num() != 0)
+	{
+		this->ReapplyPassiveGameplayEffects(EffectsToReapply);
+	}
+}
+
+void UPF2AbilitySystemComponent::OnRep_DynamicTags(const FGameplayTagContainer& OldDynamicTags)
+{
+	// Loose tags are not replicated, so each client grants its own copy of the dynamic tags that changed.
+	this->UpdateLooseDynamicTags(GetChangedTags(OldDynamicTags, this->DynamicTags));
+}
+
+void UPF2AbilitySystemComponent::OnTagUpdated(const FGameplayTag& Tag, const bool TagExists)
+{
+	Super::OnTagUpdated(Tag, TagExists);
+
+	// Derived statistics are precalculated from the tags the ASC had at the time, so they no longer apply.
+	this->PrecalculatedDerivedStatistics.Reset();
+
+	// Tags can arrive on a client before or after the attribute set and character they are derived with. On the server,
+	// they change what is sent to clients.
+	this->ScheduleDerivedStatisticsUpdate();
+}
+
+TSharedRef<const FPF2PassiveEffectPlan> UPF2AbilitySystemComponent::GetPassiveEffectPlan()
+{
+	if (!this->CachedPassiveEffectPlan.IsValid())
+	{
+		this->CachedPassiveEffectPlan = this->BuildPassiveEffectPlan();
+	}
+
+	return this->CachedPassiveEffectPlan.ToSharedRef();
+}
+
+TSharedRef<const FPF2PassiveEffectPlan> UPF2AbilitySystemComponent::BuildPassiveEffectPlan() const
+{
+	TSet<TSubclassOf<UGameplayEffect>>    StackableEffects;
+	UPF2CompositeGameplayEffectSubsystem* CompositeEffects = nullptr;
+
+	for (const auto& BoostEffect : this->AbilityBoostEffects)
+	{
+		StackableEffects.Add(BoostEffect.Value);
+	}
+
+	if (this->ShouldCombinePassiveGameplayEffects())
+	{
+		// Worlds that are not part of a game instance (e.g., editor previews) have nowhere to keep composite GEs, so
+		// their passive GEs are simply not combined.
+		CompositeEffects = UPF2CompositeGameplayEffectSubsystem::Get(this->GetWorld());
+	}
+
+	// The plan takes care of ensuring that passive GEs are always evaluated in weight order.
+	return MakeShared<FPF2PassiveEffectPlan>(this->PassiveGameplayEffects, StackableEffects, CompositeEffects);
+}
+
+void UPF2AbilitySystemComponent::ClearPassiveGameplayEffectsCache()
+{
+	this->CachedPassiveEffectPlan.Reset();
+}
+
+void UPF2AbilitySystemComponent::ReapplyPassiveGameplayEffectsAffectedByTags(const FGameplayTagContainer& ChangedTags)
+{
+	const TSharedRef<const FPF2PassiveEffectPlan> Plan = this->GetPassiveEffectPlan();
+	TSet<TSubclassOf<UGameplayEffect>>            AffectedEffects;
+
+	AffectedEffects = Plan->GetDependencyGraph().GetEffectsAffectedByTags(ChangedTags);
+
+	if (AffectedEffects.Num() == 0)
+	{
+		// None of the passive GEs read the tags that changed.
+		return;
+	}
+
+	UE_LOG(
+		LogPf2Core,
+		VeryVerbose,
+		TEXT("Re-applying %d of %d passive GE(s) affected by change to dynamic tags ('%s') on character ('%s')."),
+		AffectedEffects.Num(),
+		Plan->GetEntries().Num(),
+		*(ChangedTags.ToString()),
+		*(this->GetOwnerActor()->GetName())
+	);
+
+	this->ReapplyPassiveGameplayEffects(AffectedEffects);
+}
+
+void UPF2AbilitySystemComponent::ReapplyPassiveGameplayEffects(const TSet<TSubclassOf<UGameplayEffect>>& Effects)
+{
+	const TSharedRef<const FPF2PassiveEffectPlan> Plan = this->GetPassiveEffectPlan();
+	TArray<FActiveGameplayEffectHandle>           HandlesToRemove;
+
+	for (auto& GroupEffects : this->ActivePassiveEffects)
+	{
+		TArray<FPF2ActivePassiveEffect>& ActiveEffects = GroupEffects.Value;
+
+		for (int32 EffectIndex = ActiveEffects.Num() - 1; EffectIndex >= 0; --EffectIndex)
+		{
+			// A composite GE is removed if any of the GEs it combines is affected.
+			if (ActiveEffects[EffectIndex].ContainsAnyEffect(Effects))
+			{
+				HandlesToRemove.Add(ActiveEffects[EffectIndex].Handle);
+				ActiveEffects.RemoveAtSwap(EffectIndex, 1, false);
+			}
+		}
+	}
+
+	for (const FActiveGameplayEffectHandle& Handle : HandlesToRemove)
+	{
+		this->RemovePassiveGameplayEffect(Handle);
+	}
+
+	// Re-apply the affected GEs in weight order, but only in groups that are active.
+	for (const FPF2PassiveEffectPlanSpan& Span : Plan->GetWeightGroupSpans())
+	{
+		if (this->ActivatedWeightGroups.Contains(Span.WeightGroup))
+		{
+			for (const FPF2PassiveEffectPlanEntry& Entry : Plan->GetEntriesInSpan(Span))
+			{
+				if (Entry.ContainsAnyEffect(Effects))
+				{
+					this->ActivatePassiveGameplayEffect(Entry);
+				}
+			}
+		}
+	}
+}
+
+void UPF2AbilitySystemComponent::DiffPassiveGameplayEffects(
+	const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& OldEffects,
+	const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& NewEffects,
+	TMultiMap<FName, TSubclassOf<UGameplayEffect>>&       RemovedEffects,
+	TMultiMap<FName, TSubclassOf<UGameplayEffect>>&       AddedEffects)
+{
+	// Positive counts are GEs that were added; negative counts are GEs that were removed.
+	TMap<FPassiveEffectKey, int32> EffectCounts;
+
+	for (const auto& EffectInfo : NewEffects)
+	{
+		++EffectCounts.FindOrAdd(FPassiveEffectKey(EffectInfo.Key, EffectInfo.Value));
+	}
+
+	for (const auto& EffectInfo : OldEffects)
+	{
+		--EffectCounts.FindOrAdd(FPassiveEffectKey(EffectInfo.Key, EffectInfo.Value));
+	}
+
+	for (const auto& EffectCount : EffectCounts)
+	{
+		const FName                        WeightGroup = EffectCount.Key.Key;
+		const TSubclassOf<UGameplayEffect> Effect      = EffectCount.Key.Value;
+
+		for (int32 Count = EffectCount.Value; Count > 0; --Count)
+		{
+			AddedEffects.Add(WeightGroup, Effect);
+		}
+
+		for (int32 Count = EffectCount.Value; Count < 0; ++Count)
+		{
+			RemovedEffects.Add(WeightGroup, Effect);
+		}
+	}
+}
+
+void UPF2AbilitySystemComponent::ApplyPassiveGameplayEffectChanges(
+	const FPF2PassiveEffectPlan&                          OldPlan,
+	const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& RemovedEffects,
+	const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& AddedEffects)
+{
+	const TSharedRef<const FPF2PassiveEffectPlan> NewPlan              = this->GetPassiveEffectPlan();
+	TSet<FPassiveEffectKey>                       ChangedEffects;
+	TSet<TSubclassOf<UGameplayEffect>>            RemovedClasses,
+	                                              AddedClasses,
+	                                              DependentEffects,
+	                                              EffectsToReapply;
+	FName                                         LowestChangedGroup;
+	int32                                         LowestChangedOrdinal = MAX_int32;
+
+	auto TrackLowestChangedGroup = [this, &LowestChangedGroup, &LowestChangedOrdinal](const FName WeightGroup)
+	{
+		const int32 Ordinal = this->GetWeightGroupOrdinal(WeightGroup);
+
+		const bool  bIsLowest = LowestChangedGroup.IsNone() ||
+			PF2GameplayAbilityUtilities::IsWeightGroupBefore(
+				WeightGroup,
+				Ordinal,
+				LowestChangedGroup,
+				LowestChangedOrdinal
+			);
+
+		if (bIsLowest)
+		{
+			LowestChangedGroup   = WeightGroup;
+			LowestChangedOrdinal = Ordinal;
+		}
+	};
+
+	for (const auto& EffectInfo : RemovedEffects)
+	{
+		const FName WeightGroup = EffectInfo.Key;
+
+		ChangedEffects.Add(FPassiveEffectKey(WeightGroup, EffectInfo.Value));
+		RemovedClasses.Add(EffectInfo.Value);
+
+		TrackLowestChangedGroup(WeightGroup);
+	}
+
+	for (const auto& EffectInfo : AddedEffects)
+	{
+		const FName WeightGroup = EffectInfo.Key;
+
+		ChangedEffects.Add(FPassiveEffectKey(WeightGroup, EffectInfo.Value));
+		AddedClasses.Add(EffectInfo.Value);
+
+		TrackLowestChangedGroup(WeightGroup);
+
+		// Same special case as AddPassiveGameplayEffectWithWeight(): a brand-new weight group is activated along with
+		// the other weight groups.
+		if (OldPlan.GetEntriesInWeightGroup(WeightGroup).Num() == 0)
+		{
+			this->ActivatedWeightGroups.Add(
+				WeightGroup,
+				PF2GameplayAbilityUtilities::GetWeightGroupOrdinal(WeightGroup)
+			);
+		}
+	}
+
+	// Replace every instance of a changed GE in its weight group rather than removing or adding one instance at a time,
+	// since the entry for a stackable GE covers all of its additions to the weight group with a single active GE.
+	this->ReplacePassiveGameplayEffects(*NewPlan, ChangedEffects);
+
+	// GEs that depended on a removed GE are only known to the old graph, while GEs that depend on an added GE are only
+	// known to the new graph.
+	DependentEffects = OldPlan.GetDependencyGraph().GetEffectsDependentOn(RemovedClasses);
+	DependentEffects.Append(NewPlan->GetDependencyGraph().GetEffectsDependentOn(AddedClasses));
+
+	for (const FPF2PassiveEffectPlanEntry& Entry : NewPlan->GetEntries())
+	{
+		const bool bIsAfterChange = !LowestChangedGroup.IsNone() &&
+			PF2GameplayAbilityUtilities::IsWeightGroupBefore(
+				LowestChangedGroup,
+				LowestChangedOrdinal,
+				Entry.WeightGroup,
+				Entry.WeightGroupOrdinal
+			);
+
+		if (bIsAfterChange)
+		{
+			for (const TSubclassOf<UGameplayEffect>& Effect : Entry.Effects)
+			{
+				if (DependentEffects.Contains(Effect) && !AddedClasses.Contains(Effect))
+				{
+					EffectsToReapply.Add(Effect);
+				}
+			}
+		}
+	}
+
+	UE_LOG(
+		LogPf2Core,
+		VeryVerbose,
+		TEXT("Removed %d, added %d, and re-applying %d dependent passive GE(s) on character ('%s')."),
+		RemovedEffects.Num(),
+		AddedEffects.Num(),
+		EffectsToReapply.Num(),
+		*(this->GetOwnerActor()->GetName())
+	);
+
+	if (EffectsToReapply.Num() != 0)
+	{
+		this->ReapplyPassiveGameplayEffects(EffectsToReapply);
+	}
+}
+
+FGameplayTagContainer UPF2AbilitySystemComponent::GetChangedTags(
+	const FGameplayTagContainer& OldTags,
+	const FGameplayTagContainer& NewTags)
+{
+	FGameplayTagContainer ChangedTags;
+
+	for (const FGameplayTag& OldTag : OldTags)
+	{
+		if (!NewTags.HasTagExact(OldTag))
+		{
+			ChangedTags.AddTag(OldTag);
+		}
+	}
+
+	for (const FGameplayTag& NewTag : NewTags)
+	{
+		if (!OldTags.HasTagExact(NewTag))
+		{
+			ChangedTags.AddTag(NewTag);
+		}
+	}
+
+	return ChangedTags;
+}
+
+void UPF2AbilitySystemComponent::UpdateLooseDynamicTags(const FGameplayTagContainer& ChangedTags)
+{
+	for (const FGameplayTag& Tag : ChangedTags)
+	{
+		if (this->DynamicTags.HasTagExact(Tag))
+		{
+			this->AddLooseGameplayTag(Tag);
+		}
+		else
+		{
+			this->RemoveLooseGameplayTag(Tag);
+		}
+	}
+}
+
+bool UPF2AbilitySystemComponent::ShouldCombinePassiveGameplayEffects() const
+{
+	const UWorld* World = this->GetWorld();
+
+	if (!this->bCombinePassiveGameplayEffects)
+	{
+		return false;
+	}
+	else
+	{
+		// Composite GEs only exist on the machine that created them, so they must never be replicated.
+		return !this->GetIsReplicated() ||
+			(this->ReplicationMode == EGameplayEffectReplicationMode::Minimal) ||
+			((World != nullptr) && (World->GetNetMode() == NM_Standalone));
+	}
+}
+
+void UPF2AbilitySystemComponent::ReconcilePassiveGameplayEffectBatch()
+{
+	const FGameplayTagContainer ChangedTags =
+		GetChangedTags(this->PassiveEffectBatchInitialDynamicTags, this->DynamicTags);
+
+	const bool        bActivationRequested = this->bPassiveEffectBatchActivationRequested,
+	                  bLevelChanged        = this->bPassiveEffectBatchLevelChanged;
+	const TSet<FName> DirtyWeightGroups    = this->PassiveEffectBatchDirtyWeightGroups;
+
+	// Reset batch state before re-applying anything, in case re-application starts a new batch.
+	this->PassiveEffectBatchInitialDynamicTags.Reset();
+	this->PassiveEffectBatchDirtyWeightGroups.Empty();
+
+	this->bPassiveEffectBatchActivationRequested = false;
+	this->bPassiveEffectBatchLevelChanged        = false;
+
+	UE_LOG(
+		LogPf2Core,
+		VeryVerbose,
+		TEXT("Ending passive GE batch on character ('%s') (tags: '%s', groups: %d, level: %d, activate: %d)."),
+		*(this->GetOwnerActor()->GetName()),
+		*(ChangedTags.ToString()),
+		DirtyWeightGroups.Num(),
+		bLevelChanged,
+		bActivationRequested
+	);
+
+	if (this->ArePassiveGameplayEffectsActive())
+	{
+		if (!ChangedTags.IsEmpty())
+		{
+			this->ReapplyPassiveGameplayEffectsAffectedByTags(ChangedTags);
+		}
+
+		if (DirtyWeightGroups.Num() != 0)
+		{
+			this->ReapplyPassiveGameplayEffectsFromWeightGroups(DirtyWeightGroups);
+		}
+
+		if (bLevelChanged)
+		{
+			this->UpdatePassiveGameplayEffectsForLevelChange();
+		}
+	}
+
+	if (bActivationRequested)
+	{
+		// Activates only the weight groups that are not yet active.
+		this->ActivateAllPassiveGameplayEffects();
+	}
+}
+
+void UPF2AbilitySystemComponent::ReapplyPassiveGameplayEffectsFromWeightGroups(const TSet<FName>& WeightGroups)
+{
+	const TSharedRef<const FPF2PassiveEffectPlan> Plan               = this->GetPassiveEffectPlan();
+	FName                                         LowestDirtyGroup;
+	int32                                         LowestDirtyOrdinal = MAX_int32;
+	TArray<FName>                                 GroupsToReactivate;
+
+	for (const FName& WeightGroup : WeightGroups)
+	{
+		const int32 Ordinal   = this->GetWeightGroupOrdinal(WeightGroup);
+		const bool  bIsLowest = LowestDirtyGroup.IsNone() ||
+			PF2GameplayAbilityUtilities::IsWeightGroupBefore(WeightGroup, Ordinal, LowestDirtyGroup, LowestDirtyOrdinal);
+
+		if (bIsLowest)
+		{
+			LowestDirtyGroup   = WeightGroup;
+			LowestDirtyOrdinal = Ordinal;
+		}
+	}
+
+	for (const FPF2PassiveEffectPlanSpan& Span : Plan->GetWeightGroupSpans())
+	{
+		// Re-apply the lowest dirty weight group itself and every weight group after it.
+		const bool bIsDirty = !LowestDirtyGroup.IsNone() &&
+			!PF2GameplayAbilityUtilities::IsWeightGroupBefore(
+				Span.WeightGroup,
+				Span.WeightGroupOrdinal,
+				LowestDirtyGroup,
+				LowestDirtyOrdinal
+			);
+
+		if (bIsDirty && this->ActivatedWeightGroups.Contains(Span.WeightGroup))
+		{
+			this->DeactivatePassiveGameplayEffects(Span.WeightGroup);
+
+			GroupsToReactivate.Add(Span.WeightGroup);
+		}
+	}
+
+	for (const FName& WeightGroup : GroupsToReactivate)
+	{
+		this->ActivatePassiveGameplayEffects(WeightGroup);
+	}
+}
+
+int32 UPF2AbilitySystemComponent::GetWeightGroupOrdinal(const FName WeightGroup) const
+{
+	const int32* ActivatedOrdinal = this->ActivatedWeightGroups.Find(WeightGroup);
 
-TMultiMap<FName, TSubclassOf<UGameplayEffect>> UPF2AbilitySystemComponent::BuildPassiveGameplayEffectsToApply() const
+	if (ActivatedOrdinal != nullptr)
+	{
+		return *ActivatedOrdinal;
+	}
+	else
+	{
+		return PF2GameplayAbilityUtilities::GetWeightGroupOrdinal(WeightGroup);
+	}
+}
+
+void UPF2AbilitySystemComponent::ReplacePassiveGameplayEffects(
+	const FPF2PassiveEffectPlan&   Plan,
+	const TSet<FPassiveEffectKey>& Effects)
 {
-	TMultiMap<FName, TSubclassOf<UGameplayEffect>> EffectsToApply = this->PassiveGameplayEffects;
+	TSet<FPassiveEffectKey>             EffectsToReplace = Effects;
+	TArray<FActiveGameplayEffectHandle> HandlesToRemove;
+	int32                               NumEffectsToReplace;
+
+	const auto ContainsAnyKey = [&EffectsToReplace](const FName WeightGroup, const auto& GroupEffects)
+	{
+		for (const TSubclassOf<UGameplayEffect>& Effect : GroupEffects)
+		{
+			if (EffectsToReplace.Contains(FPassiveEffectKey(WeightGroup, Effect)))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	const auto AddKeys = [&EffectsToReplace](const FName WeightGroup, const auto& GroupEffects)
+	{
+		for (const TSubclassOf<UGameplayEffect>& Effect : GroupEffects)
+		{
+			EffectsToReplace.Add(FPassiveEffectKey(WeightGroup, Effect));
+		}
+	};
+
+	// A composite GE has to be replaced as a whole if any GE it combines is replaced, and GEs may be combined
+	// differently in the plan than they were when they were applied. So, keep growing the set of GEs to replace until
+	// it covers every active GE and every entry of the plan that applies any of them.
+	do
+	{
+		NumEffectsToReplace = EffectsToReplace.Num();
+
+		for (const auto& GroupEffects : this->ActivePassiveEffects)
+		{
+			for (const FPF2ActivePassiveEffect& ActiveEffect : GroupEffects.Value)
+			{
+				if (ContainsAnyKey(GroupEffects.Key, ActiveEffect.Effects))
+				{
+					AddKeys(GroupEffects.Key, ActiveEffect.Effects);
+				}
+			}
+		}
+
+		for (const FPF2PassiveEffectPlanEntry& Entry : Plan.GetEntries())
+		{
+			if (ContainsAnyKey(Entry.WeightGroup, Entry.Effects))
+			{
+				AddKeys(Entry.WeightGroup, Entry.Effects);
+			}
+		}
+	}
+	while (EffectsToReplace.Num() != NumEffectsToReplace);
 
-	// Add a pseudo-GE for the dynamic tags.
-	EffectsToApply.Add(PF2CharacterConstants::GeWeightGroups::InitializeBaseStats, this->DynamicTagsEffect);
+	for (auto& GroupEffects : this->ActivePassiveEffects)
+	{
+		TArray<FPF2ActivePassiveEffect>& ActiveEffects = GroupEffects.Value;
+
+		for (int32 EffectIndex = ActiveEffects.Num() - 1; EffectIndex >= 0; --EffectIndex)
+		{
+			if (ContainsAnyKey(GroupEffects.Key, ActiveEffects[EffectIndex].Effects))
+			{
+				HandlesToRemove.Add(ActiveEffects[EffectIndex].Handle);
+				ActiveEffects.RemoveAtSwap(EffectIndex, 1, false);
+			}
+		}
+	}
+
+	for (const FActiveGameplayEffectHandle& Handle : HandlesToRemove)
+	{
+		this->RemovePassiveGameplayEffect(Handle);
+	}
 
-	// Ensure Passive GEs are always evaluated in weight order.
-	EffectsToApply.KeyStableSort(FNameLexicalLess());
+	// Apply the replacement GEs in weight order, but only in groups that are active.
+	for (const FPF2PassiveEffectPlanSpan& Span : Plan.GetWeightGroupSpans())
+	{
+		if (this->ActivatedWeightGroups.Contains(Span.WeightGroup))
+		{
+			for (const FPF2PassiveEffectPlanEntry& Entry : Plan.GetEntriesInSpan(Span))
+			{
+				if (ContainsAnyKey(Entry.WeightGroup, Entry.Effects))
+				{
+					this->ActivatePassiveGameplayEffect(Entry);
+				}
+			}
+		}
+	}
+}
 
-	return EffectsToApply;
+void UPF2AbilitySystemComponent::ActivatePassiveGameplayEffect(const FPF2PassiveEffectPlanEntry& Entry)
+{
+	this->ActivatePassiveGameplayEffect(Entry, this->GetPassiveGameplayEffectSpec(Entry));
 }
 
 void UPF2AbilitySystemComponent::ActivatePassiveGameplayEffect(
-	const FName                        WeightGroup,
-	const TSubclassOf<UGameplayEffect> GameplayEffect)
+	const FPF2PassiveEffectPlanEntry& Entry,
+	const FGameplayEffectSpecHandle&  SpecHandle)
 {
-	FGameplayEffectContextHandle EffectContext = this->MakeEffectContext();
-	FGameplayEffectSpecHandle    NewHandle;
-	FGameplayEffectSpec*         GameplayEffectSpec;
+	if (SpecHandle.IsValid())
+	{
+		FActiveGameplayEffectHandle ActiveHandle;
 
-	EffectContext.AddSourceObject(this);
+		// Cached specs are shared between activations, so the stack count has to be set every time. GAS scales the
+		// magnitude of each modifier by the stack count of the spec.
+		SpecHandle.Data->SetStackCount(Entry.Count);
 
-	NewHandle = this->MakeOutgoingSpec(
-		GameplayEffect,
-		this->GetCharacterLevel(),
-		EffectContext
-	);
+		ActiveHandle = this->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), this);
+
+		this->PassiveEffectStats.RecordEffectApplied();
+
+		// Instant GEs do not leave an active GE behind, so there is nothing to track for them.
+		if (ActiveHandle.IsValid())
+		{
+			this->ActivePassiveEffects.FindOrAdd(Entry.WeightGroup).Add({Entry.Effects, ActiveHandle});
+		}
+	}
+}
+
+bool UPF2AbilitySystemComponent::RemovePassiveGameplayEffect(const FActiveGameplayEffectHandle Handle)
+{
+	const bool bWasRemoved = this->RemoveActiveGameplayEffect(Handle);
+
+	if (bWasRemoved)
+	{
+		this->PassiveEffectStats.RecordEffectRemoved();
+	}
 
-	GameplayEffectSpec = NewHandle.Data.Get();
+	return bWasRemoved;
+}
 
-	// Ensure that the GE spec is tagged with its weight no matter how the weight was set (either through API or through
-	// a tag in the InheritableGameplayEffectTags field on the GE definition class itself). Without this, only the tag
-	// from the GE definition spec would pass through.
-	GameplayEffectSpec->DynamicAssetTags.AddTag(PF2GameplayAbilityUtilities::GetTag(WeightGroup));
+FGameplayAbilitySpec* UPF2AbilitySystemComponent::FindIndexedAbilitySpec(
+	const FGameplayAbilitySpecHandle Handle) const
+{
+	const TArray<FGameplayAbilitySpec>& Specs       = this->ActivatableAbilities.Items;
+	const int32*                        CachedIndex = this->AbilitySpecIndices.Find(Handle);
 
-	// Special case: If the GE being activated is our "dummy" GE for dynamic tags, apply tags to it.
-	//
-	// TODO: Find a different way to accomplish this without a GE. This feels very much like a kludge.
-	if (GameplayEffect->GetName() == PF2CharacterConstants::GeDynamicTagsClassName)
+	if ((CachedIndex != nullptr) && Specs.IsValidIndex(*CachedIndex) && (Specs[*CachedIndex].Handle == Handle))
 	{
-		GameplayEffectSpec->DynamicGrantedTags.AppendTags(this->DynamicTags);
+		return const_cast<FGameplayAbilitySpec*>(&Specs[*CachedIndex]);
 	}
 
-	if (NewHandle.IsValid())
+	// The spec has moved (e.g., because another ability was removed), so find it again.
+	for (int32 SpecIndex = 0; SpecIndex < Specs.Num(); ++SpecIndex)
 	{
-		this->ApplyGameplayEffectSpecToTarget(*GameplayEffectSpec, this);
+		if (Specs[SpecIndex].Handle == Handle)
+		{
+			this->AbilitySpecIndices.Add(Handle, SpecIndex);
+
+			return const_cast<FGameplayAbilitySpec*>(&Specs[SpecIndex]);
+		}
 	}
+
+	return nullptr;
 }
 
-template <typename Func>
-void UPF2AbilitySystemComponent::InvokeAndReapplyAllPassiveGEs(const Func Callable)
+FPF2StateSnapshotLayer* UPF2AbilitySystemComponent::GetStateSnapshotLayerForChange()
+{
+	if ((this->StateSnapshotLayers.Num() == 0) || this->bRestoringStateSnapshot)
+	{
+		return nullptr;
+	}
+	else
+	{
+		// Only the newest snapshot needs the old value. Older snapshots either already have a value that is older, or
+		// get this one when the newer snapshots are released.
+		return &this->StateSnapshotLayers.Last();
+	}
+}
+
+int32 UPF2AbilitySystemComponent::FindStateSnapshotLayer(const FPF2StateSnapshotHandle Snapshot) const
+{
+	return this->StateSnapshotLayers.IndexOfByPredicate([Snapshot](const FPF2StateSnapshotLayer& Layer)
+	{
+		return Layer.Id == Snapshot.Id;
+	});
+}
+
+FPF2StateSnapshotLayer UPF2AbilitySystemComponent::PopStateSnapshotLayers(const int32 LayerIndex)
+{
+	FPF2StateSnapshotLayer Layer = MoveTemp(this->StateSnapshotLayers[LayerIndex]);
+
+	for (int32 NewerLayerIndex = LayerIndex + 1; NewerLayerIndex < this->StateSnapshotLayers.Num(); ++NewerLayerIndex)
+	{
+		this->StateSnapshotLayers[NewerLayerIndex].MergeInto(Layer);
+	}
+
+	this->StateSnapshotLayers.SetNum(LayerIndex);
+
+	return Layer;
+}
+
+void UPF2AbilitySystemComponent::RecordDynamicTagsForSnapshot(const FGameplayTagContainer& OldDynamicTags)
+{
+	FPF2StateSnapshotLayer* Layer = this->GetStateSnapshotLayerForChange();
+
+	if ((Layer != nullptr) && !Layer->DynamicTags.IsSet())
+	{
+		Layer->DynamicTags = OldDynamicTags;
+	}
+}
+
+void UPF2AbilitySystemComponent::RecordPassiveGameplayEffectsForSnapshot()
+{
+	FPF2StateSnapshotLayer* Layer = this->GetStateSnapshotLayerForChange();
+
+	if ((Layer != nullptr) && !Layer->PassiveGameplayEffects.IsSet())
+	{
+		Layer->PassiveGameplayEffects = this->PassiveGameplayEffects;
+	}
+}
+
+void UPF2AbilitySystemComponent::BindAttributeValueCallbacks()
+{
+	if (this->bAttributeValueCallbacksBound)
+	{
+		return;
+	}
+
+	for (int32 AttributeIndex = 0; AttributeIndex < PF2AttributeRegistry::Num; ++AttributeIndex)
+	{
+		const EPF2AttributeIndex Index = static_cast<EPF2AttributeIndex>(AttributeIndex);
+
+		this->GetGameplayAttributeValueChangeDelegate(PF2AttributeRegistry::GetAttribute(Index)).AddUObject(
+			this,
+			&UPF2AbilitySystemComponent::OnAttributeValueChanged
+		);
+	}
+
+	this->bAttributeValueCallbacksBound = true;
+}
+
+void UPF2AbilitySystemComponent::OnAttributeValueChanged(const FOnAttributeChangeData& ChangeData)
+{
+	UPF2AttributeSet* AttributeSet = const_cast<UPF2AttributeSet*>(this->GetSet<UPF2AttributeSet>());
+
+	if ((AttributeSet != nullptr) && (ChangeData.OldValue != ChangeData.NewValue))
+	{
+		AttributeSet->NotifyAttributeValueChanged(ChangeData.Attribute, ChangeData.OldValue, ChangeData.NewValue);
+
+		// The server sends overrides for statistics that differ from what clients derive, so a change to any attribute
+		// can change what it sends. Clients derive statistics when attributes arrive instead (see PostNetReceive()).
+		if (this->IsOwnerActorAuthoritative())
+		{
+			this->ScheduleDerivedStatisticsUpdate();
+		}
+	}
+}
+
+void UPF2AbilitySystemComponent::BindAttributeChangeFeed()
+{
+	if (this->bAttributeChangeFeedBound)
+	{
+		return;
+	}
+
+	for (int32 AttributeIndex = 0; AttributeIndex < PF2AttributeRegistry::Num; ++AttributeIndex)
+	{
+		const EPF2AttributeIndex Index = static_cast<EPF2AttributeIndex>(AttributeIndex);
+
+		// The index is bound as a payload, so that changes do not have to look it up.
+		this->GetGameplayAttributeValueChangeDelegate(PF2AttributeRegistry::GetAttribute(Index)).AddUObject(
+			this,
+			&UPF2AbilitySystemComponent::OnAttributeChangedForFeed,
+			Index
+		);
+	}
+
+	this->RegisterGenericGameplayTagEvent().AddUObject(this, &UPF2AbilitySystemComponent::OnTagChangedForFeed);
+
+	this->bAttributeChangeFeedBound = true;
+}
+
+void UPF2AbilitySystemComponent::OnAttributeChangedForFeed(const FOnAttributeChangeData& ChangeData,
+                                                           const EPF2AttributeIndex      Index)
+{
+	if (ChangeData.OldValue != ChangeData.NewValue)
+	{
+		this->AttributeChangeFeed.MarkAttributeChanged(Index);
+		this->ScheduleAttributeChangeFeedFlush();
+	}
+}
+
+void UPF2AbilitySystemComponent::OnTagChangedForFeed(const FGameplayTag Tag, const int32 NewCount)
+{
+	this->AttributeChangeFeed.MarkTagChanged(Tag);
+	this->ScheduleAttributeChangeFeedFlush();
+}
+
+void UPF2AbilitySystemComponent::ScheduleAttributeChangeFeedFlush()
+{
+	if (!this->AttributeChangeFeedFlushHandle.IsValid())
+	{
+		this->AttributeChangeFeedFlushHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+			this,
+			&UPF2AbilitySystemComponent::FlushAttributeChangeFeed
+		);
+	}
+}
+
+void UPF2AbilitySystemComponent::FlushAttributeChangeFeed(UWorld*          World,
+                                                          const ELevelTick TickType,
+                                                          const float      DeltaSeconds)
+{
+	FPF2AttributeChangeSet Changes;
+
+	if (World != this->GetWorld())
+	{
+		return;
+	}
+
+	// Only stay bound while there are changes to send, so that ASCs of idle characters cost nothing each frame.
+	FWorldDelegates::OnWorldPostActorTick.Remove(this->AttributeChangeFeedFlushHandle);
+	this->AttributeChangeFeedFlushHandle.Reset();
+
+	if (!this->AttributeChangeFeed.HasChanges())
+	{
+		return;
+	}
+
+	// Changes are consumed before listeners are notified, so that any changes listeners make go into the next frame.
+	Changes = this->AttributeChangeFeed.ConsumeChanges();
+
+	this->OnAttributesChangedNative.Broadcast(Changes);
+	this->OnAttributesChanged.Broadcast(Changes);
+}
+
+void UPF2AbilitySystemComponent::UpdateDerivedStatistics(UWorld*          World,
+                                                         const ELevelTick TickType,
+                                                         const float      DeltaSeconds)
+{
+	if (World != this->GetWorld())
+	{
+		return;
+	}
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(this->DerivedStatisticsUpdateHandle);
+	this->DerivedStatisticsUpdateHandle.Reset();
+
+	if (this->IsOwnerActorAuthoritative())
+	{
+		this->UpdateDerivedStatisticsForReplication();
+		return;
+	}
+
+	for (UAttributeSet* AttributeSet : this->GetSpawnedAttributes())
+	{
+		UPF2AttributeSet* Pf2AttributeSet = Cast<UPF2AttributeSet>(AttributeSet);
+
+		if (Pf2AttributeSet != nullptr)
+		{
+			Pf2AttributeSet->ApplyDerivedStatistics();
+		}
+	}
+}
+
+void UPF2AbilitySystemComponent::UpdateDerivedStatisticsForReplication()
+{
+	this->bDerivedStatisticsReplicationDirty = false;
+
+	for (UAttributeSet* AttributeSet : this->GetSpawnedAttributes())
+	{
+		UPF2AttributeSet* Pf2AttributeSet = Cast<UPF2AttributeSet>(AttributeSet);
+
+		if (Pf2AttributeSet != nullptr)
+		{
+			Pf2AttributeSet->UpdateDerivedStatisticsForReplication();
+		}
+	}
+}
+
+FGameplayEffectSpecHandle UPF2AbilitySystemComponent::GetPassiveGameplayEffectSpec(
+	const FPF2PassiveEffectPlanEntry& Entry)
 {
-	const bool bWasActive = this->ArePassiveGameplayEffectsActive();
+	const FName                                   WeightGroup    = Entry.WeightGroup;
+	const int32                                   CharacterLevel = this->GetCharacterLevel();
+	const TSharedRef<const FPF2PassiveEffectPlan> Plan           = this->GetPassiveEffectPlan();
+	const FPF2PassiveEffectDependencyGraph&       Graph          = Plan->GetDependencyGraph();
+	FGameplayEffectSpecHandle                     SpecHandle;
+	FGameplayEffectContextHandle                  EffectContext;
+
+	if (Entry.Definition == nullptr)
+	{
+		return SpecHandle;
+	}
+
+	SpecHandle = this->PassiveEffectSpecCache.Find(Entry.Definition, WeightGroup, CharacterLevel);
+
+	if (SpecHandle.IsValid())
+	{
+		const FGameplayTagContainer CapturedTags = SpecHandle.Data->CapturedSourceTags.GetActorTags(),
+		                            ChangedTags  = GetChangedTags(CapturedTags, this->GetActiveGameplayTags());
 
-	if (bWasActive)
+		const bool bReadsChangedTags =
+			Entry.Effects.ContainsByPredicate([&Graph, &ChangedTags](const TSubclassOf<UGameplayEffect>& Effect)
+			{
+				return Graph.DoesEffectReadAnyTag(Effect, ChangedTags);
+			});
+
+		if (!bReadsChangedTags)
+		{
+			return SpecHandle;
+		}
+	}
+
+	EffectContext = this->MakeEffectContext();
+	EffectContext.AddSourceObject(this);
+
+	// This is equivalent to MakeOutgoingSpec(), except that it also works for composite GEs, which have no class of
+	// their own from which to get a default object.
+	SpecHandle = FGameplayEffectSpecHandle(new FGameplayEffectSpec(Entry.Definition, EffectContext, CharacterLevel));
+
+	if (SpecHandle.IsValid())
 	{
-		this->DeactivateAllPassiveGameplayEffects();
+		// Ensure that the GE spec is tagged with its weight no matter how the weight was set (either through API or
+		// through a tag in the InheritableGameplayEffectTags field on the GE definition class itself). Without this,
+		// only the tag from the GE definition spec would pass through.
+		SpecHandle.Data->DynamicAssetTags.AddTag(PF2GameplayAbilityUtilities::GetTag(WeightGroup));
+
+		// Composite GEs never combine GEs that capture snapshots, so it is enough to check the first GE.
+		if (!Graph.DoesEffectReadSnapshotAttributes(Entry.Effects[0]))
+		{
+			this->PassiveEffectSpecCache.Add(Entry.Definition, WeightGroup, CharacterLevel, SpecHandle);
+		}
 	}
 
+	return SpecHandle;
+}
+
+template <typename Func>
+void UPF2AbilitySystemComponent::InvokeAndReapplyPassiveGEsAffectedByDynamicTags(const Func Callable)
+{
+	FPF2PassiveEffectStatsScope StatsScope(this->PassiveEffectStats, EPF2PassiveEffectTrigger::DynamicTags);
+
+	const FGameplayTagContainer OldDynamicTags = this->DynamicTags;
+	FGameplayTagContainer       ChangedTags;
+
 	Callable();
 
-	if (bWasActive)
+	ChangedTags = GetChangedTags(OldDynamicTags, this->DynamicTags);
+
+	if (!ChangedTags.IsEmpty())
 	{
-		this->ActivateAllPassiveGameplayEffects();
+		this->RecordDynamicTagsForSnapshot(OldDynamicTags);
+
+		MARK_PROPERTY_DIRTY_FROM_NAME(UPF2AbilitySystemComponent, DynamicTags, this);
+	}
+
+	// Tags are granted right away, even during a batch, since doing so only touches the tags that changed.
+	this->UpdateLooseDynamicTags(ChangedTags);
+
+	if (!this->ArePassiveGameplayEffectsActive() || this->IsPassiveGameplayEffectBatchOpen())
+	{
+		// Either there's nothing to re-apply, or the batch will take care of comparing tags when it ends.
+		return;
+	}
+
+	if (!ChangedTags.IsEmpty())
+	{
+		this->ReapplyPassiveGameplayEffectsAffectedByTags(ChangedTags);
 	}
 }
 
@@ -523,6 +2143,14 @@ void UPF2AbilitySystemComponent::InvokeAndReapplyPassiveGEsInSubsequentWeightGro
 	const FName WeightGroup,
 	const Func Callable)
 {
+	if (this->IsPassiveGameplayEffectBatchOpen())
+	{
+		Callable();
+
+		this->PassiveEffectBatchDirtyWeightGroups.Add(WeightGroup);
+		return;
+	}
+
 	// NOTE: If the group we are affecting isn't active, we don't bother to re-apply subsequent groups because they
 	// won't be affected.
 	const bool bSubsequentGroupsWereActive =
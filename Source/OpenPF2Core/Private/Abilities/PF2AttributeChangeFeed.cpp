@@ -0,0 +1,46 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2AttributeChangeFeed.h"
+
+void FPF2AttributeChangeFeed::MarkAttributeChanged(const EPF2AttributeIndex Index)
+{
+	FBitReference ChangedBit = this->ChangedAttributes[PF2AttributeRegistry::ToInt(Index)];
+
+	if (!ChangedBit)
+	{
+		ChangedBit = true;
+		++this->NumChangedAttributes;
+	}
+}
+
+void FPF2AttributeChangeFeed::MarkTagChanged(const FGameplayTag Tag)
+{
+	this->ChangedTags.AddTag(Tag);
+}
+
+FPF2AttributeChangeSet FPF2AttributeChangeFeed::ConsumeChanges()
+{
+	FPF2AttributeChangeSet Changes;
+
+	Changes.Attributes.Reserve(this->NumChangedAttributes);
+
+	for (TConstSetBitIterator<> BitIterator(this->ChangedAttributes); BitIterator; ++BitIterator)
+	{
+		Changes.Attributes.Add(
+			PF2AttributeRegistry::GetAttribute(static_cast<EPF2AttributeIndex>(BitIterator.GetIndex()))
+		);
+	}
+
+	Changes.Tags           = MoveTemp(this->ChangedTags);
+	Changes.AttributeFlags = this->ChangedAttributes;
+
+	this->ChangedAttributes.Init(false, PF2AttributeRegistry::Num);
+	this->ChangedTags.Reset();
+
+	this->NumChangedAttributes = 0;
+
+	return Changes;
+}
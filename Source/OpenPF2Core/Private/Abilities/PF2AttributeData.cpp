@@ -0,0 +1,114 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2AttributeData.h"
+
+#include <HAL/IConsoleManager.h>
+
+static TAutoConsoleVariable<bool> CVarQuantizeAttributes(
+	TEXT("OpenPF2.QuantizeAttributes"),
+	true,
+	TEXT("Whether the server sends whole-number OpenPF2 attribute values as integers instead of floats.")
+);
+
+/**
+ * The largest magnitude of a value that is sent as an integer.
+ *
+ * Every whole number up to this magnitude can be represented exactly by a float.
+ */
+static constexpr float MaxQuantizedMagnitude = 16777216.0f;
+
+/**
+ * Determines whether an attribute value can be sent as an integer without losing any precision.
+ *
+ * @param Value
+ *	The attribute value.
+ *
+ * @return
+ *	- TRUE if the value is a whole number that a float can represent exactly.
+ *	- FALSE, otherwise.
+ */
+static bool CanQuantizeValue(const float Value)
+{
+	return (FMath::Abs(Value) <= MaxQuantizedMagnitude) && (FMath::RoundToFloat(Value) == Value);
+}
+
+/**
+ * Writes or reads an attribute value as a variable-length integer.
+ *
+ * The value is zig-zag encoded so that small negative values (e.g., ability modifiers and penalties) stay small.
+ *
+ * @param Ar
+ *	The archive to which the value is written, or from which the value is read.
+ * @param Value
+ *	The value to write; or, the value that has been read.
+ */
+static void SerializeQuantizedValue(FArchive& Ar, float& Value)
+{
+	uint32 EncodedValue = 0;
+
+	if (Ar.IsSaving())
+	{
+		const int32 IntValue = FMath::RoundToInt(Value);
+
+		EncodedValue = (static_cast<uint32>(IntValue) << 1) ^ static_cast<uint32>(IntValue >> 31);
+	}
+
+	Ar.SerializeIntPacked(EncodedValue);
+
+	if (Ar.IsLoading())
+	{
+		const int32 IntValue = static_cast<int32>(EncodedValue >> 1) ^ -static_cast<int32>(EncodedValue & 1);
+
+		Value = static_cast<float>(IntValue);
+	}
+}
+
+bool FPF2AttributeData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 bQuantized     = 0,
+	      bCurrentIsBase = 0;
+
+	if (Ar.IsSaving())
+	{
+		bQuantized =
+			CVarQuantizeAttributes.GetValueOnAnyThread() &&
+			CanQuantizeValue(this->BaseValue) &&
+			CanQuantizeValue(this->CurrentValue);
+
+		bCurrentIsBase = (this->CurrentValue == this->BaseValue);
+	}
+
+	Ar.SerializeBits(&bQuantized, 1);
+	Ar.SerializeBits(&bCurrentIsBase, 1);
+
+	if (bQuantized)
+	{
+		SerializeQuantizedValue(Ar, this->BaseValue);
+
+		if (!bCurrentIsBase)
+		{
+			SerializeQuantizedValue(Ar, this->CurrentValue);
+		}
+	}
+	else
+	{
+		Ar << this->BaseValue;
+
+		if (!bCurrentIsBase)
+		{
+			Ar << this->CurrentValue;
+		}
+	}
+
+	if (Ar.IsLoading() && bCurrentIsBase)
+	{
+		this->CurrentValue = this->BaseValue;
+	}
+
+	bOutSuccess = !Ar.IsError();
+
+	return true;
+}
@@ -0,0 +1,166 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2AttributeRegistry.h"
+
+#include <UObject/UnrealType.h>
+
+#include "Abilities/PF2AttributeSet.h"
+
+namespace PF2AttributeRegistry
+{
+	/**
+	 * The lookup tables of the registry, built once from PF2_ATTRIBUTES.
+	 */
+	struct FPF2AttributeRegistryTables
+	{
+		/**
+		 * The gameplay attribute for each index.
+		 */
+		TArray<FGameplayAttribute> Attributes;
+
+		/**
+		 * The name of the attribute property for each index.
+		 */
+		TArray<FName> Names;
+
+		/**
+		 * The category of the attribute for each index.
+		 */
+		TArray<EPF2AttributeCategory> Categories;
+
+		/**
+		 * The index of each attribute, keyed by attribute property.
+		 */
+		TMap<const FProperty*, EPF2AttributeIndex> IndicesByProperty;
+
+		/**
+		 * The index of each attribute, keyed by the name of the attribute property.
+		 */
+		TMap<FName, EPF2AttributeIndex> IndicesByName;
+
+		/**
+		 * Constructor for FPF2AttributeRegistryTables.
+		 */
+		FPF2AttributeRegistryTables()
+		{
+			int32 NumAttributeProperties = 0;
+
+			this->Attributes.Reserve(Num);
+			this->Names.Reserve(Num);
+			this->Categories.Reserve(Num);
+
+#define PF2_REGISTER_ATTRIBUTE(Name, Category, DefaultValue, Replication) \
+			this->Register( \
+				UPF2AttributeSet::Get##Name##Attribute(), \
+				GET_MEMBER_NAME_CHECKED(UPF2AttributeSet, Name), \
+				EPF2AttributeCategory::Category \
+			);
+
+			PF2_ATTRIBUTES(PF2_REGISTER_ATTRIBUTE)
+
+#undef PF2_REGISTER_ATTRIBUTE
+
+			for (TFieldIterator<FProperty> PropertyIterator(UPF2AttributeSet::StaticClass()); PropertyIterator;
+			     ++PropertyIterator)
+			{
+				if (FGameplayAttribute::IsGameplayAttributeDataProperty(*PropertyIterator))
+				{
+					++NumAttributeProperties;
+				}
+			}
+
+			checkf(
+				NumAttributeProperties == Num,
+				TEXT("UPF2AttributeSet has %d attributes, but %d are listed in PF2_ATTRIBUTES."),
+				NumAttributeProperties,
+				Num
+			);
+		}
+
+		/**
+		 * Adds the next attribute to the tables.
+		 *
+		 * @param Attribute
+		 *	The gameplay attribute.
+		 * @param Name
+		 *	The name of the attribute property.
+		 * @param Category
+		 *	The category of the attribute.
+		 */
+		void Register(const FGameplayAttribute& Attribute, const FName Name, const EPF2AttributeCategory Category)
+		{
+			const EPF2AttributeIndex Index = static_cast<EPF2AttributeIndex>(this->Attributes.Num());
+
+			this->Attributes.Add(Attribute);
+			this->Names.Add(Name);
+			this->Categories.Add(Category);
+
+			this->IndicesByProperty.Add(Attribute.GetUProperty(), Index);
+			this->IndicesByName.Add(Name, Index);
+		}
+	};
+
+	/**
+	 * Gets the lookup tables of the registry, building them on first use.
+	 *
+	 * @return
+	 *	The registry tables.
+	 */
+	static const FPF2AttributeRegistryTables& GetTables()
+	{
+		static const FPF2AttributeRegistryTables Tables;
+
+		return Tables;
+	}
+
+	const FGameplayAttribute& GetAttribute(const EPF2AttributeIndex Index)
+	{
+		return GetTables().Attributes[ToInt(Index)];
+	}
+
+	FName GetName(const EPF2AttributeIndex Index)
+	{
+		return GetTables().Names[ToInt(Index)];
+	}
+
+	EPF2AttributeCategory GetCategory(const EPF2AttributeIndex Index)
+	{
+		return GetTables().Categories[ToInt(Index)];
+	}
+
+	EPF2AttributeGroup GetGroup(const EPF2AttributeIndex Index)
+	{
+		switch (GetCategory(Index))
+		{
+			case EPF2AttributeCategory::Advancement:
+			case EPF2AttributeCategory::Feat:
+				return EPF2AttributeGroup::CharacterBuilding;
+
+			case EPF2AttributeCategory::Resistance:
+				return EPF2AttributeGroup::Resistances;
+
+			case EPF2AttributeCategory::Skill:
+				return EPF2AttributeGroup::Skills;
+
+			default:
+				return EPF2AttributeGroup::Core;
+		}
+	}
+
+	EPF2AttributeIndex IndexOf(const FGameplayAttribute& Attribute)
+	{
+		const EPF2AttributeIndex* Index = GetTables().IndicesByProperty.Find(Attribute.GetUProperty());
+
+		return (Index == nullptr) ? EPF2AttributeIndex::Count : *Index;
+	}
+
+	EPF2AttributeIndex IndexOfName(const FName Name)
+	{
+		const EPF2AttributeIndex* Index = GetTables().IndicesByName.Find(Name);
+
+		return (Index == nullptr) ? EPF2AttributeIndex::Count : *Index;
+	}
+}
@@ -1,4 +1,4 @@
-// OpenPF2 for UE Game Logic, Copyright 2021-2022, Guy Elsmore-Paddock. All Rights Reserved.
+﻿// OpenPF2 for UE Game Logic, Copyright 2021-2022, Guy Elsmore-Paddock. All Rights Reserved.
 //
 // Content from Pathfinder 2nd Edition is licensed under the Open Game License (OGL) v1.0a, subject to the following:
 //   - Open Game License v 1.0a, Copyright 2000, Wizards of the Coast, Inc.
@@ -13,520 +13,461 @@
 #include "Abilities/PF2AttributeSet.h"
 
 #include <GameplayEffectExtension.h>
+#include <TimerManager.h>
+#include <Engine/World.h>
 #include <GameFramework/Controller.h>
 #include <Net/UnrealNetwork.h>
+#include <Net/Core/PushModel/PushModel.h>
 
 #include "AbilitySystemBlueprintLibrary.h"
+#include "OpenPF2Core.h"
 #include "PF2CharacterInterface.h"
+#include "Abilities/PF2AbilitySystemComponent.h"
+#include "Abilities/PF2CharacterAbilitySystemComponentInterface.h"
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+/**
+ * How long a client waits for the rest of the inputs of derived statistics to arrive before it reports that the
+ * statistics it derived do not match the server.
+ */
+static constexpr float DerivedStatisticsVerificationDelaySeconds = 2.0f;
+
+/**
+ * Builds the parameters for replicating a property of an attribute set with the push model.
+ *
+ * @param Condition
+ *	The condition under which the property is replicated.
+ *
+ * @return
+ *	The replication parameters for the property.
+ */
+static FDoRepLifetimeParams MakePushBasedParams(const ELifetimeCondition Condition)
+{
+	FDoRepLifetimeParams Params;
+
+	Params.Condition    = Condition;
+	Params.bIsPushBased = true;
+
+	return Params;
+}
+
+/**
+ * Gets the type of damage that each resistance attribute reduces.
+ *
+ * @return
+ *	The tag of the damage type for each attribute, indexed by EPF2AttributeIndex. The tag of each attribute that is not
+ *	a resistance is empty.
+ */
+static const TArray<FGameplayTag>& GetResistanceDamageTypes()
+{
+	static const TArray<FGameplayTag> ResistanceDamageTypes = []
+	{
+		const TArray<TPair<EPF2AttributeIndex, const TCHAR*>> DamageTypeNames =
+		{
+			{ EPF2AttributeIndex::RstPhysicalBludgeoning, TEXT("DamageType.Physical.Bludgeoning") },
+			{ EPF2AttributeIndex::RstPhysicalPiercing,    TEXT("DamageType.Physical.Piercing") },
+			{ EPF2AttributeIndex::RstPhysicalSlashing,    TEXT("DamageType.Physical.Slashing") },
+			{ EPF2AttributeIndex::RstEnergyAcid,          TEXT("DamageType.Energy.Acid") },
+			{ EPF2AttributeIndex::RstEnergyCold,          TEXT("DamageType.Energy.Cold") },
+			{ EPF2AttributeIndex::RstEnergyFire,          TEXT("DamageType.Energy.Fire") },
+			{ EPF2AttributeIndex::RstEnergySonic,         TEXT("DamageType.Energy.Sonic") },
+			{ EPF2AttributeIndex::RstEnergyPositive,      TEXT("DamageType.Energy.Positive") },
+			{ EPF2AttributeIndex::RstEnergyNegative,      TEXT("DamageType.Energy.Negative") },
+			{ EPF2AttributeIndex::RstEnergyForce,         TEXT("DamageType.Energy.Force") },
+			{ EPF2AttributeIndex::RstAlignmentChaotic,    TEXT("DamageType.Alignment.Chaotic") },
+			{ EPF2AttributeIndex::RstAlignmentEvil,       TEXT("DamageType.Alignment.Evil") },
+			{ EPF2AttributeIndex::RstAlignmentGood,       TEXT("DamageType.Alignment.Good") },
+			{ EPF2AttributeIndex::RstAlignmentLawful,     TEXT("DamageType.Alignment.Lawful") },
+			{ EPF2AttributeIndex::RstMental,              TEXT("DamageType.Mental") },
+			{ EPF2AttributeIndex::RstPoison,              TEXT("DamageType.Poison") },
+			{ EPF2AttributeIndex::RstBleed,               TEXT("DamageType.Bleed") },
+			{ EPF2AttributeIndex::RstPrecision,           TEXT("DamageType.Precision") },
+		};
+
+		TArray<FGameplayTag> DamageTypes;
+
+		DamageTypes.SetNum(PF2AttributeRegistry::Num);
+
+		for (const TPair<EPF2AttributeIndex, const TCHAR*>& DamageTypeName : DamageTypeNames)
+		{
+			DamageTypes[PF2AttributeRegistry::ToInt(DamageTypeName.Key)] =
+				PF2GameplayAbilityUtilities::GetTag(FName(DamageTypeName.Value));
+		}
 
-UPF2AttributeSet::UPF2AttributeSet() :
-	Experience(0.0f),
-	AbBoostCount(0.0f),
-	AbBoostLimit(0.0f),
-	AbStrength(10.0f),
-	AbStrengthModifier(0.0f),
-	AbDexterity(10.0f),
-	AbDexterityModifier(0.0f),
-	AbConstitution(10.0f),
-	AbConstitutionModifier(0.0f),
-	AbIntelligence(10.0f),
-	AbIntelligenceModifier(0.0f),
-	AbWisdom(10.0f),
-	AbWisdomModifier(0.0f),
-	AbCharisma(10.0f),
-	AbCharismaModifier(0.0f),
-	ClassDifficultyClass(0.0f),
-	Speed(1.0f),
-	MaxSpeed(1.0f),
-	ArmorClass(10.0f),
-	StFortitudeModifier(0.0f),
-	StReflexModifier(0.0f),
-	StWillModifier(0.0f),
-	HitPoints(1.0f),
-	MaxHitPoints(1.0f),
-	RstPhysicalBludgeoning(0.0f),
-	RstPhysicalPiercing(0.0f),
-	RstPhysicalSlashing(0.0f),
-	RstEnergyAcid(0.0f),
-	RstEnergyCold(0.0f),
-	RstEnergyFire(0.0f),
-	RstEnergySonic(0.0f),
-	RstEnergyPositive(0.0f),
-	RstEnergyNegative(0.0f),
-	RstEnergyForce(0.0f),
-	RstAlignmentChaotic(0.0f),
-	RstAlignmentEvil(0.0f),
-	RstAlignmentGood(0.0f),
-	RstAlignmentLawful(0.0f),
-	RstMental(0.0f),
-	RstPoison(0.0f),
-	RstBleed(0.0f),
-	RstPrecision(0.0f),
-	PerceptionModifier(0.0f),
-	SkAcrobaticsModifier(0.0f),
-	SkArcanaModifier(0.0f),
-	SkAthleticsModifier(0.0f),
-	SkCraftingModifier(0.0f),
-	SkDeceptionModifier(0.0f),
-	SkDiplomacyModifier(0.0f),
-	SkIntimidationModifier(0.0f),
-	SkLore1Modifier(0.0f),
-	SkLore2Modifier(0.0f),
-	SkMedicineModifier(0.0f),
-	SkNatureModifier(0.0f),
-	SkOccultismModifier(0.0f),
-	SkPerformanceModifier(0.0f),
-	SkReligionModifier(0.0f),
-	SkSocietyModifier(0.0f),
-	SkStealthModifier(0.0f),
-	SkSurvivalModifier(0.0f),
-	SkThieveryModifier(0.0f),
-	SpellAttackRoll(0.0f),
-	SpellDifficultyClass(0.0f),
-	FeAncestryFeatCount(0.0f),
-	FeAncestryFeatLimit(0.0f),
-	EncActionPoints(0.0f),
-	EncReactionPoints(0.0f),
-	TmpDamageIncoming(0.0f)
-{
-}
-
-void UPF2AttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	DOREPLIFETIME(UPF2AttributeSet, Experience);
-	DOREPLIFETIME(UPF2AttributeSet, AbBoostCount);
-	DOREPLIFETIME(UPF2AttributeSet, AbBoostLimit);
-	DOREPLIFETIME(UPF2AttributeSet, AbStrength);
-	DOREPLIFETIME(UPF2AttributeSet, AbStrengthModifier);
-	DOREPLIFETIME(UPF2AttributeSet, AbDexterity);
-	DOREPLIFETIME(UPF2AttributeSet, AbDexterityModifier);
-	DOREPLIFETIME(UPF2AttributeSet, AbConstitution);
-	DOREPLIFETIME(UPF2AttributeSet, AbConstitutionModifier);
-	DOREPLIFETIME(UPF2AttributeSet, AbIntelligence);
-	DOREPLIFETIME(UPF2AttributeSet, AbIntelligenceModifier);
-	DOREPLIFETIME(UPF2AttributeSet, AbWisdom);
-	DOREPLIFETIME(UPF2AttributeSet, AbWisdomModifier);
-	DOREPLIFETIME(UPF2AttributeSet, AbCharisma);
-	DOREPLIFETIME(UPF2AttributeSet, AbCharismaModifier);
-	DOREPLIFETIME(UPF2AttributeSet, ClassDifficultyClass);
-	DOREPLIFETIME(UPF2AttributeSet, Speed);
-	DOREPLIFETIME(UPF2AttributeSet, MaxSpeed);
-	DOREPLIFETIME(UPF2AttributeSet, ArmorClass);
-	DOREPLIFETIME(UPF2AttributeSet, StFortitudeModifier);
-	DOREPLIFETIME(UPF2AttributeSet, StReflexModifier);
-	DOREPLIFETIME(UPF2AttributeSet, StWillModifier);
-	DOREPLIFETIME(UPF2AttributeSet, HitPoints);
-	DOREPLIFETIME(UPF2AttributeSet, MaxHitPoints);
-	DOREPLIFETIME(UPF2AttributeSet, RstPhysicalBludgeoning);
-	DOREPLIFETIME(UPF2AttributeSet, RstPhysicalPiercing);
-	DOREPLIFETIME(UPF2AttributeSet, RstPhysicalSlashing);
-	DOREPLIFETIME(UPF2AttributeSet, RstEnergyAcid);
-	DOREPLIFETIME(UPF2AttributeSet, RstEnergyCold);
-	DOREPLIFETIME(UPF2AttributeSet, RstEnergyFire);
-	DOREPLIFETIME(UPF2AttributeSet, RstEnergySonic);
-	DOREPLIFETIME(UPF2AttributeSet, RstEnergyPositive);
-	DOREPLIFETIME(UPF2AttributeSet, RstEnergyNegative);
-	DOREPLIFETIME(UPF2AttributeSet, RstEnergyForce);
-	DOREPLIFETIME(UPF2AttributeSet, RstAlignmentChaotic);
-	DOREPLIFETIME(UPF2AttributeSet, RstAlignmentEvil);
-	DOREPLIFETIME(UPF2AttributeSet, RstAlignmentGood);
-	DOREPLIFETIME(UPF2AttributeSet, RstAlignmentLawful);
-	DOREPLIFETIME(UPF2AttributeSet, RstMental);
-	DOREPLIFETIME(UPF2AttributeSet, RstPoison);
-	DOREPLIFETIME(UPF2AttributeSet, RstBleed);
-	DOREPLIFETIME(UPF2AttributeSet, RstPrecision);
-	DOREPLIFETIME(UPF2AttributeSet, PerceptionModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkAcrobaticsModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkArcanaModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkAthleticsModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkCraftingModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkDeceptionModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkDiplomacyModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkIntimidationModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkLore1Modifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkLore2Modifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkMedicineModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkNatureModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkOccultismModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkPerformanceModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkReligionModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkSocietyModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkStealthModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkSurvivalModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SkThieveryModifier);
-	DOREPLIFETIME(UPF2AttributeSet, SpellAttackRoll);
-	DOREPLIFETIME(UPF2AttributeSet, SpellDifficultyClass);
-	DOREPLIFETIME(UPF2AttributeSet, FeAncestryFeatCount);
-	DOREPLIFETIME(UPF2AttributeSet, FeAncestryFeatLimit);
-	DOREPLIFETIME(UPF2AttributeSet, EncActionPoints);
-	DOREPLIFETIME(UPF2AttributeSet, EncReactionPoints);
-}
-
-void UPF2AttributeSet::OnRep_Experience(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, Experience, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbBoostCount(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbBoostCount, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbBoostLimit(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbBoostLimit, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbStrength(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbStrength, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbStrengthModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbStrengthModifier, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbDexterity(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbDexterity, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbDexterityModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbDexterityModifier, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbConstitution(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbConstitution, OldValue);
-}
-
-void UPF2AttributeSet::OnRep_AbConstitutionModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbConstitutionModifier, OldValue);
-}
+		return DamageTypes;
+	}();
 
-void UPF2AttributeSet::OnRep_AbIntelligence(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbIntelligence, OldValue);
+	return ResistanceDamageTypes;
 }
 
-void UPF2AttributeSet::OnRep_AbIntelligenceModifier(const FGameplayAttributeData& OldValue)
+UPF2AttributeSet::UPF2AttributeSet() :
+#define PF2_INITIALIZE_ATTRIBUTE(Name, Category, DefaultValue, Replication) Name(DefaultValue),
+	PF2_ATTRIBUTES(PF2_INITIALIZE_ATTRIBUTE)
+#undef PF2_INITIALIZE_ATTRIBUTE
+	DerivedStatisticsChecksum(0),
+	LastMismatchedDerivedStatisticsChecksum(0),
+	AttributeGroups(EPF2AttributeGroup::All)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbIntelligenceModifier, OldValue);
 }
 
-void UPF2AttributeSet::OnRep_AbWisdom(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::PostNetReceive()
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbWisdom, OldValue);
-}
+	Super::PostNetReceive();
 
-void UPF2AttributeSet::OnRep_AbWisdomModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbWisdomModifier, OldValue);
-}
+	UPF2AbilitySystemComponent* Asc = Cast<UPF2AbilitySystemComponent>(this->GetOwningAbilitySystemComponent());
 
-void UPF2AttributeSet::OnRep_AbCharisma(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbCharisma, OldValue);
+	// The tags and level from which statistics are derived replicate with the ASC and the character, which can arrive
+	// before or after this attribute set. The ASC derives statistics again whenever any of the inputs arrive.
+	if (Asc != nullptr)
+	{
+		Asc->ScheduleDerivedStatisticsUpdate();
+	}
 }
 
-void UPF2AttributeSet::OnRep_AbCharismaModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, AbCharismaModifier, OldValue);
-}
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-void UPF2AttributeSet::OnRep_ClassDifficultyClass(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, ClassDifficultyClass, OldValue);
-}
+	// Attributes that other players need to see (e.g., in a party or encounter UI), or that are inputs to calculations
+	// that clients perform, go to everyone. Statistics that only matter to the player controlling the character (and to
+	// the server, which makes all rolls) only go to the owner; for NPCs, that means they are not replicated at all.
+	// TmpDamageIncoming is a server-side meta attribute and is never replicated. Sub-classes can change the condition
+	// of any attribute with RESET_REPLIFETIME_CONDITION().
+	//
+	// When clients derive statistics locally, the statistics that are derived are not replicated at all. Only the
+	// overrides and checksum that clients need to reconcile what they derive with the server are replicated instead.
+	//
+	// Resistance attributes are mirrored into the damage type table, which replicates only the entries that change, so
+	// the attributes themselves are not replicated.
+	//
+	// All properties are push-based; attributes are marked dirty by PreAttributeBaseChange() and
+	// NotifyAttributeValueChanged() rather than being compared for every connection on every net update.
+	const bool                 bDeriveStatistics      = FPF2DerivedStatistics::IsEnabled();
+	const FDoRepLifetimeParams PublicParams           = MakePushBasedParams(COND_None),
+	                           OwnerOnlyParams        = MakePushBasedParams(COND_OwnerOnly),
+	                           DerivedStatParams      = MakePushBasedParams(bDeriveStatistics ? COND_Never : COND_None),
+	                           OwnerDerivedStatParams =
+	                               MakePushBasedParams(bDeriveStatistics ? COND_Never : COND_OwnerOnly),
+	                           DerivationParams       = MakePushBasedParams(bDeriveStatistics ? COND_None : COND_Never),
+	                           MirroredParams         = MakePushBasedParams(COND_Never);
+
+#define PF2_REGISTER_ATTRIBUTE_REPLICATION(Name, Category, DefaultValue, Replication) \
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPF2AttributeSet, Name, Replication##Params);
+
+	PF2_REPLICATED_ATTRIBUTES(PF2_REGISTER_ATTRIBUTE_REPLICATION)
+
+#undef PF2_REGISTER_ATTRIBUTE_REPLICATION
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPF2AttributeSet, DerivedStatisticOverrides, DerivationParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPF2AttributeSet, DerivedStatisticsChecksum, DerivationParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPF2AttributeSet, DamageTypeTable, OwnerOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPF2AttributeSet, AttributeGroups, PublicParams);
+}
+
+#define PF2_DEFINE_ATTRIBUTE_ONREP(Name, Category, DefaultValue, Replication) \
+	void UPF2AttributeSet::OnRep_##Name(const FPF2AttributeData& OldValue) \
+	{ \
+		GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, Name, OldValue); \
+	}
 
-void UPF2AttributeSet::OnRep_Speed(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, Speed, OldValue);
-}
+PF2_REPLICATED_ATTRIBUTES(PF2_DEFINE_ATTRIBUTE_ONREP)
 
-void UPF2AttributeSet::OnRep_MaxSpeed(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, MaxSpeed, OldValue);
-}
+#undef PF2_DEFINE_ATTRIBUTE_ONREP
 
-void UPF2AttributeSet::OnRep_ArmorClass(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, ArmorClass, OldValue);
+	Super::PreAttributeChange(Attribute, NewValue);
 }
 
-void UPF2AttributeSet::OnRep_StFortitudeModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::PreAttributeBaseChange(const FGameplayAttribute& Attribute, float& NewValue) const
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, StFortitudeModifier, OldValue);
-}
+	Super::PreAttributeBaseChange(Attribute, NewValue);
 
-void UPF2AttributeSet::OnRep_StReflexModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, StReflexModifier, OldValue);
-}
+	const float OldValue = Attribute.GetGameplayAttributeData(const_cast<UPF2AttributeSet*>(this))->GetBaseValue();
 
-void UPF2AttributeSet::OnRep_StWillModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, StWillModifier, OldValue);
-}
+	if (OldValue != NewValue)
+	{
+		UPF2AbilitySystemComponent* Asc = Cast<UPF2AbilitySystemComponent>(this->GetOwningAbilitySystemComponent());
 
-void UPF2AttributeSet::OnRep_HitPoints(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, HitPoints, OldValue);
-}
+		// The base value is replicated along with the current value, and can change without the current value changing
+		// (e.g., while an override modifier is active), so it has to be marked dirty here as well.
+		this->MarkAttributeDirty(Attribute);
 
-void UPF2AttributeSet::OnRep_MaxHitPoints(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, MaxHitPoints, OldValue);
+		// This is the last chance to see the old base value; UE 4.27 has no callback after the base value changes.
+		if (Asc != nullptr)
+		{
+			Asc->RecordAttributeBaseValueForSnapshot(Attribute, OldValue);
+		}
+	}
 }
 
-void UPF2AttributeSet::OnRep_RstPhysicalBludgeoning(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstPhysicalBludgeoning, OldValue);
-}
+	Super::PostGameplayEffectExecute(Data);
 
-void UPF2AttributeSet::OnRep_RstPhysicalPiercing(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstPhysicalPiercing, OldValue);
-}
+	const FGameplayEffectContextHandle Context   = Data.EffectSpec.GetContext();
+	const FGameplayTagContainer*       EventTags = Data.EffectSpec.CapturedSourceTags.GetAggregatedTags();
 
-void UPF2AttributeSet::OnRep_RstPhysicalSlashing(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstPhysicalSlashing, OldValue);
-}
+	IPF2CharacterInterface* TargetCharacter = PF2GameplayAbilityUtilities::GetEffectTarget(&Data);
 
-void UPF2AttributeSet::OnRep_RstEnergyAcid(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstEnergyAcid, OldValue);
-}
+	float ValueDelta = 0;
 
-void UPF2AttributeSet::OnRep_RstEnergyCold(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstEnergyCold, OldValue);
-}
+	if (Data.EvaluatedData.ModifierOp == EGameplayModOp::Type::Additive)
+	{
+		ValueDelta = Data.EvaluatedData.Magnitude;
+	}
 
-void UPF2AttributeSet::OnRep_RstEnergyFire(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstEnergyFire, OldValue);
+	if (Data.EvaluatedData.Attribute == this->GetTmpDamageIncomingAttribute())
+	{
+		this->HandleDamageIncomingChanged(TargetCharacter, Context, ValueDelta, EventTags);
+	}
+	else if (Data.EvaluatedData.Attribute == this->GetHitPointsAttribute())
+	{
+		this->HandleHitPointsChanged(TargetCharacter, Context, ValueDelta, EventTags);
+	}
 }
 
-void UPF2AttributeSet::OnRep_RstEnergySonic(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::UpdateDerivedStatisticsForReplication()
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstEnergySonic, OldValue);
-}
+	const TArray<FGameplayAttribute>&    Attributes = FPF2DerivedStatistics::GetAttributes();
+	TArray<float>                        Values;
+	TArray<FPF2DerivedStatisticOverride> Overrides;
+	uint32                               Checksum;
 
-void UPF2AttributeSet::OnRep_RstEnergyPositive(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstEnergyPositive, OldValue);
-}
+	if (!FPF2DerivedStatistics::IsEnabled() || !this->CalculateDerivedStatistics(Values))
+	{
+		return;
+	}
 
-void UPF2AttributeSet::OnRep_RstEnergyNegative(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstEnergyNegative, OldValue);
-}
+	for (int32 StatisticIndex = 0; StatisticIndex < Attributes.Num(); ++StatisticIndex)
+	{
+		const FGameplayAttribute& Attribute   = Attributes[StatisticIndex];
+		const float               ActualValue = Attribute.GetNumericValue(this);
 
-void UPF2AttributeSet::OnRep_RstEnergyForce(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstEnergyForce, OldValue);
-}
+		// Statistics that the character does not use are never calculated, so clients leave them alone, too.
+		if (!this->IsAttributeInUse(Attribute))
+		{
+			continue;
+		}
 
-void UPF2AttributeSet::OnRep_RstAlignmentChaotic(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstAlignmentChaotic, OldValue);
-}
+		// Any GE other than the one that calculates the statistic (e.g., an item bonus) makes the value on the server
+		// differ from what clients derive on their own.
+		if (ActualValue != Values[StatisticIndex])
+		{
+			Overrides.Emplace(static_cast<uint8>(StatisticIndex), ActualValue);
 
-void UPF2AttributeSet::OnRep_RstAlignmentEvil(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstAlignmentEvil, OldValue);
-}
+			Values[StatisticIndex] = ActualValue;
+		}
+	}
 
-void UPF2AttributeSet::OnRep_RstAlignmentGood(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstAlignmentGood, OldValue);
-}
+	Checksum = FPF2DerivedStatistics::CalculateChecksum(Values);
 
-void UPF2AttributeSet::OnRep_RstAlignmentLawful(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstAlignmentLawful, OldValue);
-}
+	if (Overrides != this->DerivedStatisticOverrides)
+	{
+		this->DerivedStatisticOverrides = MoveTemp(Overrides);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UPF2AttributeSet, DerivedStatisticOverrides, this);
+	}
 
-void UPF2AttributeSet::OnRep_RstMental(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstMental, OldValue);
+	if (Checksum != this->DerivedStatisticsChecksum)
+	{
+		this->DerivedStatisticsChecksum = Checksum;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UPF2AttributeSet, DerivedStatisticsChecksum, this);
+	}
 }
 
-void UPF2AttributeSet::OnRep_RstPoison(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::ApplyDerivedStatistics()
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstPoison, OldValue);
-}
+	UAbilitySystemComponent*          Asc        = this->GetOwningAbilitySystemComponent();
+	const TArray<FGameplayAttribute>& Attributes = FPF2DerivedStatistics::GetAttributes();
+	const UWorld*                     World      = this->GetWorld();
+	TArray<float>                     Values;
+	uint32                            Checksum;
 
-void UPF2AttributeSet::OnRep_RstBleed(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstBleed, OldValue);
-}
+	if (!this->CalculateDerivedStatisticsWithOverrides(Values))
+	{
+		return;
+	}
 
-void UPF2AttributeSet::OnRep_RstPrecision(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, RstPrecision, OldValue);
-}
+	for (int32 StatisticIndex = 0; StatisticIndex < Attributes.Num(); ++StatisticIndex)
+	{
+		const FGameplayAttribute& Attribute     = Attributes[StatisticIndex];
+		FGameplayAttributeData*   AttributeData = Attribute.GetGameplayAttributeData(this);
+		const float               OldValue      = AttributeData->GetCurrentValue(),
+		                          NewValue      = Values[StatisticIndex];
 
-void UPF2AttributeSet::OnRep_PerceptionModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, PerceptionModifier, OldValue);
-}
+		if ((OldValue != NewValue) && this->IsAttributeInUse(Attribute))
+		{
+			AttributeData->SetBaseValue(NewValue);
+			AttributeData->SetCurrentValue(NewValue);
 
-void UPF2AttributeSet::OnRep_SkAcrobaticsModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkAcrobaticsModifier, OldValue);
-}
+			// Notify listeners the same way that a replicated attribute would (see GAMEPLAYATTRIBUTE_REPNOTIFY).
+			Asc->SetBaseAttributeValueFromReplication(Attribute, NewValue, OldValue);
+		}
+	}
 
-void UPF2AttributeSet::OnRep_SkArcanaModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkArcanaModifier, OldValue);
-}
+	Checksum = FPF2DerivedStatistics::CalculateChecksum(Values);
 
-void UPF2AttributeSet::OnRep_SkAthleticsModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkAthleticsModifier, OldValue);
-}
+	if (World == nullptr)
+	{
+		return;
+	}
 
-void UPF2AttributeSet::OnRep_SkCraftingModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkCraftingModifier, OldValue);
+	if (Checksum == this->DerivedStatisticsChecksum)
+	{
+		World->GetTimerManager().ClearTimer(this->DerivedStatisticsVerificationTimer);
+	}
+	else if (!World->GetTimerManager().IsTimerActive(this->DerivedStatisticsVerificationTimer))
+	{
+		// A mismatch is expected while some of the inputs have arrived and others have not, so it is only reported if
+		// it is still there once the rest of the inputs have had time to arrive.
+		World->GetTimerManager().SetTimer(
+			this->DerivedStatisticsVerificationTimer,
+			this,
+			&UPF2AttributeSet::VerifyDerivedStatistics,
+			DerivedStatisticsVerificationDelaySeconds
+		);
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkDeceptionModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::NotifyAttributeValueChanged(const FGameplayAttribute& Attribute,
+                                                   const float               OldValue,
+                                                   const float               NewValue)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkDeceptionModifier, OldValue);
+	if (OldValue != NewValue)
+	{
+		this->MarkAttributeDirty(Attribute);
+		this->MirrorResistanceAttribute(Attribute, NewValue);
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkDiplomacyModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::VerifyDerivedStatistics()
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkDiplomacyModifier, OldValue);
-}
+	TArray<float> Values;
+	uint32        Checksum;
 
-void UPF2AttributeSet::OnRep_SkIntimidationModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkIntimidationModifier, OldValue);
-}
+	if (!this->CalculateDerivedStatisticsWithOverrides(Values))
+	{
+		return;
+	}
 
-void UPF2AttributeSet::OnRep_SkLore1Modifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkLore1Modifier, OldValue);
-}
+	Checksum = FPF2DerivedStatistics::CalculateChecksum(Values);
 
-void UPF2AttributeSet::OnRep_SkLore2Modifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkLore2Modifier, OldValue);
-}
+	if ((Checksum != this->DerivedStatisticsChecksum) &&
+		(this->DerivedStatisticsChecksum != this->LastMismatchedDerivedStatisticsChecksum))
+	{
+		UE_LOG(
+			LogPf2Core,
+			Warning,
+			TEXT("[%s] Statistics derived on this client (checksum %08x) do not match the server (checksum %08x)."),
+			*(GetNameSafe(this->GetOwningActor())),
+			Checksum,
+			this->DerivedStatisticsChecksum
+		);
 
-void UPF2AttributeSet::OnRep_SkMedicineModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkMedicineModifier, OldValue);
+		this->LastMismatchedDerivedStatisticsChecksum = this->DerivedStatisticsChecksum;
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkNatureModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::MarkAttributeDirty(const FGameplayAttribute& Attribute) const
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkNatureModifier, OldValue);
-}
+	const FProperty* Property = Attribute.GetUProperty();
 
-void UPF2AttributeSet::OnRep_SkOccultismModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkOccultismModifier, OldValue);
+	// Attributes that are not replicated (e.g., meta attributes like incoming damage) have no replication index.
+	if ((Property != nullptr) && Property->HasAnyPropertyFlags(CPF_Net))
+	{
+		MARK_PROPERTY_DIRTY(this, Property);
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkPerformanceModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::SetAttributeGroups(const EPF2AttributeGroup NewAttributeGroups)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkPerformanceModifier, OldValue);
+	if (NewAttributeGroups != this->AttributeGroups)
+	{
+		this->AttributeGroups = NewAttributeGroups;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UPF2AttributeSet, AttributeGroups, this);
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkReligionModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::SetDamageTypeResistance(const FGameplayTag DamageType, const float Resistance)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkReligionModifier, OldValue);
+	if (this->DamageTypeTable.SetResistance(DamageType, Resistance))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UPF2AttributeSet, DamageTypeTable, this);
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkSocietyModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::SetDamageTypeWeakness(const FGameplayTag DamageType, const float Weakness)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkSocietyModifier, OldValue);
+	if (this->DamageTypeTable.SetWeakness(DamageType, Weakness))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UPF2AttributeSet, DamageTypeTable, this);
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkStealthModifier(const FGameplayAttributeData& OldValue)
+void UPF2AttributeSet::SetDamageTypeImmunity(const FGameplayTag DamageType, const bool bIsImmune)
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkStealthModifier, OldValue);
+	if (this->DamageTypeTable.SetImmunity(DamageType, bIsImmune))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UPF2AttributeSet, DamageTypeTable, this);
+	}
 }
 
-void UPF2AttributeSet::OnRep_SkSurvivalModifier(const FGameplayAttributeData& OldValue)
+bool UPF2AttributeSet::CalculateDerivedStatistics(TArray<float>& OutValues) const
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkSurvivalModifier, OldValue);
-}
+	const IPF2CharacterAbilitySystemComponentInterface* CharacterAsc =
+		Cast<IPF2CharacterAbilitySystemComponentInterface>(this->GetOwningAbilitySystemComponent());
 
-void UPF2AttributeSet::OnRep_SkThieveryModifier(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SkThieveryModifier, OldValue);
-}
+	if (CharacterAsc == nullptr)
+	{
+		return false;
+	}
 
-void UPF2AttributeSet::OnRep_SpellAttackRoll(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SpellAttackRoll, OldValue);
-}
+	FPF2DerivedStatistics::Calculate(
+		*this,
+		CharacterAsc->GetActiveGameplayTags(),
+		CharacterAsc->GetCharacterLevel(),
+		OutValues
+	);
 
-void UPF2AttributeSet::OnRep_SpellDifficultyClass(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, SpellDifficultyClass, OldValue);
+	return true;
 }
 
-void UPF2AttributeSet::OnRep_FeAncestryFeatCount(const FGameplayAttributeData& OldValue)
+bool UPF2AttributeSet::CalculateDerivedStatisticsWithOverrides(TArray<float>& OutValues) const
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, FeAncestryFeatCount, OldValue);
-}
+	if (!this->CalculateDerivedStatistics(OutValues))
+	{
+		return false;
+	}
 
-void UPF2AttributeSet::OnRep_FeAncestryFeatLimit(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, FeAncestryFeatLimit, OldValue);
-}
+	for (const FPF2DerivedStatisticOverride& Override : this->DerivedStatisticOverrides)
+	{
+		if (OutValues.IsValidIndex(Override.StatisticIndex))
+		{
+			OutValues[Override.StatisticIndex] = Override.Value;
+		}
+	}
 
-void UPF2AttributeSet::OnRep_EncActionPoints(const FGameplayAttributeData& OldValue)
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, EncActionPoints, OldValue);
+	return true;
 }
 
-void UPF2AttributeSet::OnRep_EncReactionPoints(const FGameplayAttributeData& OldValue)
+bool UPF2AttributeSet::IsAttributeInUse(const FGameplayAttribute& Attribute) const
 {
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UPF2AttributeSet, EncReactionPoints, OldValue);
-}
+	const EPF2AttributeIndex AttributeIndex = PF2AttributeRegistry::IndexOf(Attribute);
 
-void UPF2AttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
-{
-	Super::PreAttributeChange(Attribute, NewValue);
+	return (AttributeIndex == EPF2AttributeIndex::Count) ||
+	       EnumHasAnyFlags(this->AttributeGroups, PF2AttributeRegistry::GetGroup(AttributeIndex));
 }
 
-void UPF2AttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
+void UPF2AttributeSet::MirrorResistanceAttribute(const FGameplayAttribute& Attribute, const float NewValue)
 {
-	Super::PostGameplayEffectExecute(Data);
-
-	const FGameplayEffectContextHandle Context   = Data.EffectSpec.GetContext();
-	const FGameplayTagContainer*       EventTags = Data.EffectSpec.CapturedSourceTags.GetAggregatedTags();
+	const EPF2AttributeIndex AttributeIndex = PF2AttributeRegistry::IndexOf(Attribute);
 
-	IPF2CharacterInterface* TargetCharacter = PF2GameplayAbilityUtilities::GetEffectTarget(&Data);
-
-	float ValueDelta = 0;
-
-	if (Data.EvaluatedData.ModifierOp == EGameplayModOp::Type::Additive)
+	if ((AttributeIndex != EPF2AttributeIndex::Count) &&
+		(PF2AttributeRegistry::GetCategory(AttributeIndex) == EPF2AttributeCategory::Resistance))
 	{
-		ValueDelta = Data.EvaluatedData.Magnitude;
-	}
+		const FGameplayTag DamageType = GetResistanceDamageTypes()[PF2AttributeRegistry::ToInt(AttributeIndex)];
 
-	if (Data.EvaluatedData.Attribute == this->GetTmpDamageIncomingAttribute())
-	{
-		this->HandleDamageIncomingChanged(TargetCharacter, Context, ValueDelta, EventTags);
-	}
-	else if (Data.EvaluatedData.Attribute == this->GetHitPointsAttribute())
-	{
-		this->HandleHitPointsChanged(TargetCharacter, Context, ValueDelta, EventTags);
+		this->SetDamageTypeResistance(DamageType, NewValue);
 	}
 }
 
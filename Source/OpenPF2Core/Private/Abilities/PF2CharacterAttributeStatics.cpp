@@ -6,14 +6,24 @@
 #include "Abilities/PF2CharacterAttributeStatics.h"
 #include "GameplayEffectTypes.h"
 
-FORCEINLINE TArray<FGameplayEffectAttributeCaptureDefinition> FPF2CharacterAttributeStatics::GetCaptureDefinitions() const
+FPF2CharacterAttributeStatics::FPF2CharacterAttributeStatics()
 {
-	TArray<FGameplayEffectAttributeCaptureDefinition> Result;
+	this->CaptureDefinitions.Reserve(PF2AttributeRegistry::Num);
 
-	for (auto& Elem : this->CaptureDefinitions)
+	PF2_ATTRIBUTES(PF2_DEFINE_ATTRIBUTE_CAPTUREDEF)
+
+	for (int32 AttributeIndex = 0; AttributeIndex < PF2AttributeRegistry::Num; ++AttributeIndex)
 	{
-		Result.Add(Elem.Value);
-	}
+		const EPF2AttributeIndex    Index    = static_cast<EPF2AttributeIndex>(AttributeIndex);
+		const EPF2AttributeCategory Category = PF2AttributeRegistry::GetCategory(Index);
 
-	return Result;
+		if (Category == EPF2AttributeCategory::Ability)
+		{
+			this->AbilityNames.Add(PF2AttributeRegistry::GetName(Index).ToString());
+		}
+		else if (Category == EPF2AttributeCategory::AbilityModifier)
+		{
+			this->AbilityModifierNames.Add(PF2AttributeRegistry::GetName(Index).ToString());
+		}
+	}
 }
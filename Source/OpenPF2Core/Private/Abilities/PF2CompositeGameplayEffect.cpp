@@ -0,0 +1,69 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2CompositeGameplayEffect.h"
+
+bool UPF2CompositeGameplayEffect::CanCombine(const TSubclassOf<UGameplayEffect> Effect)
+{
+	const UGameplayEffect* EffectCdo;
+
+	if (Effect == nullptr)
+	{
+		return false;
+	}
+
+	EffectCdo = Effect.GetDefaultObject();
+
+	return (EffectCdo->DurationPolicy == EGameplayEffectDurationType::Infinite) &&
+		(EffectCdo->Period.GetValueAtLevel(1) == UGameplayEffect::NO_PERIOD) &&
+		(EffectCdo->StackingType == EGameplayEffectStackingType::None) &&
+		(EffectCdo->ChanceToApplyToTarget.GetValueAtLevel(1) >= 1.0f) &&
+		(EffectCdo->Executions.Num() == 0) &&
+		(EffectCdo->GrantedAbilities.Num() == 0) &&
+		(EffectCdo->ConditionalGameplayEffects.Num() == 0) &&
+		(EffectCdo->ApplicationRequirements.Num() == 0) &&
+		(EffectCdo->GameplayCues.Num() == 0) &&
+		EffectCdo->ApplicationTagRequirements.IsEmpty() &&
+		EffectCdo->OngoingTagRequirements.IsEmpty() &&
+		EffectCdo->RemovalTagRequirements.IsEmpty() &&
+		EffectCdo->GrantedApplicationImmunityTags.IsEmpty() &&
+		EffectCdo->GrantedApplicationImmunityQuery.IsEmpty() &&
+		EffectCdo->RemoveGameplayEffectQuery.IsEmpty() &&
+		EffectCdo->RemoveGameplayEffectsWithTags.CombinedTags.IsEmpty();
+}
+
+UPF2CompositeGameplayEffect* UPF2CompositeGameplayEffect::Create(UObject*                                    Outer,
+                                                                  const FName                                 Name,
+                                                                  const TArray<TSubclassOf<UGameplayEffect>>& Effects)
+{
+	UPF2CompositeGameplayEffect* CompositeEffect = NewObject<UPF2CompositeGameplayEffect>(Outer, Name, RF_Transient);
+
+	CompositeEffect->Combine(Effects);
+
+	return CompositeEffect;
+}
+
+void UPF2CompositeGameplayEffect::Combine(const TArray<TSubclassOf<UGameplayEffect>>& Effects)
+{
+	this->SourceEffects  = Effects;
+	this->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	for (const TSubclassOf<UGameplayEffect>& Effect : Effects)
+	{
+		const UGameplayEffect* EffectCdo = Effect.GetDefaultObject();
+
+		this->Modifiers.Append(EffectCdo->Modifiers);
+
+		for (const FGameplayTag& AssetTag : EffectCdo->InheritableGameplayEffectTags.CombinedTags)
+		{
+			this->InheritableGameplayEffectTags.AddTag(AssetTag);
+		}
+
+		for (const FGameplayTag& GrantedTag : EffectCdo->InheritableOwnedTagsContainer.CombinedTags)
+		{
+			this->InheritableOwnedTagsContainer.AddTag(GrantedTag);
+		}
+	}
+}
@@ -0,0 +1,77 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2CompositeGameplayEffectSubsystem.h"
+
+#include <Engine/GameInstance.h>
+#include <Engine/World.h>
+
+UPF2CompositeGameplayEffectSubsystem* UPF2CompositeGameplayEffectSubsystem::Get(const UWorld* World)
+{
+	const UGameInstance* GameInstance;
+
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+
+	GameInstance = World->GetGameInstance();
+
+	if (GameInstance == nullptr)
+	{
+		return nullptr;
+	}
+	else
+	{
+		return GameInstance->GetSubsystem<UPF2CompositeGameplayEffectSubsystem>();
+	}
+}
+
+void UPF2CompositeGameplayEffectSubsystem::Deinitialize()
+{
+	this->CompositeEffects.Empty();
+
+	Super::Deinitialize();
+}
+
+const UPF2CompositeGameplayEffect* UPF2CompositeGameplayEffectSubsystem::FindOrCreate(
+	const TArray<TSubclassOf<UGameplayEffect>>& Effects)
+{
+	FString                      EffectPaths;
+	uint32                       NameHash;
+	UPF2CompositeGameplayEffect* CompositeEffect;
+
+	for (const TSubclassOf<UGameplayEffect>& Effect : Effects)
+	{
+		EffectPaths.Append(Effect->GetPathName());
+		EffectPaths.AppendChar(TEXT(';'));
+	}
+
+	NameHash = FCrc::StrCrc32(*EffectPaths);
+
+	// The name is derived from the combined GEs so that combining the same GEs again finds the same composite GE. In
+	// the unlikely event of a hash collision, the next available suffix is used.
+	for (int32 NameSuffix = 0; ; ++NameSuffix)
+	{
+		const FName                   ObjectName     =
+			FName(*FString::Printf(TEXT("PF2CompositeGE_%08X"), NameHash), NameSuffix);
+		UPF2CompositeGameplayEffect** ExistingEffect = this->CompositeEffects.Find(ObjectName);
+
+		if (ExistingEffect == nullptr)
+		{
+			CompositeEffect = UPF2CompositeGameplayEffect::Create(this, ObjectName, Effects);
+
+			this->CompositeEffects.Add(ObjectName, CompositeEffect);
+			break;
+		}
+		else if ((*ExistingEffect)->GetSourceEffects() == Effects)
+		{
+			CompositeEffect = *ExistingEffect;
+			break;
+		}
+	}
+
+	return CompositeEffect;
+}
@@ -0,0 +1,140 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2DamageTypeTable.h"
+
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+const FPF2DamageTypeDefenses& FPF2DamageTypeTable::GetDefenses(const int32 DamageTypeOrdinal) const
+{
+	static const FPF2DamageTypeDefenses NoDefenses;
+
+	if (this->DefensesByOrdinal.IsValidIndex(DamageTypeOrdinal))
+	{
+		return this->DefensesByOrdinal[DamageTypeOrdinal];
+	}
+	else
+	{
+		return NoDefenses;
+	}
+}
+
+const FPF2DamageTypeDefenses& FPF2DamageTypeTable::GetDefensesForDamageType(const FGameplayTag DamageType) const
+{
+	return this->GetDefenses(PF2GameplayAbilityUtilities::GetDamageTypeOrdinal(DamageType));
+}
+
+bool FPF2DamageTypeTable::SetResistance(const FGameplayTag DamageType, const float Resistance)
+{
+	return this->UpdateDefenses(DamageType, [Resistance](FPF2DamageTypeDefenses& Defenses)
+	{
+		Defenses.Resistance = Resistance;
+	});
+}
+
+bool FPF2DamageTypeTable::SetWeakness(const FGameplayTag DamageType, const float Weakness)
+{
+	return this->UpdateDefenses(DamageType, [Weakness](FPF2DamageTypeDefenses& Defenses)
+	{
+		Defenses.Weakness = Weakness;
+	});
+}
+
+bool FPF2DamageTypeTable::SetImmunity(const FGameplayTag DamageType, const bool bIsImmune)
+{
+	return this->UpdateDefenses(DamageType, [bIsImmune](FPF2DamageTypeDefenses& Defenses)
+	{
+		Defenses.bIsImmune = bIsImmune;
+	});
+}
+
+void FPF2DamageTypeTable::PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+{
+	for (const int32 EntryIndex : RemovedIndices)
+	{
+		const uint8 DamageTypeOrdinal = this->Entries[EntryIndex].DamageTypeOrdinal;
+
+		if (this->DefensesByOrdinal.IsValidIndex(DamageTypeOrdinal))
+		{
+			this->DefensesByOrdinal[DamageTypeOrdinal] = FPF2DamageTypeDefenses();
+		}
+	}
+}
+
+void FPF2DamageTypeTable::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	for (const int32 EntryIndex : AddedIndices)
+	{
+		this->RefreshDefenses(this->Entries[EntryIndex]);
+	}
+}
+
+void FPF2DamageTypeTable::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+{
+	for (const int32 EntryIndex : ChangedIndices)
+	{
+		this->RefreshDefenses(this->Entries[EntryIndex]);
+	}
+}
+
+bool FPF2DamageTypeTable::UpdateDefenses(const FGameplayTag                                 DamageType,
+                                         const TFunctionRef<void (FPF2DamageTypeDefenses&)> Update)
+{
+	const TArray<FGameplayTag>& DamageTypeTags = PF2GameplayAbilityUtilities::GetDamageTypeTags();
+	bool                        bWasChanged    = false;
+
+	for (int32 DamageTypeOrdinal = 0; DamageTypeOrdinal < DamageTypeTags.Num(); ++DamageTypeOrdinal)
+	{
+		FPF2DamageTypeTableEntry* Entry;
+		FPF2DamageTypeDefenses    NewDefenses;
+
+		// Matches the damage type itself, plus every damage type in it when it is a category.
+		if (!DamageTypeTags[DamageTypeOrdinal].MatchesTag(DamageType))
+		{
+			continue;
+		}
+
+		NewDefenses = this->GetDefenses(DamageTypeOrdinal);
+		Update(NewDefenses);
+
+		if (NewDefenses == this->GetDefenses(DamageTypeOrdinal))
+		{
+			continue;
+		}
+
+		Entry = this->Entries.FindByPredicate([DamageTypeOrdinal](const FPF2DamageTypeTableEntry& Candidate)
+		{
+			return Candidate.DamageTypeOrdinal == DamageTypeOrdinal;
+		});
+
+		if (Entry == nullptr)
+		{
+			Entry = &this->Entries.Emplace_GetRef(static_cast<uint8>(DamageTypeOrdinal));
+		}
+
+		Entry->Defenses = NewDefenses;
+
+		this->MarkItemDirty(*Entry);
+		this->RefreshDefenses(*Entry);
+
+		bWasChanged = true;
+	}
+
+	return bWasChanged;
+}
+
+void FPF2DamageTypeTable::RefreshDefenses(const FPF2DamageTypeTableEntry& Entry)
+{
+	if (!this->DefensesByOrdinal.IsValidIndex(Entry.DamageTypeOrdinal))
+	{
+		this->DefensesByOrdinal.SetNum(PF2GameplayAbilityUtilities::GetDamageTypeTags().Num());
+	}
+
+	// Guard against a server that has more damage types in its tag configuration than this machine does.
+	if (ensure(this->DefensesByOrdinal.IsValidIndex(Entry.DamageTypeOrdinal)))
+	{
+		this->DefensesByOrdinal[Entry.DamageTypeOrdinal] = Entry.Defenses;
+	}
+}
@@ -0,0 +1,442 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2DerivedStatistics.h"
+
+#include <HAL/IConsoleManager.h>
+#include <Misc/Crc.h>
+
+#include "Abilities/PF2AbilitySystemComponent.h"
+#include "Abilities/PF2AttributeSet.h"
+#include "Calculations/PF2ArmorClassCalculation.h"
+#include "Calculations/PF2CalculationDependencyInterface.h"
+#include "Calculations/PF2ClassDifficultyClassCalculation.h"
+#include "Calculations/PF2TemlCalculation.h"
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+static TAutoConsoleVariable<bool> CVarDeriveStatisticsOnClients(
+	TEXT("OpenPF2.DeriveStatisticsOnClients"),
+	false,
+	TEXT("Whether clients derive AC, saves, Perception, class DC, and skills locally instead of receiving them from ")
+	TEXT("the server. Must have the same value on the server and all clients."),
+	ECVF_ReadOnly
+);
+
+/**
+ * The calculation that derives a statistic.
+ */
+enum class EPF2DerivedStatisticCalculation : uint8
+{
+	/**
+	 * An ability modifier plus a TEML proficiency bonus (see UPF2SimpleTemlModifierCalculationBase).
+	 */
+	TemlModifier,
+
+	/**
+	 * Armor Class (see UPF2ArmorClassCalculation).
+	 */
+	ArmorClass,
+
+	/**
+	 * Class DC (see UPF2ClassDifficultyClassCalculation).
+	 */
+	ClassDifficultyClass,
+};
+
+/**
+ * The definition of a single derived statistic.
+ */
+struct FPF2DerivedStatisticDefinition
+{
+	/**
+	 * The attribute that holds the statistic.
+	 */
+	FGameplayAttribute Attribute;
+
+	/**
+	 * The calculation that derives the statistic.
+	 */
+	EPF2DerivedStatisticCalculation Calculation;
+
+	/**
+	 * For TEML modifiers, the attribute of the ability modifier on which the statistic is based.
+	 */
+	FGameplayAttribute AbilityModifierAttribute;
+
+	/**
+	 * For TEML modifiers, the root tag of the TEML proficiency tags of the statistic.
+	 */
+	FGameplayTag ProficiencyRootTag;
+};
+
+/**
+ * Gets the definitions of all derived statistics, in the order of FPF2DerivedStatistics::GetAttributes().
+ *
+ * @return
+ *	The definition of each derived statistic.
+ */
+static const TArray<FPF2DerivedStatisticDefinition>& GetDerivedStatisticDefinitions()
+{
+	static const TArray<FPF2DerivedStatisticDefinition> Definitions = []
+	{
+		TArray<FPF2DerivedStatisticDefinition> Result;
+
+		const auto AddTemlModifier = [&Result](const FGameplayAttribute Attribute,
+		                                       const FGameplayAttribute AbilityModifierAttribute,
+		                                       const FName              ProficiencyRootTagName)
+		{
+			Result.Add({
+				Attribute,
+				EPF2DerivedStatisticCalculation::TemlModifier,
+				AbilityModifierAttribute,
+				PF2GameplayAbilityUtilities::GetTag(ProficiencyRootTagName)
+			});
+		};
+
+		Result.Add({UPF2AttributeSet::GetArmorClassAttribute(), EPF2DerivedStatisticCalculation::ArmorClass});
+
+		Result.Add({
+			UPF2AttributeSet::GetClassDifficultyClassAttribute(),
+			EPF2DerivedStatisticCalculation::ClassDifficultyClass
+		});
+
+		// Each saving throw, Perception, and each skill is based on the ability that the Pathfinder 2E Core Rulebook
+		// lists for it.
+		AddTemlModifier(
+			UPF2AttributeSet::GetStFortitudeModifierAttribute(),
+			UPF2AttributeSet::GetAbConstitutionModifierAttribute(),
+			FName("SavingThrow.Fortitude")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetStReflexModifierAttribute(),
+			UPF2AttributeSet::GetAbDexterityModifierAttribute(),
+			FName("SavingThrow.Reflex")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetStWillModifierAttribute(),
+			UPF2AttributeSet::GetAbWisdomModifierAttribute(),
+			FName("SavingThrow.Will")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetPerceptionModifierAttribute(),
+			UPF2AttributeSet::GetAbWisdomModifierAttribute(),
+			FName("Perception")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkAcrobaticsModifierAttribute(),
+			UPF2AttributeSet::GetAbDexterityModifierAttribute(),
+			FName("Skill.Acrobatics")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkArcanaModifierAttribute(),
+			UPF2AttributeSet::GetAbIntelligenceModifierAttribute(),
+			FName("Skill.Arcana")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkAthleticsModifierAttribute(),
+			UPF2AttributeSet::GetAbStrengthModifierAttribute(),
+			FName("Skill.Athletics")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkCraftingModifierAttribute(),
+			UPF2AttributeSet::GetAbIntelligenceModifierAttribute(),
+			FName("Skill.Crafting")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkDeceptionModifierAttribute(),
+			UPF2AttributeSet::GetAbCharismaModifierAttribute(),
+			FName("Skill.Deception")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkDiplomacyModifierAttribute(),
+			UPF2AttributeSet::GetAbCharismaModifierAttribute(),
+			FName("Skill.Diplomacy")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkIntimidationModifierAttribute(),
+			UPF2AttributeSet::GetAbCharismaModifierAttribute(),
+			FName("Skill.Intimidation")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkLore1ModifierAttribute(),
+			UPF2AttributeSet::GetAbIntelligenceModifierAttribute(),
+			FName("Skill.Lore1")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkLore2ModifierAttribute(),
+			UPF2AttributeSet::GetAbIntelligenceModifierAttribute(),
+			FName("Skill.Lore2")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkMedicineModifierAttribute(),
+			UPF2AttributeSet::GetAbWisdomModifierAttribute(),
+			FName("Skill.Medicine")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkNatureModifierAttribute(),
+			UPF2AttributeSet::GetAbWisdomModifierAttribute(),
+			FName("Skill.Nature")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkOccultismModifierAttribute(),
+			UPF2AttributeSet::GetAbIntelligenceModifierAttribute(),
+			FName("Skill.Occultism")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkPerformanceModifierAttribute(),
+			UPF2AttributeSet::GetAbCharismaModifierAttribute(),
+			FName("Skill.Performance")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkReligionModifierAttribute(),
+			UPF2AttributeSet::GetAbWisdomModifierAttribute(),
+			FName("Skill.Religion")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkSocietyModifierAttribute(),
+			UPF2AttributeSet::GetAbIntelligenceModifierAttribute(),
+			FName("Skill.Society")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkStealthModifierAttribute(),
+			UPF2AttributeSet::GetAbDexterityModifierAttribute(),
+			FName("Skill.Stealth")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkSurvivalModifierAttribute(),
+			UPF2AttributeSet::GetAbWisdomModifierAttribute(),
+			FName("Skill.Survival")
+		);
+
+		AddTemlModifier(
+			UPF2AttributeSet::GetSkThieveryModifierAttribute(),
+			UPF2AttributeSet::GetAbDexterityModifierAttribute(),
+			FName("Skill.Thievery")
+		);
+
+		return Result;
+	}();
+
+	return Definitions;
+}
+
+FPF2DerivedStatisticInputs::FPF2DerivedStatisticInputs(
+	const UPF2AttributeSet&      AttributeSet,
+	const FGameplayTagContainer& CharacterTags,
+	const float                  CharacterLevel) :
+	CharacterTags(CharacterTags),
+	CharacterLevel(CharacterLevel)
+{
+	const TArray<FGameplayAttribute>& Attributes = FPF2DerivedStatistics::GetAbilityModifierAttributes();
+
+	this->AbilityModifiers.Reserve(Attributes.Num());
+
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		this->AbilityModifiers.Add(Attribute.GetNumericValue(&AttributeSet));
+	}
+}
+
+float FPF2DerivedStatisticInputs::GetAbilityModifier(const FGameplayAttribute& Attribute) const
+{
+	const int32 AttributeIndex = FPF2DerivedStatistics::GetAbilityModifierAttributes().IndexOfByKey(Attribute);
+
+	if (!this->AbilityModifiers.IsValidIndex(AttributeIndex))
+	{
+		return 0.0f;
+	}
+
+	return this->AbilityModifiers[AttributeIndex];
+}
+
+bool FPF2DerivedStatistics::IsEnabled()
+{
+	return CVarDeriveStatisticsOnClients.GetValueOnAnyThread();
+}
+
+const TArray<FGameplayAttribute>& FPF2DerivedStatistics::GetAttributes()
+{
+	static const TArray<FGameplayAttribute> Attributes = []
+	{
+		TArray<FGameplayAttribute> Result;
+
+		for (const FPF2DerivedStatisticDefinition& Definition : GetDerivedStatisticDefinitions())
+		{
+			Result.Add(Definition.Attribute);
+		}
+
+		// Overrides identify each statistic by a single byte.
+		check(Result.Num() <= MAX_uint8);
+
+		return Result;
+	}();
+
+	return Attributes;
+}
+
+const TArray<FGameplayAttribute>& FPF2DerivedStatistics::GetAbilityModifierAttributes()
+{
+	static const TArray<FGameplayAttribute> Attributes = {
+		UPF2AttributeSet::GetAbStrengthModifierAttribute(),
+		UPF2AttributeSet::GetAbDexterityModifierAttribute(),
+		UPF2AttributeSet::GetAbConstitutionModifierAttribute(),
+		UPF2AttributeSet::GetAbIntelligenceModifierAttribute(),
+		UPF2AttributeSet::GetAbWisdomModifierAttribute(),
+		UPF2AttributeSet::GetAbCharismaModifierAttribute(),
+	};
+
+	return Attributes;
+}
+
+int32 FPF2DerivedStatistics::IndexOf(const FGameplayAttribute& Attribute)
+{
+	return GetAttributes().IndexOfByKey(Attribute);
+}
+
+int32 FPF2DerivedStatistics::IndexOfTemlModifier(
+	const FGameplayTag&       ProficiencyRootTag,
+	const FGameplayAttribute& AbilityModifierAttribute)
+{
+	return GetDerivedStatisticDefinitions().IndexOfByPredicate(
+		[&ProficiencyRootTag, &AbilityModifierAttribute](const FPF2DerivedStatisticDefinition& Definition)
+		{
+			return (Definition.Calculation == EPF2DerivedStatisticCalculation::TemlModifier) &&
+			       (Definition.ProficiencyRootTag == ProficiencyRootTag) &&
+			       (Definition.AbilityModifierAttribute == AbilityModifierAttribute);
+		});
+}
+
+void FPF2DerivedStatistics::Calculate(
+	const UPF2AttributeSet&      AttributeSet,
+	const FGameplayTagContainer& CharacterTags,
+	const float                  CharacterLevel,
+	TArray<float>&               OutValues)
+{
+	FPF2PrecalculatedDerivedStatistics Statistics;
+
+	Calculate(FPF2DerivedStatisticInputs(AttributeSet, CharacterTags, CharacterLevel), Statistics);
+
+	OutValues = MoveTemp(Statistics.Values);
+}
+
+void FPF2DerivedStatistics::Calculate(
+	const FPF2DerivedStatisticInputs&   Inputs,
+	FPF2PrecalculatedDerivedStatistics& OutStatistics)
+{
+	const TArray<FPF2DerivedStatisticDefinition>& Definitions    = GetDerivedStatisticDefinitions();
+	const FGameplayTagContainer&                  CharacterTags  = Inputs.CharacterTags;
+	const float                                   CharacterLevel = Inputs.CharacterLevel;
+
+	OutStatistics.CharacterLevel = CharacterLevel;
+
+	OutStatistics.Values.Reset(Definitions.Num());
+	OutStatistics.AbilityModifiers.Reset(Definitions.Num());
+
+	for (const FPF2DerivedStatisticDefinition& Definition : Definitions)
+	{
+		float Value           = 0.0f,
+		      AbilityModifier = 0.0f;
+
+		switch (Definition.Calculation)
+		{
+			case EPF2DerivedStatisticCalculation::TemlModifier:
+				// Equivalent to UPF2SimpleTemlModifierCalculationBase::DoCalculation().
+				AbilityModifier = Inputs.GetAbilityModifier(Definition.AbilityModifierAttribute);
+
+				Value =
+					AbilityModifier +
+					FPF2TemlCalculation(Definition.ProficiencyRootTag, &CharacterTags, CharacterLevel).GetValue();
+				break;
+
+			case EPF2DerivedStatisticCalculation::ArmorClass:
+				AbilityModifier = Inputs.GetAbilityModifier(UPF2AttributeSet::GetAbDexterityModifierAttribute());
+
+				Value = GetDefault<UPF2ArmorClassCalculation>()->CalculateArmorClass(
+					AbilityModifier,
+					&CharacterTags,
+					CharacterLevel
+				);
+				break;
+
+			case EPF2DerivedStatisticCalculation::ClassDifficultyClass:
+				Value = GetDefault<UPF2ClassDifficultyClassCalculation>()->CalculateFromAbilityModifiers(
+					[&Inputs](const FGameplayAttribute& Attribute)
+					{
+						return Inputs.GetAbilityModifier(Attribute);
+					},
+					&CharacterTags,
+					CharacterLevel,
+					AbilityModifier
+				);
+				break;
+		}
+
+		OutStatistics.Values.Add(Value);
+		OutStatistics.AbilityModifiers.Add(AbilityModifier);
+	}
+}
+
+bool FPF2DerivedStatistics::FindPrecalculatedValue(
+	const FGameplayEffectSpec&                Spec,
+	const int32                               StatisticIndex,
+	const float                               AbilityModifier,
+	const IPF2CalculationDependencyInterface& Calculation,
+	float&                                    OutValue)
+{
+	const UPF2AbilitySystemComponent* Asc =
+		Cast<UPF2AbilitySystemComponent>(Spec.GetContext().GetInstigatorAbilitySystemComponent());
+
+	if (Asc == nullptr)
+	{
+		return false;
+	}
+
+	const FPF2PrecalculatedDerivedStatistics& Statistics = Asc->GetPrecalculatedDerivedStatistics();
+
+	if (!Statistics.Values.IsValidIndex(StatisticIndex) ||
+	    (Statistics.CharacterLevel != Spec.GetLevel()) ||
+	    (Statistics.AbilityModifiers[StatisticIndex] != AbilityModifier))
+	{
+		return false;
+	}
+
+	const FGameplayTagContainer& SpecTags = Spec.CapturedSourceTags.GetSpecTags();
+
+	// Statistics are precalculated from the tags of the character, which do not include the tags that a GE adds to its
+	// own spec.
+	if (!SpecTags.IsEmpty() && SpecTags.HasAny(Calculation.GetSourceTagDependencies()))
+	{
+		return false;
+	}
+
+	OutValue = Statistics.Values[StatisticIndex];
+
+	return true;
+}
+
+uint32 FPF2DerivedStatistics::CalculateChecksum(const TArray<float>& Values)
+{
+	return FCrc::MemCrc32(Values.GetData(), Values.Num() * sizeof(float));
+}
@@ -0,0 +1,372 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2PassiveEffectDependencyGraph.h"
+
+#include <GameplayModMagnitudeCalculation.h>
+
+#include "PF2CharacterConstants.h"
+
+#include "Calculations/PF2CalculationDependencyInterface.h"
+
+FPF2PassiveEffectDependencyGraph::FNode::FNode(const TSubclassOf<UGameplayEffect> Effect) :
+	Effect(Effect),
+	bReadsAllTags(false),
+	bReadsLevel(false),
+	bGrantsAbilities(false)
+{
+	const UGameplayEffect* EffectCdo = Effect.GetDefaultObject();
+
+	this->TagsRead.AppendTags(EffectCdo->ApplicationTagRequirements.RequireTags);
+	this->TagsRead.AppendTags(EffectCdo->ApplicationTagRequirements.IgnoreTags);
+
+	this->TagsWritten.AppendTags(EffectCdo->InheritableOwnedTagsContainer.CombinedTags);
+
+	for (const FGameplayModifierInfo& Modifier : EffectCdo->Modifiers)
+	{
+		const FGameplayEffectModifierMagnitude& Magnitude = Modifier.ModifierMagnitude;
+		TArray<FGameplayEffectAttributeCaptureDefinition> CaptureDefinitions;
+
+		this->AttributesWritten.AddUnique(Modifier.Attribute);
+
+		this->TagsRead.AppendTags(Modifier.SourceTags.RequireTags);
+		this->TagsRead.AppendTags(Modifier.SourceTags.IgnoreTags);
+		this->TagsRead.AppendTags(Modifier.TargetTags.RequireTags);
+		this->TagsRead.AppendTags(Modifier.TargetTags.IgnoreTags);
+
+		if (IsMagnitudeLevelDependent(Magnitude))
+		{
+			this->bReadsLevel = true;
+		}
+
+		Magnitude.GetAttributeCaptureDefinitions(CaptureDefinitions);
+
+		for (const FGameplayEffectAttributeCaptureDefinition& CaptureDefinition : CaptureDefinitions)
+		{
+			if (CaptureDefinition.bSnapshot)
+			{
+				this->AttributesRead.AddUnique(CaptureDefinition.AttributeToCapture);
+			}
+		}
+
+		if (Magnitude.GetMagnitudeCalculationType() == EGameplayEffectMagnitudeCalculation::CustomCalculationClass)
+		{
+			const TSubclassOf<UGameplayModMagnitudeCalculation> CalculationType =
+				Magnitude.GetCustomMagnitudeCalculationClass();
+
+			const IPF2CalculationDependencyInterface* Calculation =
+				Cast<IPF2CalculationDependencyInterface>(CalculationType.GetDefaultObject());
+
+			if (Calculation == nullptr)
+			{
+				// We have no way to know what tags an MMC outside OpenPF2 reads, so we have to assume it reads them all.
+				this->bReadsAllTags = true;
+			}
+			else
+			{
+				this->TagsRead.AppendTags(Calculation->GetSourceTagDependencies());
+			}
+		}
+	}
+
+	// Executions capture the tags of the source when the spec is created, but they don't describe which tags they use
+	// or whether they use the level.
+	if (EffectCdo->Executions.Num() != 0)
+	{
+		this->bReadsAllTags = true;
+		this->bReadsLevel   = true;
+	}
+
+	if (EffectCdo->GrantedAbilities.Num() != 0)
+	{
+		this->bReadsLevel      = true;
+		this->bGrantsAbilities = true;
+	}
+}
+
+bool FPF2PassiveEffectDependencyGraph::FNode::ReadsAnyTag(const FGameplayTagContainer& Tags) const
+{
+	if (Tags.IsEmpty())
+	{
+		return false;
+	}
+	else if (this->bReadsAllTags)
+	{
+		return true;
+	}
+	else
+	{
+		for (const FGameplayTag& Tag : Tags)
+		{
+			// A tag matches a root tag the GE reads if it is that root tag or any of its children.
+			if (Tag.MatchesAny(this->TagsRead))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+bool FPF2PassiveEffectDependencyGraph::FNode::DependsOn(const FNode& Other) const
+{
+	if (this->ReadsAnyTag(Other.TagsWritten))
+	{
+		return true;
+	}
+
+	for (const FGameplayAttribute& Attribute : this->AttributesRead)
+	{
+		if (Other.AttributesWritten.Contains(Attribute))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FPF2PassiveEffectDependencyGraph::FNode::IsMagnitudeLevelDependent(
+	const FGameplayEffectModifierMagnitude& Magnitude)
+{
+	switch (Magnitude.GetMagnitudeCalculationType())
+	{
+		case EGameplayEffectMagnitudeCalculation::ScalableFloat:
+		{
+			float FirstLevelMagnitude;
+
+			Magnitude.GetStaticMagnitudeIfPossible(1, FirstLevelMagnitude);
+
+			// A scalable float only varies with level if it is backed by a curve that has different values at
+			// different levels, so compare its value at every level a character can be.
+			for (int32 Level = 2; Level <= PF2CharacterConstants::MaxCharacterLevel; ++Level)
+			{
+				float LevelMagnitude;
+
+				Magnitude.GetStaticMagnitudeIfPossible(Level, LevelMagnitude);
+
+				if (LevelMagnitude != FirstLevelMagnitude)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		case EGameplayEffectMagnitudeCalculation::CustomCalculationClass:
+		{
+			const TSubclassOf<UGameplayModMagnitudeCalculation> CalculationType =
+				Magnitude.GetCustomMagnitudeCalculationClass();
+
+			const IPF2CalculationDependencyInterface* Calculation =
+				Cast<IPF2CalculationDependencyInterface>(CalculationType.GetDefaultObject());
+
+			// We have no way to know whether an MMC outside OpenPF2 uses the level, so we have to assume it does.
+			return (Calculation == nullptr) || Calculation->IsLevelDependent();
+		}
+
+		case EGameplayEffectMagnitudeCalculation::SetByCaller:
+			return false;
+
+		default:
+			// Attribute-based magnitudes have coefficients that may be scaled by level.
+			return true;
+	}
+}
+
+FPF2PassiveEffectDependencyGraph::FPF2PassiveEffectDependencyGraph(
+	const TArray<TSubclassOf<UGameplayEffect>>& Effects)
+{
+	TSet<TSubclassOf<UGameplayEffect>> SeenEffects;
+
+	for (const TSubclassOf<UGameplayEffect>& Effect : Effects)
+	{
+		if ((Effect != nullptr) && !SeenEffects.Contains(Effect))
+		{
+			SeenEffects.Add(Effect);
+			this->NodeIndices.Add(Effect, this->Nodes.Emplace(Effect));
+		}
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < this->Nodes.Num(); ++NodeIndex)
+	{
+		FNode& Node = this->Nodes[NodeIndex];
+
+		for (int32 OtherIndex = 0; OtherIndex < this->Nodes.Num(); ++OtherIndex)
+		{
+			if ((NodeIndex != OtherIndex) && this->Nodes[OtherIndex].DependsOn(Node))
+			{
+				Node.Dependents.Add(OtherIndex);
+			}
+		}
+	}
+}
+
+TSet<TSubclassOf<UGameplayEffect>> FPF2PassiveEffectDependencyGraph::GetEffectsAffectedByTags(
+	const FGameplayTagContainer& ChangedTags) const
+{
+	TArray<int32> StartNodes;
+
+	for (int32 NodeIndex = 0; NodeIndex < this->Nodes.Num(); ++NodeIndex)
+	{
+		if (this->Nodes[NodeIndex].ReadsAnyTag(ChangedTags))
+		{
+			StartNodes.Add(NodeIndex);
+		}
+	}
+
+	return this->GetDownstreamEffects(StartNodes, true);
+}
+
+TSet<TSubclassOf<UGameplayEffect>> FPF2PassiveEffectDependencyGraph::GetEffectsDependentOn(
+	const TSet<TSubclassOf<UGameplayEffect>>& Effects) const
+{
+	TArray<int32> StartNodes;
+
+	for (const TSubclassOf<UGameplayEffect>& Effect : Effects)
+	{
+		const int32* NodeIndex = this->NodeIndices.Find(Effect);
+
+		if (NodeIndex != nullptr)
+		{
+			StartNodes.Add(*NodeIndex);
+		}
+	}
+
+	return this->GetDownstreamEffects(StartNodes, false);
+}
+
+TSet<TSubclassOf<UGameplayEffect>> FPF2PassiveEffectDependencyGraph::GetDownstreamEffects(
+	const TArray<int32>& StartNodes,
+	const bool           bIncludeStartNodes) const
+{
+	TSet<TSubclassOf<UGameplayEffect>> AffectedEffects;
+	TArray<int32>                      PendingNodes;
+	TBitArray<>                        VisitedNodes(false, this->Nodes.Num());
+
+	for (const int32 StartIndex : StartNodes)
+	{
+		if (bIncludeStartNodes)
+		{
+			if (!VisitedNodes[StartIndex])
+			{
+				VisitedNodes[StartIndex] = true;
+				PendingNodes.Push(StartIndex);
+			}
+		}
+		else
+		{
+			for (const int32 DependentIndex : this->Nodes[StartIndex].Dependents)
+			{
+				if (!VisitedNodes[DependentIndex])
+				{
+					VisitedNodes[DependentIndex] = true;
+					PendingNodes.Push(DependentIndex);
+				}
+			}
+		}
+	}
+
+	// Walk downstream so that GEs which depend on the output of an affected GE are also re-applied.
+	while (PendingNodes.Num() != 0)
+	{
+		const FNode& Node = this->Nodes[PendingNodes.Pop(false)];
+
+		AffectedEffects.Add(Node.Effect);
+
+		for (const int32 DependentIndex : Node.Dependents)
+		{
+			if (!VisitedNodes[DependentIndex])
+			{
+				VisitedNodes[DependentIndex] = true;
+				PendingNodes.Push(DependentIndex);
+			}
+		}
+	}
+
+	return AffectedEffects;
+}
+
+bool FPF2PassiveEffectDependencyGraph::DoesEffectReadAnyTag(
+	const TSubclassOf<UGameplayEffect> Effect,
+	const FGameplayTagContainer&       Tags) const
+{
+	const int32* NodeIndex = this->NodeIndices.Find(Effect);
+
+	if (NodeIndex == nullptr)
+	{
+		// We know nothing about this GE, so we have to assume the worst.
+		return true;
+	}
+	else
+	{
+		return this->Nodes[*NodeIndex].ReadsAnyTag(Tags);
+	}
+}
+
+bool FPF2PassiveEffectDependencyGraph::DoesEffectReadSnapshotAttributes(
+	const TSubclassOf<UGameplayEffect> Effect) const
+{
+	const int32* NodeIndex = this->NodeIndices.Find(Effect);
+
+	return (NodeIndex == nullptr) || (this->Nodes[*NodeIndex].AttributesRead.Num() != 0);
+}
+
+bool FPF2PassiveEffectDependencyGraph::DoesEffectReadLevel(const TSubclassOf<UGameplayEffect> Effect) const
+{
+	const int32* NodeIndex = this->NodeIndices.Find(Effect);
+
+	return (NodeIndex == nullptr) || this->Nodes[*NodeIndex].bReadsLevel;
+}
+
+bool FPF2PassiveEffectDependencyGraph::DoesEffectDependOn(
+	const TSubclassOf<UGameplayEffect> Effect,
+	const TSubclassOf<UGameplayEffect> OtherEffect) const
+{
+	const int32 *NodeIndex      = this->NodeIndices.Find(Effect),
+	            *OtherNodeIndex = this->NodeIndices.Find(OtherEffect);
+
+	if ((NodeIndex == nullptr) || (OtherNodeIndex == nullptr))
+	{
+		// We know nothing about at least one of the GEs, so we have to assume the worst.
+		return true;
+	}
+	else
+	{
+		return this->Nodes[*OtherNodeIndex].Dependents.Contains(*NodeIndex);
+	}
+}
+
+TSet<TSubclassOf<UGameplayEffect>> FPF2PassiveEffectDependencyGraph::GetEffectsToReapplyOnLevelChange() const
+{
+	TArray<int32>                      LevelNodes;
+	TSet<TSubclassOf<UGameplayEffect>> AffectedEffects;
+
+	for (int32 NodeIndex = 0; NodeIndex < this->Nodes.Num(); ++NodeIndex)
+	{
+		if (this->Nodes[NodeIndex].bReadsLevel)
+		{
+			LevelNodes.Add(NodeIndex);
+		}
+	}
+
+	// Updating the level of a GE in place does not update GEs that took a snapshot of its output, so GEs downstream
+	// of it still have to be re-applied.
+	AffectedEffects = this->GetDownstreamEffects(LevelNodes, false);
+
+	for (const int32 NodeIndex : LevelNodes)
+	{
+		const FNode& Node = this->Nodes[NodeIndex];
+
+		if (Node.bGrantsAbilities)
+		{
+			AffectedEffects.Add(Node.Effect);
+		}
+	}
+
+	return AffectedEffects;
+}
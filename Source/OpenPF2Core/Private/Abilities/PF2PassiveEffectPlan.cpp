@@ -0,0 +1,180 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2PassiveEffectPlan.h"
+
+#include "Abilities/PF2CompositeGameplayEffect.h"
+#include "Abilities/PF2CompositeGameplayEffectSubsystem.h"
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+bool FPF2PassiveEffectPlanEntry::ContainsAnyEffect(const TSet<TSubclassOf<UGameplayEffect>>& OtherEffects) const
+{
+	for (const TSubclassOf<UGameplayEffect>& Effect : this->Effects)
+	{
+		if (OtherEffects.Contains(Effect))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FPF2PassiveEffectPlan::FPF2PassiveEffectPlan(
+	const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& Effects,
+	const TSet<TSubclassOf<UGameplayEffect>>&             StackableEffects,
+	UPF2CompositeGameplayEffectSubsystem*                 CompositeEffects)
+{
+	TArray<TSubclassOf<UGameplayEffect>>                    AllEffects;
+	TMap<TPair<FName, TSubclassOf<UGameplayEffect>>, int32> StackableEntryIndices;
+
+	this->Entries.Reserve(Effects.Num());
+	AllEffects.Reserve(Effects.Num());
+
+	for (const auto& EffectInfo : Effects)
+	{
+		const FName                        WeightGroup = EffectInfo.Key;
+		const TSubclassOf<UGameplayEffect> Effect      = EffectInfo.Value;
+
+		if (StackableEffects.Contains(Effect))
+		{
+			const TPair<FName, TSubclassOf<UGameplayEffect>> EntryKey(WeightGroup, Effect);
+			const int32*                                     EntryIndex = StackableEntryIndices.Find(EntryKey);
+
+			if (EntryIndex != nullptr)
+			{
+				// Fold repeat additions of a stackable GE into the entry for its first addition.
+				++this->Entries[*EntryIndex].Count;
+				continue;
+			}
+
+			StackableEntryIndices.Add(EntryKey, this->Entries.Num());
+		}
+
+		this->Entries.Add({
+			WeightGroup,
+			PF2GameplayAbilityUtilities::GetWeightGroupOrdinal(WeightGroup),
+			{Effect},
+			Effect.GetDefaultObject(),
+			1
+		});
+
+		AllEffects.Add(EffectInfo.Value);
+	}
+
+	// Ensure Passive GEs are always evaluated in weight order. The sort is stable so that GEs within the same weight
+	// group are applied in the order they were added. Distinct groups that share the same ordinal are kept apart
+	// by name so that each group still ends up with a single, contiguous span.
+	this->Entries.StableSort([](const FPF2PassiveEffectPlanEntry& A, const FPF2PassiveEffectPlanEntry& B)
+	{
+		return PF2GameplayAbilityUtilities::IsWeightGroupBefore(
+			A.WeightGroup,
+			A.WeightGroupOrdinal,
+			B.WeightGroup,
+			B.WeightGroupOrdinal
+		);
+	});
+
+	this->DependencyGraph = FPF2PassiveEffectDependencyGraph(AllEffects);
+
+	if (CompositeEffects != nullptr)
+	{
+		this->CombineEntries(StackableEffects, *CompositeEffects);
+	}
+
+	for (int32 EntryIndex = 0; EntryIndex < this->Entries.Num(); ++EntryIndex)
+	{
+		const FPF2PassiveEffectPlanEntry& Entry = this->Entries[EntryIndex];
+
+		if ((this->WeightGroupSpans.Num() == 0) || (this->WeightGroupSpans.Last().WeightGroup != Entry.WeightGroup))
+		{
+			this->WeightGroupSpans.Add({Entry.WeightGroup, Entry.WeightGroupOrdinal, EntryIndex, 0});
+		}
+
+		++this->WeightGroupSpans.Last().Num;
+	}
+}
+
+TArrayView<const FPF2PassiveEffectPlanEntry> FPF2PassiveEffectPlan::GetEntriesInWeightGroup(
+	const FName WeightGroup) const
+{
+	for (const FPF2PassiveEffectPlanSpan& Span : this->WeightGroupSpans)
+	{
+		if (Span.WeightGroup == WeightGroup)
+		{
+			return this->GetEntriesInSpan(Span);
+		}
+	}
+
+	return TArrayView<const FPF2PassiveEffectPlanEntry>();
+}
+
+void FPF2PassiveEffectPlan::CombineEntries(const TSet<TSubclassOf<UGameplayEffect>>& StackableEffects,
+                                           UPF2CompositeGameplayEffectSubsystem&     CompositeEffects)
+{
+	TArray<FPF2PassiveEffectPlanEntry>   CombinedEntries;
+	TArray<FPF2PassiveEffectPlanEntry>   Run;
+	TArray<TSubclassOf<UGameplayEffect>> RunEffects;
+
+	const auto FlushRun = [&CombinedEntries, &Run, &RunEffects, &CompositeEffects]
+	{
+		if (Run.Num() == 1)
+		{
+			// Nothing to combine the entry with.
+			CombinedEntries.Add(Run[0]);
+		}
+		else if (Run.Num() > 1)
+		{
+			FPF2PassiveEffectPlanEntry CombinedEntry = Run[0];
+
+			CombinedEntry.Effects    = RunEffects;
+			CombinedEntry.Definition = CompositeEffects.FindOrCreate(RunEffects);
+
+			CombinedEntries.Add(CombinedEntry);
+		}
+
+		Run.Reset();
+		RunEffects.Reset();
+	};
+
+	CombinedEntries.Reserve(this->Entries.Num());
+
+	for (const FPF2PassiveEffectPlanEntry& Entry : this->Entries)
+	{
+		const TSubclassOf<UGameplayEffect> Effect        = Entry.Effects[0];
+		const bool                         bCanCombine   =
+			!StackableEffects.Contains(Effect) && UPF2CompositeGameplayEffect::CanCombine(Effect) &&
+			!this->DependencyGraph.DoesEffectReadSnapshotAttributes(Effect);
+		bool                               bDependsOnRun = false;
+
+		for (const TSubclassOf<UGameplayEffect>& RunEffect : RunEffects)
+		{
+			if (this->DependencyGraph.DoesEffectDependOn(Effect, RunEffect))
+			{
+				bDependsOnRun = true;
+				break;
+			}
+		}
+
+		if (!bCanCombine || bDependsOnRun || ((Run.Num() != 0) && (Run[0].WeightGroup != Entry.WeightGroup)))
+		{
+			FlushRun();
+		}
+
+		if (bCanCombine)
+		{
+			Run.Add(Entry);
+			RunEffects.Add(Effect);
+		}
+		else
+		{
+			CombinedEntries.Add(Entry);
+		}
+	}
+
+	FlushRun();
+
+	this->Entries = MoveTemp(CombinedEntries);
+}
@@ -0,0 +1,46 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2PassiveEffectSpecCache.h"
+
+FGameplayEffectSpecHandle FPF2PassiveEffectSpecCache::Find(
+	const UGameplayEffect* Definition,
+	const FName            WeightGroup,
+	const int32            CharacterLevel) const
+{
+	if (CharacterLevel == this->Level)
+	{
+		const FGameplayEffectSpecHandle* SpecHandle = this->Specs.Find({Definition, WeightGroup});
+
+		if (SpecHandle != nullptr)
+		{
+			return *SpecHandle;
+		}
+	}
+
+	return FGameplayEffectSpecHandle();
+}
+
+void FPF2PassiveEffectSpecCache::Add(
+	const UGameplayEffect*           Definition,
+	const FName                      WeightGroup,
+	const int32                      CharacterLevel,
+	const FGameplayEffectSpecHandle& SpecHandle)
+{
+	if (CharacterLevel != this->Level)
+	{
+		// Specs capture the level they were made for, so specs for any other level are no longer useful.
+		this->Specs.Reset();
+		this->Level = CharacterLevel;
+	}
+
+	this->Specs.Add({Definition, WeightGroup}, SpecHandle);
+}
+
+void FPF2PassiveEffectSpecCache::Reset()
+{
+	this->Specs.Reset();
+	this->Level = INDEX_NONE;
+}
@@ -0,0 +1,98 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2PassiveEffectStatsRecorder.h"
+
+#include <HAL/PlatformTime.h>
+
+/**
+ * The recorder that has the outermost open scope on the current thread, if any.
+ */
+static thread_local FPF2PassiveEffectStatsRecorder* ActiveRecorder = nullptr;
+
+void FPF2PassiveEffectStatsRecorder::RecordMagnitudeEvaluation()
+{
+	if (ActiveRecorder != nullptr)
+	{
+		++ActiveRecorder->GetCurrentStats().NumMagnitudeEvaluations;
+	}
+}
+
+void FPF2PassiveEffectStatsRecorder::Reset()
+{
+	this->Stats.Reset();
+}
+
+void FPF2PassiveEffectStatsRecorder::BeginScope(const EPF2PassiveEffectTrigger Trigger)
+{
+	if (this->ScopeDepth == 0)
+	{
+		this->ScopeTrigger   = Trigger;
+		this->ScopeStartTime = FPlatformTime::Seconds();
+		this->ScopeStats     = FPF2PassiveEffectStats();
+
+		this->PreviousActiveRecorder = ActiveRecorder;
+		ActiveRecorder               = this;
+	}
+
+	++this->ScopeDepth;
+}
+
+void FPF2PassiveEffectStatsRecorder::EndScope()
+{
+	checkf(this->ScopeDepth > 0, TEXT("EndScope() was called without a matching call to BeginScope()."));
+
+	--this->ScopeDepth;
+
+	if (this->ScopeDepth == 0)
+	{
+		FPF2PassiveEffectStats& TriggerStats = this->Stats.FindOrAdd(this->ScopeTrigger);
+
+		this->ScopeStats.NumCalls        = 1;
+		this->ScopeStats.WallTimeSeconds = FPlatformTime::Seconds() - this->ScopeStartTime;
+
+		if (this->ScopeStats.HasEffectChanges())
+		{
+			this->ScopeStats.NumReapplyCycles = 1;
+		}
+
+		TriggerStats += this->ScopeStats;
+
+		checkf(
+			ActiveRecorder == this,
+			TEXT("A passive GE stats scope was closed while a scope that was opened after it was still open.")
+		);
+
+		ActiveRecorder               = this->PreviousActiveRecorder;
+		this->PreviousActiveRecorder = nullptr;
+	}
+}
+
+void FPF2PassiveEffectStatsRecorder::RecordEffectRemoved()
+{
+	++this->GetCurrentStats().NumEffectsRemoved;
+}
+
+void FPF2PassiveEffectStatsRecorder::RecordEffectApplied()
+{
+	++this->GetCurrentStats().NumEffectsApplied;
+}
+
+void FPF2PassiveEffectStatsRecorder::RecordEffectLevelUpdated()
+{
+	++this->GetCurrentStats().NumEffectsLevelUpdated;
+}
+
+FPF2PassiveEffectStats& FPF2PassiveEffectStatsRecorder::GetCurrentStats()
+{
+	if (this->ScopeDepth == 0)
+	{
+		return this->Stats.FindOrAdd(EPF2PassiveEffectTrigger::Other);
+	}
+	else
+	{
+		return this->ScopeStats;
+	}
+}
@@ -14,6 +14,7 @@
 
 #include "OpenPF2Core.h"
 #include "Abilities/PF2AttributeSet.h"
+#include "Abilities/PF2DerivedStatistics.h"
 #include "Calculations/PF2TemlCalculation.h"
 
 float UPF2SimpleTemlModifierCalculationBase::DoCalculation(
@@ -28,7 +29,19 @@ float UPF2SimpleTemlModifierCalculationBase::DoCalculation(
 	// your character is untrained in, use the same method, but your proficiency bonus is +0."
 	//
 	// Source: Pathfinder 2E Core Rulebook, page 28, "Skills".
-	const float ProficiencyBonus = FPF2TemlCalculation(this->ProficiencyRootTag, Spec).GetValue();
+	const int32 StatisticIndex = FPF2DerivedStatistics::IndexOfTemlModifier(this->ProficiencyRootTag, AbilityAttribute);
+	float       PrecalculatedModifier,
+	            ProficiencyBonus;
+
+	if (FPF2DerivedStatistics::FindPrecalculatedValue(Spec, StatisticIndex, AbilityScore, *this, PrecalculatedModifier))
+	{
+		// The precalculated statistic is the ability modifier plus the proficiency bonus.
+		ProficiencyBonus = PrecalculatedModifier - AbilityScore;
+	}
+	else
+	{
+		ProficiencyBonus = FPF2TemlCalculation(this->ProficiencyRootTag, Spec).GetValue();
+	}
 
 	return this->DoCalculation(Spec, AbilityAttribute, AbilityScore, ProficiencyBonus);
 }
@@ -53,3 +66,15 @@ float UPF2SimpleTemlModifierCalculationBase::DoCalculation(
 
 	return Modifier;
 }
+
+FGameplayTagContainer UPF2SimpleTemlModifierCalculationBase::GetSourceTagDependencies() const
+{
+	// Only tags under the proficiency root (e.g., "Skill.Arcana.Trained") affect the TEML proficiency of this stat.
+	return FGameplayTagContainer(this->ProficiencyRootTag);
+}
+
+bool UPF2SimpleTemlModifierCalculationBase::IsLevelDependent() const
+{
+	// The TEML proficiency bonus includes the character level for any rank above "untrained".
+	return true;
+}
@@ -14,17 +14,25 @@ float UPF2AbilityBoostCalculationBase::DoCalculation(
 	const FGameplayAttribute   AbilityAttribute,
 	const float                AbilityScore) const
 {
-	const float Boost = UPF2CharacterStatLibrary::CalculateAbilityBoostAmount(AbilityScore);
+	// All boosts to the same ability are applied as a single GE that has one stack per boost.
+	const int32 BoostCount = FMath::Max(1, Spec.GetStackCount());
+	const float TotalBoost = UPF2CharacterStatLibrary::CalculateAbilityBoostAmount(AbilityScore, BoostCount);
 
 	UE_LOG(
 		LogPf2Core,
 		VeryVerbose,
-		TEXT("Calculated MMC boost for ability score attribute ('%s'): %f + %f = %f"),
+		TEXT("Calculated MMC boost for ability score attribute ('%s') with %d boost(s): %f + %f = %f"),
 		*(AbilityAttribute.GetName()),
+		BoostCount,
 		AbilityScore,
-		Boost,
-		AbilityScore + Boost
+		TotalBoost,
+		AbilityScore + TotalBoost
 	);
 
-	return Boost;
+	// GAS multiplies the magnitude of additive modifiers by the stack count of the GE, so we return the average boost
+	// per stack. Dividing and multiplying again in floating point is not always exact (e.g., 13 boost points over 11
+	// stacks comes back as 12.999999), but each boost adds 1 or 2 points, and the result is exact for every such total
+	// up to 10 boosts. The rules allow at most 8 boosts to one ability (4 at 1st level, then 1 each at levels 5, 10, 15,
+	// and 20), so ability scores never pick up rounding error that would throw off ability modifiers.
+	return TotalBoost / BoostCount;
 }
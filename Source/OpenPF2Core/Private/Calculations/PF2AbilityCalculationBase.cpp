@@ -6,9 +6,12 @@
 #include "Calculations/PF2AbilityCalculationBase.h"
 #include "OpenPF2Core.h"
 #include "Abilities/PF2AttributeSet.h"
+#include "Abilities/PF2PassiveEffectStatsRecorder.h"
 
 float UPF2AbilityCalculationBase::CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const
 {
+	FPF2PassiveEffectStatsRecorder::RecordMagnitudeEvaluation();
+
 	float     Value                  = 0.0f;
 	const int CapturedAttributeCount = this->RelevantAttributesToCapture.Num();
 
@@ -53,3 +56,13 @@ float UPF2AbilityCalculationBase::DoCalculation(const FGameplayEffectSpec& Spec)
 
 	return this->DoCalculation(Spec, AbilityAttribute, AbilityScore);
 }
+
+FGameplayTagContainer UPF2AbilityCalculationBase::GetSourceTagDependencies() const
+{
+	return FGameplayTagContainer();
+}
+
+bool UPF2AbilityCalculationBase::IsLevelDependent() const
+{
+	return false;
+}
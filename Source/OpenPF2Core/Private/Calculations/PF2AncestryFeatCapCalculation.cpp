@@ -5,11 +5,25 @@
 
 #include "Calculations/PF2AncestryFeatCapCalculation.h"
 
+#include "Abilities/PF2PassiveEffectStatsRecorder.h"
 #include "Libraries/PF2CharacterStatLibrary.h"
 
 float UPF2AncestryFeatCapCalculation::CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const
 {
+	FPF2PassiveEffectStatsRecorder::RecordMagnitudeEvaluation();
+
 	const float CharacterLevel = Spec.GetLevel();
 
 	return UPF2CharacterStatLibrary::CalculateAncestryFeatCap(CharacterLevel);
 }
+
+FGameplayTagContainer UPF2AncestryFeatCapCalculation::GetSourceTagDependencies() const
+{
+	// The cap depends only on character level.
+	return FGameplayTagContainer();
+}
+
+bool UPF2AncestryFeatCapCalculation::IsLevelDependent() const
+{
+	return true;
+}
@@ -15,6 +15,8 @@
 #include "OpenPF2Core.h"
 #include "Abilities/PF2CharacterAttributeStatics.h"
 #include "Abilities/PF2AttributeSet.h"
+#include "Abilities/PF2DerivedStatistics.h"
+#include "Abilities/PF2PassiveEffectStatsRecorder.h"
 #include "Calculations/PF2TemlCalculation.h"
 #include "Utilities/PF2GameplayAbilityUtilities.h"
 
@@ -25,6 +27,37 @@ UPF2ArmorClassCalculation::UPF2ArmorClassCalculation() :
 }
 
 float UPF2ArmorClassCalculation::CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const
+{
+	const float DexterityModifier = this->GetDexterityModifier(Spec);
+	float       ArmorClass;
+
+	FPF2PassiveEffectStatsRecorder::RecordMagnitudeEvaluation();
+
+	const bool bWasPrecalculated =
+		FPF2DerivedStatistics::FindPrecalculatedValue(
+			Spec,
+			FPF2DerivedStatistics::IndexOf(UPF2AttributeSet::GetArmorClassAttribute()),
+			DexterityModifier,
+			*this,
+			ArmorClass
+		);
+
+	if (!bWasPrecalculated)
+	{
+		ArmorClass = this->CalculateArmorClass(
+			DexterityModifier,
+			Spec.CapturedSourceTags.GetAggregatedTags(),
+			Spec.GetLevel()
+		);
+	}
+
+	return ArmorClass;
+}
+
+float UPF2ArmorClassCalculation::CalculateArmorClass(
+	const float                  DexterityModifier,
+	const FGameplayTagContainer* CharacterTags,
+	const float                  CharacterLevel) const
 {
 	// From Pathfinder 2E Core Rulebook, page 274, "Armor Class".
 	// "Armor Class = 10 + Dexterity modifier (up to your armor’s Dex Cap) + proficiency bonus
@@ -34,8 +67,7 @@ float UPF2ArmorClassCalculation::CalculateBaseMagnitude_Implementation(const FGa
 	// wearing. If you're not wearing armor, use your proficiency in unarmored defense."
 	//
 	// TODO: Implement armor Dex Cap.
-	const float DexterityModifier         = GetDexterityModifier(Spec),
-	            ArmorTypeProficiencyBonus = CalculateArmorTypeProficiencyBonus(Spec),
+	const float ArmorTypeProficiencyBonus = this->CalculateArmorTypeProficiencyBonus(CharacterTags, CharacterLevel),
 	            AbilityScore              = 10.0f + DexterityModifier + ArmorTypeProficiencyBonus;
 
 	UE_LOG(
@@ -50,6 +82,21 @@ float UPF2ArmorClassCalculation::CalculateBaseMagnitude_Implementation(const FGa
 	return AbilityScore;
 }
 
+FGameplayTagContainer UPF2ArmorClassCalculation::GetSourceTagDependencies() const
+{
+	FGameplayTagContainer Dependencies;
+
+	Dependencies.AddTag(PF2GameplayAbilityUtilities::GetTag(FName("Armor.Equipped")));
+	Dependencies.AddTag(PF2GameplayAbilityUtilities::GetTag(FName("Armor.Category")));
+
+	return Dependencies;
+}
+
+bool UPF2ArmorClassCalculation::IsLevelDependent() const
+{
+	return true;
+}
+
 FORCEINLINE float UPF2ArmorClassCalculation::GetDexterityModifier(const FGameplayEffectSpec& Spec) const
 {
 	float                         DexterityModifier     = 0.0f;
@@ -70,13 +117,19 @@ FORCEINLINE float UPF2ArmorClassCalculation::GetDexterityModifier(const FGamepla
 	return DexterityModifier;
 }
 
-float UPF2ArmorClassCalculation::CalculateArmorTypeProficiencyBonus(const FGameplayEffectSpec& Spec) const
+float UPF2ArmorClassCalculation::CalculateArmorTypeProficiencyBonus(
+	const FGameplayTagContainer* SourceTags,
+	const float                  CharacterLevel) const
 {
-	const FGameplayTagContainer* SourceTags                 = Spec.CapturedSourceTags.GetAggregatedTags();
-	const FString                ArmorType                  = DetermineArmorType(SourceTags),
-	                             ArmorTypeProficiencyPrefix = "Armor.Category." + ArmorType;
-
-	const float ProficiencyBonus = FPF2TemlCalculation(ArmorTypeProficiencyPrefix, Spec).GetValue();
+	const FString ArmorType                  = DetermineArmorType(SourceTags),
+	              ArmorTypeProficiencyPrefix = "Armor.Category." + ArmorType;
+
+	const float ProficiencyBonus =
+		FPF2TemlCalculation(
+			PF2GameplayAbilityUtilities::GetTag(ArmorTypeProficiencyPrefix),
+			SourceTags,
+			CharacterLevel
+		).GetValue();
 
 	UE_LOG(
 		LogPf2Core,
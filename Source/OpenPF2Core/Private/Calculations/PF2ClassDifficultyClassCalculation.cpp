@@ -5,7 +5,39 @@
 
 #include "Calculations/PF2ClassDifficultyClassCalculation.h"
 
+#include "Abilities/PF2AttributeSet.h"
+#include "Abilities/PF2DerivedStatistics.h"
+#include "Abilities/PF2PassiveEffectStatsRecorder.h"
+
 UPF2ClassDifficultyClassCalculation::UPF2ClassDifficultyClassCalculation() :
 	UPF2KeyAbilityTemlCalculationBase(TEXT("ClassDc"), TEXT("KeyAbility"), 10.0f)
 {
 }
+
+float UPF2ClassDifficultyClassCalculation::CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const
+{
+	const float KeyAbilityModifier = this->CalculateKeyAbilityModifier(Spec);
+	float       ClassDifficultyClass;
+
+	FPF2PassiveEffectStatsRecorder::RecordMagnitudeEvaluation();
+
+	const bool bWasPrecalculated =
+		FPF2DerivedStatistics::FindPrecalculatedValue(
+			Spec,
+			FPF2DerivedStatistics::IndexOf(UPF2AttributeSet::GetClassDifficultyClassAttribute()),
+			KeyAbilityModifier,
+			*this,
+			ClassDifficultyClass
+		);
+
+	if (!bWasPrecalculated)
+	{
+		ClassDifficultyClass = this->CalculateAbilityScore(
+			Spec.CapturedSourceTags.GetAggregatedTags(),
+			Spec.GetLevel(),
+			KeyAbilityModifier
+		);
+	}
+
+	return ClassDifficultyClass;
+}
@@ -14,6 +14,7 @@
 
 #include "OpenPF2Core.h"
 #include "Abilities/PF2AttributeSet.h"
+#include "Abilities/PF2PassiveEffectStatsRecorder.h"
 #include "Calculations/PF2TemlCalculation.h"
 #include "Utilities/PF2GameplayAbilityUtilities.h"
 
@@ -79,6 +80,60 @@ void UPF2KeyAbilityTemlCalculationBase::DefineKeyAbilityCapture(
 }
 
 float UPF2KeyAbilityTemlCalculationBase::CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const
+{
+	FPF2PassiveEffectStatsRecorder::RecordMagnitudeEvaluation();
+
+	return this->CalculateAbilityScore(
+		Spec.CapturedSourceTags.GetAggregatedTags(),
+		Spec.GetLevel(),
+		this->CalculateKeyAbilityModifier(Spec)
+	);
+}
+
+float UPF2KeyAbilityTemlCalculationBase::CalculateFromAbilityModifiers(
+	const TFunctionRef<float (const FGameplayAttribute&)> GetAbilityModifier,
+	const FGameplayTagContainer*                          CharacterTags,
+	const float                                           CharacterLevel,
+	float&                                                OutKeyAbilityModifier) const
+{
+	const FGameplayAttribute KeyAbilityAttribute = this->DetermineKeyAbility(CharacterTags).AttributeToCapture;
+
+	OutKeyAbilityModifier = 0.0f;
+
+	if (KeyAbilityAttribute.IsValid())
+	{
+		OutKeyAbilityModifier = GetAbilityModifier(KeyAbilityAttribute);
+	}
+
+	return this->CalculateAbilityScore(CharacterTags, CharacterLevel, OutKeyAbilityModifier);
+}
+
+FGameplayTagContainer UPF2KeyAbilityTemlCalculationBase::GetSourceTagDependencies() const
+{
+	FGameplayTagContainer Dependencies;
+
+	if (!this->StatGameplayTagPrefix.IsEmpty())
+	{
+		Dependencies.AddTag(PF2GameplayAbilityUtilities::GetTag(this->StatGameplayTagPrefix));
+	}
+
+	for (const auto& KeyAbilityCapture : this->KeyAbilityCaptureDefinitions)
+	{
+		Dependencies.AddTag(PF2GameplayAbilityUtilities::GetTag(KeyAbilityCapture.Key));
+	}
+
+	return Dependencies;
+}
+
+bool UPF2KeyAbilityTemlCalculationBase::IsLevelDependent() const
+{
+	return true;
+}
+
+float UPF2KeyAbilityTemlCalculationBase::CalculateAbilityScore(
+	const FGameplayTagContainer* CharacterTags,
+	const float                  CharacterLevel,
+	const float                  KeyAbilityModifier) const
 {
 	// Logic shared by the "Class DC", "Spell Attack Roll", and "Spell DC" calculations.
 	// "A class DC ... equals 10 plus their proficiency bonus for their class DC (+3 for most 1st-level characters) plus
@@ -91,9 +146,9 @@ float UPF2KeyAbilityTemlCalculationBase::CalculateBaseMagnitude_Implementation(c
 	// Spell DC = 10 + your spellcasting ability modifier + proficiency bonus + other bonuses + penalties"
 	//
 	// Source: Pathfinder 2E Core Rulebook, page 298, "Spell Attack Roll and Spell DC".
-	const float ProficiencyBonus   = FPF2TemlCalculation(this->StatGameplayTagPrefix, Spec).GetValue(),
-	            KeyAbilityModifier = this->CalculateKeyAbilityModifier(Spec),
-	            AbilityScore       = this->BaseValue + ProficiencyBonus + KeyAbilityModifier;
+	const FGameplayTag StatTag          = PF2GameplayAbilityUtilities::GetTag(this->StatGameplayTagPrefix);
+	const float        ProficiencyBonus = FPF2TemlCalculation(StatTag, CharacterTags, CharacterLevel).GetValue(),
+	                   AbilityScore     = this->BaseValue + ProficiencyBonus + KeyAbilityModifier;
 
 	UE_LOG(
 		LogPf2Core,
@@ -12,12 +12,16 @@
 
 #include "Calculations/PF2StandardDamageExecution.h"
 
+#include <AbilitySystemComponent.h>
+
+#include "Abilities/PF2AttributeSet.h"
 #include "Abilities/PF2CharacterAttributeStatics.h"
 #include "Utilities/PF2GameplayAbilityUtilities.h"
 
 UPF2StandardDamageExecution::UPF2StandardDamageExecution() :
 	DamageParameterTag(FGameplayTag::RequestGameplayTag(this->DamageParameterTagName)),
-	ResistanceParameterTag(FGameplayTag::RequestGameplayTag(this->ResistanceParameterTagName))
+	ResistanceParameterTag(FGameplayTag::RequestGameplayTag(this->ResistanceParameterTagName)),
+	DamageTypeTagParent(FGameplayTag::RequestGameplayTag(this->DamageTypeTagName))
 {
 	this->ValidTransientAggregatorIdentifiers.AddTag(this->DamageParameterTag);
 	this->ValidTransientAggregatorIdentifiers.AddTag(this->ResistanceParameterTag);
@@ -31,9 +35,18 @@ void UPF2StandardDamageExecution::Execute_Implementation(
 	      Resistance     = 0.0f,
 	      DamageDone;
 
-	const FGameplayEffectSpec&   Spec       = ExecutionParams.GetOwningSpec();
-	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
-	const FGameplayTagContainer* TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+	const FGameplayEffectSpec&     Spec       = ExecutionParams.GetOwningSpec();
+	const FGameplayTagContainer*   SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+	const FGameplayTagContainer*   TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+	const UAbilitySystemComponent* TargetAsc  = ExecutionParams.GetTargetAbilitySystemComponent();
+	const UPF2AttributeSet*        TargetSet  = nullptr;
+	FGameplayTagContainer          AssetTags;
+	FPF2DamageTypeDefenses         Defenses;
+
+	if (TargetAsc != nullptr)
+	{
+		TargetSet = TargetAsc->GetSet<UPF2AttributeSet>();
+	}
 
 	FAggregatorEvaluateParameters EvaluationParameters;
 
@@ -46,18 +59,49 @@ void UPF2StandardDamageExecution::Execute_Implementation(
 		IncomingDamage
 	);
 
-	ExecutionParams.AttemptCalculateTransientAggregatorMagnitude(
-		this->ResistanceParameterTag,
-		EvaluationParameters,
-		Resistance
-	);
+	const bool bHasResistanceParameter =
+		ExecutionParams.AttemptCalculateTransientAggregatorMagnitude(
+			this->ResistanceParameterTag,
+			EvaluationParameters,
+			Resistance
+		);
+
+	Spec.GetAllAssetTags(AssetTags);
+
+	if (TargetSet != nullptr)
+	{
+		const FGameplayTag DamageType = this->DetermineDamageType(AssetTags);
+
+		if (DamageType.IsValid())
+		{
+			Defenses = TargetSet->GetDamageTypeTable().GetDefenses(
+				PF2GameplayAbilityUtilities::GetDamageTypeOrdinal(DamageType)
+			);
+		}
+	}
+
+	// A GE that supplies the resistance of the target takes the place of the resistance in the damage type table.
+	if (!bHasResistanceParameter)
+	{
+		Resistance = Defenses.Resistance;
+	}
 
-	// Don't allow resistance to make damage negative (i.e., damage can never heal, but it can become ineffectual).
-	//
-	// From the Pathfinder 2E Core Rulebook, page 453, "Resistance":
-	// "If you have resistance to a type of damage, each time you take that type of damage, you reduce the amount of
-	// damage you take by the listed amount (to a minimum of 0 damage)."
-	DamageDone = FMath::Max(0.0f, IncomingDamage - Resistance);
+	// From the Pathfinder 2E Core Rulebook, page 453, "Immunities, Weaknesses, and Resistances":
+	// "If you have more than one type of these adjustments, apply immunities first, then weaknesses, and resistances
+	// last."
+	if (Defenses.bIsImmune || (IncomingDamage <= 0.0f))
+	{
+		DamageDone = 0.0f;
+	}
+	else
+	{
+		// Don't allow resistance to make damage negative (i.e., damage can never heal, but it can become ineffectual).
+		//
+		// From the Pathfinder 2E Core Rulebook, page 453, "Resistance":
+		// "If you have resistance to a type of damage, each time you take that type of damage, you reduce the amount of
+		// damage you take by the listed amount (to a minimum of 0 damage)."
+		DamageDone = FMath::Max(0.0f, IncomingDamage + Defenses.Weakness - Resistance);
+	}
 
 	if (DamageDone > 0.0f)
 	{
@@ -70,3 +114,22 @@ void UPF2StandardDamageExecution::Execute_Implementation(
 		);
 	}
 }
+
+FGameplayTag UPF2StandardDamageExecution::DetermineDamageType(const FGameplayTagContainer& AssetTags) const
+{
+	FGameplayTag DamageType;
+	int32        DamageTypeDepth = 0;
+
+	for (const FGameplayTag& Tag : AssetTags.Filter(FGameplayTagContainer(this->DamageTypeTagParent)))
+	{
+		const int32 TagDepth = Tag.GetGameplayTagParents().Num();
+
+		if (TagDepth > DamageTypeDepth)
+		{
+			DamageType      = Tag;
+			DamageTypeDepth = TagDepth;
+		}
+	}
+
+	return DamageType;
+}
@@ -5,17 +5,42 @@
 
 #include "GameModes/PF2EncounterModeOfPlayRuleSetBase.h"
 
+#include <AbilitySystemComponent.h>
+
 #include "OpenPF2Core.h"
 #include "PF2CharacterInterface.h"
 #include "PF2PlayerControllerBase.h"
 #include "PF2PlayerControllerInterface.h"
 #include "PF2QueuedActionHandle.h"
 
+#include "Abilities/PF2AttributeSet.h"
+
 #include "Utilities/PF2ArrayUtilities.h"
 #include "Utilities/PF2InterfaceUtilities.h"
 #include "Utilities/PF2LogUtilities.h"
 #include "Utilities/PF2MapUtilities.h"
 
+void UPF2EncounterModeOfPlayRuleSetBase::Tick(float DeltaTime)
+{
+	this->PublishParticipantStats();
+}
+
+bool UPF2EncounterModeOfPlayRuleSetBase::IsTickable() const
+{
+	// Only rule sets that are actually running an encounter should tick, not their CDOs or Blueprint archetypes.
+	return !this->IsTemplate() && (this->GetWorld() != nullptr);
+}
+
+TStatId UPF2EncounterModeOfPlayRuleSetBase::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPF2EncounterModeOfPlayRuleSetBase, STATGROUP_Tickables);
+}
+
+UWorld* UPF2EncounterModeOfPlayRuleSetBase::GetTickableGameObjectWorld() const
+{
+	return this->GetWorld();
+}
+
 void UPF2EncounterModeOfPlayRuleSetBase::StartTurnForCharacter(const TScriptInterface<IPF2CharacterInterface> Character)
 {
 	const TScriptInterface<IPF2PlayerControllerInterface> PlayerController = Character->GetPlayerController();
@@ -472,3 +497,52 @@ void UPF2EncounterModeOfPlayRuleSetBase::RemoveCharacterFromInitiativeMap(const
 		}
 	}
 }
+
+void UPF2EncounterModeOfPlayRuleSetBase::PublishParticipantStats()
+{
+	FPF2EncounterParticipantStats* Stats = this->ParticipantTable.BeginWrite();
+	int32                          NumParticipants;
+
+	if (Stats == nullptr)
+	{
+		// A reader is still holding onto the back buffer, so keep the stats from the last frame published.
+		return;
+	}
+
+	NumParticipants = this->CurrentCharacterSequence.Num();
+
+	Stats->FrameNumber = GFrameCounter;
+	Stats->SetNum(NumParticipants);
+
+	for (int32 ParticipantIndex = 0; ParticipantIndex < NumParticipants; ++ParticipantIndex)
+	{
+		IPF2CharacterInterface*       Character    = this->CurrentCharacterSequence[ParticipantIndex];
+		AActor*                       Actor        = Character->ToActor();
+		const UPF2AttributeSet*       AttributeSet =
+			Character->GetAbilitySystemComponent()->GetSet<UPF2AttributeSet>();
+
+		Stats->Actors[ParticipantIndex]    = Actor;
+		Stats->Locations[ParticipantIndex] = Actor->GetActorLocation();
+
+		if (AttributeSet == nullptr)
+		{
+			Stats->HitPoints[ParticipantIndex]          = 0.0f;
+			Stats->MaxHitPoints[ParticipantIndex]       = 0.0f;
+			Stats->ArmorClasses[ParticipantIndex]       = 0.0f;
+			Stats->FortitudeModifiers[ParticipantIndex] = 0.0f;
+			Stats->ReflexModifiers[ParticipantIndex]    = 0.0f;
+			Stats->WillModifiers[ParticipantIndex]      = 0.0f;
+		}
+		else
+		{
+			Stats->HitPoints[ParticipantIndex]          = AttributeSet->GetHitPoints();
+			Stats->MaxHitPoints[ParticipantIndex]       = AttributeSet->GetMaxHitPoints();
+			Stats->ArmorClasses[ParticipantIndex]       = AttributeSet->GetArmorClass();
+			Stats->FortitudeModifiers[ParticipantIndex] = AttributeSet->GetStFortitudeModifier();
+			Stats->ReflexModifiers[ParticipantIndex]    = AttributeSet->GetStReflexModifier();
+			Stats->WillModifiers[ParticipantIndex]      = AttributeSet->GetStWillModifier();
+		}
+	}
+
+	this->ParticipantTable.Publish();
+}
@@ -0,0 +1,66 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "GameModes/PF2EncounterParticipantTable.h"
+
+void FPF2EncounterParticipantStats::SetNum(const int32 NumParticipants)
+{
+	constexpr bool bAllowShrinking = false;
+
+	this->Actors.SetNum(NumParticipants, bAllowShrinking);
+	this->Locations.SetNum(NumParticipants, bAllowShrinking);
+	this->HitPoints.SetNum(NumParticipants, bAllowShrinking);
+	this->MaxHitPoints.SetNum(NumParticipants, bAllowShrinking);
+	this->ArmorClasses.SetNum(NumParticipants, bAllowShrinking);
+	this->FortitudeModifiers.SetNum(NumParticipants, bAllowShrinking);
+	this->ReflexModifiers.SetNum(NumParticipants, bAllowShrinking);
+	this->WillModifiers.SetNum(NumParticipants, bAllowShrinking);
+}
+
+FPF2EncounterParticipantTable::FReadScope FPF2EncounterParticipantTable::Read() const
+{
+	int32 BufferIndex;
+
+	while (true)
+	{
+		BufferIndex = this->FrontBufferIndex.load();
+
+		this->ReaderCounts[BufferIndex].fetch_add(1);
+
+		// If the buffers were swapped before the reader count was incremented, the game thread may already be writing
+		// to this buffer, so try again with the new front buffer.
+		if (this->FrontBufferIndex.load() == BufferIndex)
+		{
+			break;
+		}
+
+		this->ReaderCounts[BufferIndex].fetch_sub(1);
+	}
+
+	return FReadScope(*this, BufferIndex);
+}
+
+FPF2EncounterParticipantStats* FPF2EncounterParticipantTable::BeginWrite()
+{
+	const int32 BackBufferIndex = 1 - this->FrontBufferIndex.load();
+
+	check(IsInGameThread());
+
+	if (this->ReaderCounts[BackBufferIndex].load() != 0)
+	{
+		return nullptr;
+	}
+	else
+	{
+		return &this->Buffers[BackBufferIndex];
+	}
+}
+
+void FPF2EncounterParticipantTable::Publish()
+{
+	check(IsInGameThread());
+
+	this->FrontBufferIndex.store(1 - this->FrontBufferIndex.load());
+}
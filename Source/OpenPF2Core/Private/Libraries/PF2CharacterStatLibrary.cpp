@@ -21,23 +21,29 @@ float UPF2CharacterStatLibrary::CalculateAbilityModifier(const float AbilityScor
 float UPF2CharacterStatLibrary::CalculateAbilityBoostAmount(const float StartingAbilityScoreValue,
                                                             const int   BoostCount)
 {
-	float BoostAmount = 0.0f;
+	int32 NumLargeBoosts;
 
-	for (int BoostIndex = 0; BoostIndex < BoostCount; ++BoostIndex)
+	if (BoostCount <= 0)
 	{
-		// From the Pathfinder 2E Core Rulebook, page 68, "Ability Boosts":
-		// "Boosting an ability score increases it by 1 if it's already 18 or above, or by 2 if it starts out below 18."
-		if ((StartingAbilityScoreValue + BoostAmount) >= 18.0f)
-		{
-			BoostAmount += 1.0f;
-		}
-		else
-		{
-			BoostAmount += 2.0f;
-		}
+		return 0.0f;
 	}
 
-	return BoostAmount;
+	// From the Pathfinder 2E Core Rulebook, page 68, "Ability Boosts":
+	// "Boosting an ability score increases it by 1 if it's already 18 or above, or by 2 if it starts out below 18."
+	//
+	// Every boost adds 2 until the score reaches 18 or above, and every boost after that adds 1, so the total can be
+	// calculated directly instead of one boost at a time.
+	if (StartingAbilityScoreValue >= 18.0f)
+	{
+		NumLargeBoosts = 0;
+	}
+	else
+	{
+		NumLargeBoosts =
+			FMath::Min(BoostCount, FMath::CeilToInt((18.0f - StartingAbilityScoreValue) / 2.0f));
+	}
+
+	return (2.0f * NumLargeBoosts) + (BoostCount - NumLargeBoosts);
 }
 
 float UPF2CharacterStatLibrary::CalculateAncestryFeatCap(const float CharacterLevel)
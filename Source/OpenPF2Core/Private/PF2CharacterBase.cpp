@@ -1,4 +1,4 @@
-// OpenPF2 for UE Game Logic, Copyright 2021-2022, Guy Elsmore-Paddock. All Rights Reserved.
+﻿// OpenPF2 for UE Game Logic, Copyright 2021-2022, Guy Elsmore-Paddock. All Rights Reserved.
 //
 // This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
 // distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
@@ -7,9 +7,11 @@
 
 #include <AbilitySystemGlobals.h>
 #include <Net/UnrealNetwork.h>
+#include <Net/Core/PushModel/PushModel.h>
 #include <UObject/ConstructorHelpers.h>
 
 #include "Abilities/PF2GameplayAbilityTargetData_BoostAbility.h"
+#include "Abilities/PF2PassiveEffectBatch.h"
 #include "Utilities/PF2InterfaceUtilities.h"
 
 APF2CharacterBase::APF2CharacterBase() :
@@ -23,8 +25,18 @@ void APF2CharacterBase::PossessedBy(AController* NewController)
 
 	if (this->AbilitySystemComponent != nullptr)
 	{
+		// Collect all the changes made while setting up the character, so that passive GEs get applied only once.
+		FPF2PassiveEffectBatch PassiveEffectBatch(this->GetCharacterAbilitySystemComponent());
+
+		// Set the replication mode before any passive GEs are applied, since the mode affects how they get replicated.
+		this->AbilitySystemComponent->SetReplicationMode(this->GetAbilitySystemReplicationMode());
 		this->AbilitySystemComponent->InitAbilityActorInfo(this, this);
 
+		if (this->AttributeSet != nullptr)
+		{
+			this->AttributeSet->SetAttributeGroups(static_cast<EPF2AttributeGroup>(this->AttributeGroups));
+		}
+
 		this->ActivatePassiveGameplayEffects();
 		this->ApplyAbilityBoostSelections();
 		this->GrantAdditionalAbilities();
@@ -45,7 +57,11 @@ void APF2CharacterBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(APF2CharacterBase, CharacterLevel);
+	FDoRepLifetimeParams Params;
+
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(APF2CharacterBase, CharacterLevel, Params);
 }
 
 FString APF2CharacterBase::GetIdForLogs() const
@@ -127,9 +143,9 @@ void APF2CharacterBase::ApplyAbilityBoostSelections()
 
 		for (const auto& AbilityBoostSelection : this->AbilityBoostSelections)
 		{
-			TSubclassOf<UPF2AbilityBoostBase> BoostGa   = AbilityBoostSelection.BoostGameplayAbility;
-			UAbilitySystemComponent*          Asc       = this->GetAbilitySystemComponent();
-			FGameplayAbilitySpec*             BoostSpec = Asc->FindAbilitySpecFromClass(BoostGa);
+			TSubclassOf<UPF2AbilityBoostBase>             BoostGa   = AbilityBoostSelection.BoostGameplayAbility;
+			IPF2CharacterAbilitySystemComponentInterface* Asc       = this->GetCharacterAbilitySystemComponent();
+			FGameplayAbilitySpec*                         BoostSpec = Asc->FindAbilitySpecByClass(BoostGa);
 
 			if (BoostSpec == nullptr)
 			{
@@ -255,24 +271,69 @@ void APF2CharacterBase::RemoveRedundantPendingAbilityBoosts()
 	{
 		for (const auto& AbilityBoostSelection : this->AppliedAbilityBoostSelections)
 		{
-			TSubclassOf<UPF2AbilityBoostBase> BoostGa   = AbilityBoostSelection.BoostGameplayAbility;
-			UAbilitySystemComponent*          Asc       = this->GetAbilitySystemComponent();
-			FGameplayAbilitySpec*             BoostSpec = Asc->FindAbilitySpecFromClass(BoostGa);
+			TSubclassOf<UPF2AbilityBoostBase>             BoostGa   = AbilityBoostSelection.BoostGameplayAbility;
+			IPF2CharacterAbilitySystemComponentInterface* Asc       = this->GetCharacterAbilitySystemComponent();
+			FGameplayAbilitySpec*                         BoostSpec = Asc->FindAbilitySpecByClass(BoostGa);
 
 			if (BoostSpec != nullptr)
 			{
 				// The player or a game designer already made a selection for this boost ability.
-				Asc->ClearAbility(BoostSpec->Handle);
+				Asc->ToAbilitySystemComponent()->ClearAbility(BoostSpec->Handle);
 			}
 		}
 	}
 }
 
+void APF2CharacterBase::OnRep_CharacterLevel(const int32 OldLevel)
+{
+	// Statistics that clients derive locally depend on the level, which can arrive before or after the other inputs.
+	if (this->AbilitySystemComponent != nullptr)
+	{
+		this->AbilitySystemComponent->ScheduleDerivedStatisticsUpdate();
+	}
+}
+
 bool APF2CharacterBase::IsAuthorityForEffects() const
 {
 	return (this->GetLocalRole() == ROLE_Authority);
 }
 
+EGameplayEffectReplicationMode APF2CharacterBase::GetAbilitySystemReplicationMode() const
+{
+	EGameplayEffectReplicationMode ReplicationMode;
+
+	switch (this->AbilitySystemReplicationPolicy)
+	{
+		case EPF2AbilitySystemReplicationPolicy::Full:
+			ReplicationMode = EGameplayEffectReplicationMode::Full;
+			break;
+
+		case EPF2AbilitySystemReplicationPolicy::Mixed:
+			ReplicationMode = EGameplayEffectReplicationMode::Mixed;
+			break;
+
+		case EPF2AbilitySystemReplicationPolicy::Minimal:
+			ReplicationMode = EGameplayEffectReplicationMode::Minimal;
+			break;
+
+		default:
+		case EPF2AbilitySystemReplicationPolicy::Automatic:
+			// "Mixed" mode relies on the controller of the character being the owner of the character, which is only
+			// the case for characters controlled by a player.
+			if (this->IsPlayerControlled())
+			{
+				ReplicationMode = EGameplayEffectReplicationMode::Mixed;
+			}
+			else
+			{
+				ReplicationMode = EGameplayEffectReplicationMode::Minimal;
+			}
+			break;
+	}
+
+	return ReplicationMode;
+}
+
 void APF2CharacterBase::ActivateAbilityBoost(
 	FGameplayAbilitySpec*                     BoostSpec,
 	const FPF2CharacterAbilityBoostSelection& AbilityBoostSelection) const
@@ -302,11 +363,23 @@ void APF2CharacterBase::ActivateAbilityBoost(
 
 void APF2CharacterBase::PopulatePassiveGameplayEffects()
 {
+	const EPF2AttributeGroup                       EnabledGroups =
+		static_cast<EPF2AttributeGroup>(this->AttributeGroups);
 	TMultiMap<FName, TSubclassOf<UGameplayEffect>> GameplayEffects;
 
 	this->GenerateManagedPassiveGameplayEffects();
 
-	GameplayEffects.Append(this->CoreGameplayEffects);
+	for (const auto& CoreEffect : this->CoreGameplayEffects)
+	{
+		const EPF2AttributeGroup* EffectGroup = this->CoreGameplayEffectGroups.Find(CoreEffect.Value);
+
+		// Skip the calculations for attributes that this character does not use.
+		if ((EffectGroup == nullptr) || EnumHasAnyFlags(EnabledGroups, *EffectGroup))
+		{
+			GameplayEffects.Add(CoreEffect.Key, CoreEffect.Value);
+		}
+	}
+
 	GameplayEffects.Append(this->ManagedGameplayEffects);
 
 	for (const auto& AdditionalEffect : this->AdditionalPassiveGameplayEffects)
@@ -374,25 +447,47 @@ void APF2CharacterBase::GrantAdditionalAbilities()
 {
 	if ((this->GrantedAdditionalAbilities.Num() == 0) && this->IsAuthorityForEffects())
 	{
-		UAbilitySystemComponent* Asc          = this->GetAbilitySystemComponent();
-		const int32              AbilityLevel = this->GetCharacterLevel();
+		IPF2CharacterAbilitySystemComponentInterface* Asc          = this->GetCharacterAbilitySystemComponent();
+		const int32                                   AbilityLevel = this->GetCharacterLevel();
+		TArray<FGameplayAbilitySpec>                  Specs;
+		TArray<FGameplayAbilitySpecHandle>            SpecHandles;
+
+		Specs.Reserve(this->AdditionalGameplayAbilities.Num());
 
 		for (const TSubclassOf<UGameplayAbility>& Ability : this->AdditionalGameplayAbilities)
 		{
-			FGameplayAbilitySpec       Spec       = FGameplayAbilitySpec(Ability, AbilityLevel, INDEX_NONE, this);
-			FGameplayAbilitySpecHandle SpecHandle = Asc->GiveAbility(Spec);
+			Specs.Add(FGameplayAbilitySpec(Ability, AbilityLevel, INDEX_NONE, this));
+		}
+
+		SpecHandles = Asc->GiveAbilities(Specs);
 
-			this->GrantedAdditionalAbilities.Add(Ability, SpecHandle);
+		for (int32 AbilityIndex = 0; AbilityIndex < Specs.Num(); ++AbilityIndex)
+		{
+			this->GrantedAdditionalAbilities.Add(
+				this->AdditionalGameplayAbilities[AbilityIndex],
+				SpecHandles[AbilityIndex]
+			);
 		}
 	}
 }
 
 void APF2CharacterBase::HandleCharacterLevelChanged(const float OldLevel, const float NewLevel)
 {
-	this->DeactivatePassiveGameplayEffects();
+	IPF2CharacterAbilitySystemComponentInterface* CharacterAsc = this->GetCharacterAbilitySystemComponent();
+	FPF2PassiveEffectBatch                        PassiveEffectBatch(CharacterAsc);
 
 	this->CharacterLevel = NewLevel;
+	MARK_PROPERTY_DIRTY_FROM_NAME(APF2CharacterBase, CharacterLevel, this);
 	this->OnCharacterLevelChanged(OldLevel, NewLevel);
 
-	this->ActivatePassiveGameplayEffects();
+	if (this->AbilitySystemComponent != nullptr)
+	{
+		this->AbilitySystemComponent->ScheduleDerivedStatisticsUpdate();
+	}
+
+	if (this->IsAuthorityForEffects())
+	{
+		// Only passive GEs that depend on the level get updated, rather than removing and re-applying all of them.
+		CharacterAsc->UpdatePassiveGameplayEffectsForLevelChange();
+	}
 }
@@ -7,6 +7,7 @@
 
 #include <Engine/World.h>
 #include <Net/UnrealNetwork.h>
+#include <Net/Core/PushModel/PushModel.h>
 
 #include "OpenPF2Core.h"
 #include "PF2PlayerControllerInterface.h"
@@ -22,8 +23,12 @@ void APF2GameStateBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(APF2GameStateBase, ModeOfPlay);
-	DOREPLIFETIME(APF2GameStateBase, ModeOfPlayRuleSet);
+	FDoRepLifetimeParams Params;
+
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(APF2GameStateBase, ModeOfPlay, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(APF2GameStateBase, ModeOfPlayRuleSet, Params);
 }
 
 void APF2GameStateBase::SwitchModeOfPlay(const EPF2ModeOfPlayType                               NewMode,
@@ -42,6 +47,9 @@ void APF2GameStateBase::SwitchModeOfPlay(const EPF2ModeOfPlayType
 		this->ModeOfPlay        = NewMode;
 		this->ModeOfPlayRuleSet = NewRuleSet;
 
+		MARK_PROPERTY_DIRTY_FROM_NAME(APF2GameStateBase, ModeOfPlay, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(APF2GameStateBase, ModeOfPlayRuleSet, this);
+
 		// We're running on the server; notify server copies of the game state that we have received a mode of play.
 		this->OnReceivedModeOfPlay();
 	}
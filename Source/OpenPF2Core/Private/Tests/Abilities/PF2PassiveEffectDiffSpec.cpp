@@ -0,0 +1,232 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <GameplayEffect.h>
+
+#include "PF2CharacterConstants.h"
+
+#include "Abilities/PF2AbilitySystemComponent.h"
+
+#include "Tests/PF2SpecBase.h"
+
+BEGIN_DEFINE_PF_SPEC(FPF2PassiveEffectDiffSpec,
+                     "OpenPF2.UPF2AbilitySystemComponent.DiffPassiveGameplayEffects",
+                     EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	using FEffectMap = TMultiMap<FName, TSubclassOf<UGameplayEffect>>;
+
+	const FString BlueprintPath = TEXT("/OpenPF2Core/OpenPF2/Core/Calculations");
+
+	const FName EarlyWeightGroup = PF2CharacterConstants::GeWeightGroups::PreAbilityBoosts;
+	const FName LateWeightGroup  = PF2CharacterConstants::GeWeightGroups::AbilityBoosts;
+
+	TSubclassOf<UGameplayEffect> EffectA;
+	TSubclassOf<UGameplayEffect> EffectB;
+
+	FEffectMap RemovedEffects;
+	FEffectMap AddedEffects;
+
+	void Diff(const FEffectMap& OldEffects, const FEffectMap& NewEffects);
+
+	static int32 CountEffect(const FEffectMap&                   Effects,
+	                         const FName                         WeightGroup,
+	                         const TSubclassOf<UGameplayEffect>& Effect);
+END_DEFINE_PF_SPEC(FPF2PassiveEffectDiffSpec)
+
+void FPF2PassiveEffectDiffSpec::Define()
+{
+	BeforeEach([=, this]()
+	{
+		this->EffectA = this->LoadBlueprint<UGameplayEffect>(this->BlueprintPath, TEXT("GE_CalcArmorClass"));
+		this->EffectB = this->LoadBlueprint<UGameplayEffect>(this->BlueprintPath, TEXT("GE_CalcPerceptionModifier"));
+
+		this->RemovedEffects.Empty();
+		this->AddedEffects.Empty();
+	});
+
+	Describe(TEXT("when both sets contain the same duplicate GEs"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			FEffectMap Effects;
+
+			Effects.Add(this->EarlyWeightGroup, this->EffectA);
+			Effects.Add(this->EarlyWeightGroup, this->EffectA);
+			Effects.Add(this->EarlyWeightGroup, this->EffectB);
+
+			this->Diff(Effects, Effects);
+		});
+
+		It(TEXT("reports no changes"), [=, this]()
+		{
+			TestEqual(TEXT("RemovedEffects.Num()"), this->RemovedEffects.Num(), 0);
+			TestEqual(TEXT("AddedEffects.Num()"), this->AddedEffects.Num(), 0);
+		});
+	});
+
+	Describe(TEXT("when a GE appears once in the old set and twice in the new set"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			FEffectMap OldEffects,
+			           NewEffects;
+
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+
+			NewEffects.Add(this->EarlyWeightGroup, this->EffectA);
+			NewEffects.Add(this->EarlyWeightGroup, this->EffectA);
+
+			this->Diff(OldEffects, NewEffects);
+		});
+
+		It(TEXT("reports the GE as added once"), [=, this]()
+		{
+			TestEqual(TEXT("AddedEffects.Num()"), this->AddedEffects.Num(), 1);
+			TestEqual(
+				TEXT("Added count of EffectA"),
+				CountEffect(this->AddedEffects, this->EarlyWeightGroup, this->EffectA),
+				1
+			);
+		});
+
+		It(TEXT("reports no GEs as removed"), [=, this]()
+		{
+			TestEqual(TEXT("RemovedEffects.Num()"), this->RemovedEffects.Num(), 0);
+		});
+	});
+
+	Describe(TEXT("when a GE appears three times in the old set and once in the new set"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			FEffectMap OldEffects,
+			           NewEffects;
+
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+
+			NewEffects.Add(this->EarlyWeightGroup, this->EffectA);
+
+			this->Diff(OldEffects, NewEffects);
+		});
+
+		It(TEXT("reports the GE as removed twice"), [=, this]()
+		{
+			TestEqual(TEXT("RemovedEffects.Num()"), this->RemovedEffects.Num(), 2);
+			TestEqual(
+				TEXT("Removed count of EffectA"),
+				CountEffect(this->RemovedEffects, this->EarlyWeightGroup, this->EffectA),
+				2
+			);
+		});
+
+		It(TEXT("reports no GEs as added"), [=, this]()
+		{
+			TestEqual(TEXT("AddedEffects.Num()"), this->AddedEffects.Num(), 0);
+		});
+	});
+
+	Describe(TEXT("when duplicate GEs move to a different weight group"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			FEffectMap OldEffects,
+			           NewEffects;
+
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+
+			NewEffects.Add(this->LateWeightGroup, this->EffectA);
+			NewEffects.Add(this->LateWeightGroup, this->EffectA);
+
+			this->Diff(OldEffects, NewEffects);
+		});
+
+		It(TEXT("reports each copy as removed from the old weight group"), [=, this]()
+		{
+			TestEqual(TEXT("RemovedEffects.Num()"), this->RemovedEffects.Num(), 2);
+			TestEqual(
+				TEXT("Removed count of EffectA in the old weight group"),
+				CountEffect(this->RemovedEffects, this->EarlyWeightGroup, this->EffectA),
+				2
+			);
+		});
+
+		It(TEXT("reports each copy as added to the new weight group"), [=, this]()
+		{
+			TestEqual(TEXT("AddedEffects.Num()"), this->AddedEffects.Num(), 2);
+			TestEqual(
+				TEXT("Added count of EffectA in the new weight group"),
+				CountEffect(this->AddedEffects, this->LateWeightGroup, this->EffectA),
+				2
+			);
+		});
+	});
+
+	Describe(TEXT("when duplicates of one GE are replaced with duplicates of another"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			FEffectMap OldEffects,
+			           NewEffects;
+
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectA);
+			OldEffects.Add(this->EarlyWeightGroup, this->EffectB);
+
+			NewEffects.Add(this->EarlyWeightGroup, this->EffectB);
+			NewEffects.Add(this->EarlyWeightGroup, this->EffectB);
+			NewEffects.Add(this->EarlyWeightGroup, this->EffectB);
+
+			this->Diff(OldEffects, NewEffects);
+		});
+
+		It(TEXT("reports every copy of the old GE as removed"), [=, this]()
+		{
+			TestEqual(TEXT("RemovedEffects.Num()"), this->RemovedEffects.Num(), 2);
+			TestEqual(
+				TEXT("Removed count of EffectA"),
+				CountEffect(this->RemovedEffects, this->EarlyWeightGroup, this->EffectA),
+				2
+			);
+		});
+
+		It(TEXT("reports only the extra copies of the new GE as added"), [=, this]()
+		{
+			TestEqual(TEXT("AddedEffects.Num()"), this->AddedEffects.Num(), 2);
+			TestEqual(
+				TEXT("Added count of EffectB"),
+				CountEffect(this->AddedEffects, this->EarlyWeightGroup, this->EffectB),
+				2
+			);
+		});
+	});
+}
+
+void FPF2PassiveEffectDiffSpec::Diff(const FEffectMap& OldEffects, const FEffectMap& NewEffects)
+{
+	UPF2AbilitySystemComponent::DiffPassiveGameplayEffects(
+		OldEffects,
+		NewEffects,
+		this->RemovedEffects,
+		this->AddedEffects
+	);
+}
+
+int32 FPF2PassiveEffectDiffSpec::CountEffect(const FEffectMap&                   Effects,
+                                             const FName                         WeightGroup,
+                                             const TSubclassOf<UGameplayEffect>& Effect)
+{
+	TArray<TSubclassOf<UGameplayEffect>> EffectsInGroup;
+
+	Effects.MultiFind(WeightGroup, EffectsInGroup);
+
+	return EffectsInGroup.FilterByPredicate(
+		[&Effect](const TSubclassOf<UGameplayEffect>& EffectInGroup)
+		{
+			return EffectInGroup == Effect;
+		}
+	).Num();
+}
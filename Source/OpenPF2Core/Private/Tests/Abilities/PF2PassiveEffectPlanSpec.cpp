@@ -0,0 +1,392 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <GameplayEffect.h>
+
+#include "PF2CharacterConstants.h"
+
+#include "Abilities/PF2CompositeGameplayEffect.h"
+#include "Abilities/PF2CompositeGameplayEffectSubsystem.h"
+#include "Abilities/PF2PassiveEffectDependencyGraph.h"
+#include "Abilities/PF2PassiveEffectPlan.h"
+
+#include "Tests/PF2SpecBase.h"
+#include "Tests/PF2TestGameplayEffects.h"
+
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+BEGIN_DEFINE_PF_SPEC(FPF2PassiveEffectPlanSpec,
+                     "OpenPF2.FPF2PassiveEffectPlan",
+                     EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	using FEffectMap = TMultiMap<FName, TSubclassOf<UGameplayEffect>>;
+	using FEffectSet = TSet<TSubclassOf<UGameplayEffect>>;
+
+	const FString BlueprintPath = TEXT("/OpenPF2Core/OpenPF2/Core/Calculations");
+
+	const FName EarlyWeightGroup = PF2CharacterConstants::GeWeightGroups::PreAbilityBoosts;
+	const FName LateWeightGroup  = PF2CharacterConstants::GeWeightGroups::AbilityBoosts;
+
+	// Reads "Armor.Equipped" and "Armor.Category" tags (via its MMC), and writes armor class.
+	TSubclassOf<UGameplayEffect> ArmorClassEffect;
+
+	// Reads Perception proficiency tags (via its MMC), and writes the Perception modifier.
+	TSubclassOf<UGameplayEffect> PerceptionEffect;
+
+	// Reads "Trait.Creature.Elf", and writes "Armor.Equipped.Light".
+	TSubclassOf<UGameplayEffect> GrantArmorTagEffect;
+
+	// Reads "Armor.Equipped.Light".
+	TSubclassOf<UGameplayEffect> ArmorTagReaderEffect;
+
+	// Reads a snapshot of armor class.
+	TSubclassOf<UGameplayEffect> ArmorClassSnapshotEffect;
+
+	UPF2CompositeGameplayEffectSubsystem* CompositeEffects;
+
+	FEffectSet GetEffectsAffectedByTag(const FPF2PassiveEffectDependencyGraph& Graph, const FString& TagName) const;
+END_DEFINE_PF_SPEC(FPF2PassiveEffectPlanSpec)
+
+void FPF2PassiveEffectPlanSpec::Define()
+{
+	BeforeEach([=, this]()
+	{
+		this->ArmorClassEffect =
+			this->LoadBlueprint<UGameplayEffect>(this->BlueprintPath, TEXT("GE_CalcArmorClass"));
+
+		this->PerceptionEffect =
+			this->LoadBlueprint<UGameplayEffect>(this->BlueprintPath, TEXT("GE_CalcPerceptionModifier"));
+
+		this->GrantArmorTagEffect      = UPF2TestGrantArmorTagEffect::StaticClass();
+		this->ArmorTagReaderEffect     = UPF2TestArmorTagReaderEffect::StaticClass();
+		this->ArmorClassSnapshotEffect = UPF2TestArmorClassSnapshotEffect::StaticClass();
+	});
+
+	Describe(TEXT("FPF2PassiveEffectDependencyGraph"), [=, this]()
+	{
+		Describe(TEXT("GetEffectsAffectedByTags()"), [=, this]()
+		{
+			It(TEXT("returns only the GEs that read a changed tag, and the GEs downstream of them"), [=, this]()
+			{
+				const FPF2PassiveEffectDependencyGraph Graph({
+					this->GrantArmorTagEffect,
+					this->ArmorTagReaderEffect,
+					this->ArmorClassEffect,
+					this->ArmorClassSnapshotEffect,
+					this->PerceptionEffect,
+				});
+
+				const FEffectSet AffectedEffects = this->GetEffectsAffectedByTag(Graph, TEXT("Armor.Equipped.Heavy"));
+
+				TestTrue(TEXT("ArmorClassEffect is affected"), AffectedEffects.Contains(this->ArmorClassEffect));
+				TestTrue(
+					TEXT("ArmorClassSnapshotEffect is affected"),
+					AffectedEffects.Contains(this->ArmorClassSnapshotEffect)
+				);
+				TestEqual(TEXT("AffectedEffects.Num()"), AffectedEffects.Num(), 2);
+			});
+
+			It(TEXT("follows tags written by one GE to the GEs that read them"), [=, this]()
+			{
+				const FPF2PassiveEffectDependencyGraph Graph({
+					this->GrantArmorTagEffect,
+					this->ArmorTagReaderEffect,
+					this->ArmorClassEffect,
+					this->ArmorClassSnapshotEffect,
+					this->PerceptionEffect,
+				});
+
+				const FEffectSet AffectedEffects = this->GetEffectsAffectedByTag(Graph, TEXT("Trait.Creature.Elf"));
+
+				TestTrue(TEXT("GrantArmorTagEffect is affected"), AffectedEffects.Contains(this->GrantArmorTagEffect));
+				TestTrue(
+					TEXT("ArmorTagReaderEffect is affected"),
+					AffectedEffects.Contains(this->ArmorTagReaderEffect)
+				);
+				TestTrue(TEXT("ArmorClassEffect is affected"), AffectedEffects.Contains(this->ArmorClassEffect));
+				TestTrue(
+					TEXT("ArmorClassSnapshotEffect is affected"),
+					AffectedEffects.Contains(this->ArmorClassSnapshotEffect)
+				);
+				TestFalse(TEXT("PerceptionEffect is affected"), AffectedEffects.Contains(this->PerceptionEffect));
+			});
+
+			It(TEXT("returns no GEs when no GE reads a changed tag"), [=, this]()
+			{
+				const FPF2PassiveEffectDependencyGraph Graph({
+					this->GrantArmorTagEffect,
+					this->ArmorTagReaderEffect,
+				});
+
+				const FEffectSet AffectedEffects = this->GetEffectsAffectedByTag(Graph, TEXT("Armor.Equipped.Heavy"));
+
+				TestEqual(TEXT("AffectedEffects.Num()"), AffectedEffects.Num(), 0);
+			});
+		});
+
+		Describe(TEXT("GetEffectsDependentOn()"), [=, this]()
+		{
+			It(TEXT("returns every GE downstream of the given GEs, but not the given GEs themselves"), [=, this]()
+			{
+				const FPF2PassiveEffectDependencyGraph Graph({
+					this->GrantArmorTagEffect,
+					this->ArmorTagReaderEffect,
+					this->ArmorClassEffect,
+					this->ArmorClassSnapshotEffect,
+					this->PerceptionEffect,
+				});
+
+				const FEffectSet DependentEffects = Graph.GetEffectsDependentOn({this->GrantArmorTagEffect});
+
+				TestTrue(
+					TEXT("ArmorTagReaderEffect is dependent"),
+					DependentEffects.Contains(this->ArmorTagReaderEffect)
+				);
+				TestTrue(TEXT("ArmorClassEffect is dependent"), DependentEffects.Contains(this->ArmorClassEffect));
+				TestTrue(
+					TEXT("ArmorClassSnapshotEffect is dependent"),
+					DependentEffects.Contains(this->ArmorClassSnapshotEffect)
+				);
+				TestEqual(TEXT("DependentEffects.Num()"), DependentEffects.Num(), 3);
+			});
+		});
+
+		Describe(TEXT("DoesEffectDependOn()"), [=, this]()
+		{
+			It(TEXT("only reports a dependency in the direction that a tag flows"), [=, this]()
+			{
+				const FPF2PassiveEffectDependencyGraph Graph({
+					this->GrantArmorTagEffect,
+					this->ArmorTagReaderEffect,
+				});
+
+				TestTrue(
+					TEXT("ArmorTagReaderEffect depends on GrantArmorTagEffect"),
+					Graph.DoesEffectDependOn(this->ArmorTagReaderEffect, this->GrantArmorTagEffect)
+				);
+
+				TestFalse(
+					TEXT("GrantArmorTagEffect depends on ArmorTagReaderEffect"),
+					Graph.DoesEffectDependOn(this->GrantArmorTagEffect, this->ArmorTagReaderEffect)
+				);
+			});
+		});
+
+		Describe(TEXT("GetEffectsToReapplyOnLevelChange()"), [=, this]()
+		{
+			It(TEXT("returns GEs that take a snapshot of the output of a level-dependent GE"), [=, this]()
+			{
+				const FPF2PassiveEffectDependencyGraph Graph({
+					this->ArmorClassEffect,
+					this->ArmorClassSnapshotEffect,
+				});
+
+				const FEffectSet EffectsToReapply = Graph.GetEffectsToReapplyOnLevelChange();
+
+				TestTrue(
+					TEXT("ArmorClassSnapshotEffect is re-applied"),
+					EffectsToReapply.Contains(this->ArmorClassSnapshotEffect)
+				);
+
+				// Its level can be updated in place instead.
+				TestFalse(TEXT("ArmorClassEffect is re-applied"), EffectsToReapply.Contains(this->ArmorClassEffect));
+			});
+
+			It(TEXT("returns no GEs when no GE takes a snapshot of a level-dependent GE"), [=, this]()
+			{
+				const FPF2PassiveEffectDependencyGraph Graph({
+					this->ArmorClassSnapshotEffect,
+					this->PerceptionEffect,
+				});
+
+				TestEqual(
+					TEXT("GetEffectsToReapplyOnLevelChange().Num()"),
+					Graph.GetEffectsToReapplyOnLevelChange().Num(),
+					0
+				);
+			});
+		});
+	});
+
+	Describe(TEXT("FPF2PassiveEffectPlan"), [=, this]()
+	{
+		Describe(TEXT("when GEs are added to weight groups out of order"), [=, this]()
+		{
+			It(TEXT("puts the entries of each weight group in a single span, in weight group order"), [=, this]()
+			{
+				FEffectMap Effects;
+
+				Effects.Add(this->LateWeightGroup, this->ArmorTagReaderEffect);
+				Effects.Add(this->EarlyWeightGroup, this->GrantArmorTagEffect);
+				Effects.Add(this->LateWeightGroup, this->PerceptionEffect);
+				Effects.Add(this->EarlyWeightGroup, this->ArmorClassEffect);
+
+				const FPF2PassiveEffectPlan                Plan(Effects);
+				const TArray<FPF2PassiveEffectPlanSpan>&  Spans   = Plan.GetWeightGroupSpans();
+				const TArray<FPF2PassiveEffectPlanEntry>& Entries = Plan.GetEntries();
+
+				const bool bHasAllEntries =
+					TestEqual(TEXT("Spans.Num()"), Spans.Num(), 2) &&
+					TestEqual(TEXT("Entries.Num()"), Entries.Num(), 4);
+
+				if (bHasAllEntries)
+				{
+					TestEqual(TEXT("Spans[0].WeightGroup"), Spans[0].WeightGroup, this->EarlyWeightGroup);
+					TestEqual(TEXT("Spans[0].StartIndex"), Spans[0].StartIndex, 0);
+					TestEqual(TEXT("Spans[0].Num"), Spans[0].Num, 2);
+
+					TestEqual(TEXT("Spans[1].WeightGroup"), Spans[1].WeightGroup, this->LateWeightGroup);
+					TestEqual(TEXT("Spans[1].StartIndex"), Spans[1].StartIndex, 2);
+					TestEqual(TEXT("Spans[1].Num"), Spans[1].Num, 2);
+
+					TestEqual(
+						TEXT("Spans[0].WeightGroupOrdinal"),
+						Spans[0].WeightGroupOrdinal,
+						PF2GameplayAbilityUtilities::GetWeightGroupOrdinal(this->EarlyWeightGroup)
+					);
+
+					// GEs within the same weight group stay in the order they were added.
+					TestTrue(
+						TEXT("Entries[0] is GrantArmorTagEffect"),
+						Entries[0].ContainsEffect(this->GrantArmorTagEffect)
+					);
+					TestTrue(TEXT("Entries[1] is ArmorClassEffect"), Entries[1].ContainsEffect(this->ArmorClassEffect));
+					TestTrue(
+						TEXT("Entries[2] is ArmorTagReaderEffect"),
+						Entries[2].ContainsEffect(this->ArmorTagReaderEffect)
+					);
+					TestTrue(TEXT("Entries[3] is PerceptionEffect"), Entries[3].ContainsEffect(this->PerceptionEffect));
+				}
+			});
+		});
+
+		Describe(TEXT("when a stackable GE is added to a weight group more than once"), [=, this]()
+		{
+			It(TEXT("folds the additions in each weight group into a single entry"), [=, this]()
+			{
+				FEffectMap Effects;
+
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+				Effects.Add(this->LateWeightGroup, this->ArmorTagReaderEffect);
+
+				const FPF2PassiveEffectPlan                Plan(Effects, {this->ArmorTagReaderEffect});
+				const TArray<FPF2PassiveEffectPlanEntry>& Entries = Plan.GetEntries();
+
+				if (TestEqual(TEXT("Entries.Num()"), Entries.Num(), 2))
+				{
+					TestEqual(TEXT("Entries[0].WeightGroup"), Entries[0].WeightGroup, this->EarlyWeightGroup);
+					TestEqual(TEXT("Entries[0].Count"), Entries[0].Count, 2);
+
+					TestEqual(TEXT("Entries[1].WeightGroup"), Entries[1].WeightGroup, this->LateWeightGroup);
+					TestEqual(TEXT("Entries[1].Count"), Entries[1].Count, 1);
+				}
+			});
+
+			It(TEXT("keeps a separate entry for each addition of a GE that is not stackable"), [=, this]()
+			{
+				FEffectMap Effects;
+
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+
+				const FPF2PassiveEffectPlan                Plan(Effects);
+				const TArray<FPF2PassiveEffectPlanEntry>& Entries = Plan.GetEntries();
+
+				if (TestEqual(TEXT("Entries.Num()"), Entries.Num(), 2))
+				{
+					TestEqual(TEXT("Entries[0].Count"), Entries[0].Count, 1);
+					TestEqual(TEXT("Entries[1].Count"), Entries[1].Count, 1);
+				}
+			});
+		});
+
+		Describe(TEXT("when passive GEs are combined"), [=, this]()
+		{
+			BeforeEach([=, this]()
+			{
+				UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+
+				this->CompositeEffects = NewObject<UPF2CompositeGameplayEffectSubsystem>(GameInstance);
+			});
+
+			It(TEXT("combines consecutive independent GEs in the same weight group into a composite GE"), [=, this]()
+			{
+				FEffectMap Effects;
+
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+				Effects.Add(this->EarlyWeightGroup, this->GrantArmorTagEffect);
+
+				const FPF2PassiveEffectPlan                Plan(Effects, FEffectSet(), this->CompositeEffects);
+				const TArray<FPF2PassiveEffectPlanEntry>& Entries = Plan.GetEntries();
+
+				if (TestEqual(TEXT("Entries.Num()"), Entries.Num(), 1))
+				{
+					TestEqual(TEXT("Entries[0].Effects.Num()"), Entries[0].Effects.Num(), 2);
+					TestTrue(
+						TEXT("Entries[0] applies a composite GE"),
+						Entries[0].Definition->IsA<UPF2CompositeGameplayEffect>()
+					);
+				}
+			});
+
+			It(TEXT("starts a new run at a GE that depends on a GE already in the run"), [=, this]()
+			{
+				FEffectMap Effects;
+
+				Effects.Add(this->EarlyWeightGroup, this->GrantArmorTagEffect);
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+
+				const FPF2PassiveEffectPlan                Plan(Effects, FEffectSet(), this->CompositeEffects);
+				const TArray<FPF2PassiveEffectPlanEntry>& Entries = Plan.GetEntries();
+
+				if (TestEqual(TEXT("Entries.Num()"), Entries.Num(), 2))
+				{
+					TestEqual(TEXT("Entries[0].Effects.Num()"), Entries[0].Effects.Num(), 1);
+					TestTrue(
+						TEXT("Entries[0] is GrantArmorTagEffect"),
+						Entries[0].ContainsEffect(this->GrantArmorTagEffect)
+					);
+
+					TestEqual(TEXT("Entries[1].Effects.Num()"), Entries[1].Effects.Num(), 1);
+					TestTrue(
+						TEXT("Entries[1] is ArmorTagReaderEffect"),
+						Entries[1].ContainsEffect(this->ArmorTagReaderEffect)
+					);
+				}
+			});
+
+			It(TEXT("never combines GEs from different weight groups"), [=, this]()
+			{
+				FEffectMap Effects;
+
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+				Effects.Add(this->LateWeightGroup, this->GrantArmorTagEffect);
+
+				const FPF2PassiveEffectPlan Plan(Effects, FEffectSet(), this->CompositeEffects);
+
+				TestEqual(TEXT("GetEntries().Num()"), Plan.GetEntries().Num(), 2);
+			});
+
+			It(TEXT("never combines a GE that takes a snapshot of an attribute"), [=, this]()
+			{
+				FEffectMap Effects;
+
+				Effects.Add(this->EarlyWeightGroup, this->ArmorTagReaderEffect);
+				Effects.Add(this->EarlyWeightGroup, this->ArmorClassSnapshotEffect);
+
+				const FPF2PassiveEffectPlan Plan(Effects, FEffectSet(), this->CompositeEffects);
+
+				TestEqual(TEXT("GetEntries().Num()"), Plan.GetEntries().Num(), 2);
+			});
+		});
+	});
+}
+
+TSet<TSubclassOf<UGameplayEffect>> FPF2PassiveEffectPlanSpec::GetEffectsAffectedByTag(
+	const FPF2PassiveEffectDependencyGraph& Graph,
+	const FString&                          TagName) const
+{
+	return Graph.GetEffectsAffectedByTags(FGameplayTagContainer(PF2GameplayAbilityUtilities::GetTag(TagName)));
+}
@@ -0,0 +1,205 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Abilities/PF2AbilitySystemComponent.h"
+#include "Abilities/PF2AttributeSet.h"
+
+#include "Tests/PF2SpecBase.h"
+
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+BEGIN_DEFINE_PF_SPEC(FPF2StateSnapshotSpec,
+                     "OpenPF2.UPF2AbilitySystemComponent.StateSnapshots",
+                     EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	const FString OuterTagName = TEXT("KeyAbility.Strength");
+	const FString InnerTagName = TEXT("KeyAbility.Dexterity");
+
+	UPF2AbilitySystemComponent* Asc;
+
+	FPF2StateSnapshotHandle OuterSnapshot;
+	FPF2StateSnapshotHandle InnerSnapshot;
+
+	float GetStrength() const;
+	void SetStrength(const float Value) const;
+	bool HasTag(const FString& TagName) const;
+END_DEFINE_PF_SPEC(FPF2StateSnapshotSpec)
+
+void FPF2StateSnapshotSpec::Define()
+{
+	BeforeEach([=, this]()
+	{
+		this->SetupWorld();
+		this->SetupPawn();
+
+		this->Asc = NewObject<UPF2AbilitySystemComponent>(this->TestPawn);
+
+		this->Asc->RegisterComponent();
+		this->Asc->InitStats(UPF2AttributeSet::StaticClass(), nullptr);
+		this->Asc->InitAbilityActorInfo(this->TestPawn, this->TestPawn);
+
+		this->BeginPlay();
+
+		this->SetStrength(10.0f);
+	});
+
+	AfterEach([=, this]()
+	{
+		this->Asc = nullptr;
+
+		this->DestroyPawn();
+		this->DestroyWorld();
+	});
+
+	Describe(TEXT("when a nested snapshot is released and then the outer snapshot is restored"), [=, this]()
+	{
+		Describe(TEXT("and the state changed both before and after the nested snapshot was taken"), [=, this]()
+		{
+			BeforeEach([=, this]()
+			{
+				this->OuterSnapshot = this->Asc->TakeStateSnapshot();
+
+				this->SetStrength(20.0f);
+				this->Asc->AddDynamicTag(PF2GameplayAbilityUtilities::GetTag(this->OuterTagName));
+
+				this->InnerSnapshot = this->Asc->TakeStateSnapshot();
+
+				this->SetStrength(30.0f);
+				this->Asc->AddDynamicTag(PF2GameplayAbilityUtilities::GetTag(this->InnerTagName));
+
+				TestTrue(
+					TEXT("ReleaseStateSnapshot(InnerSnapshot)"),
+					this->Asc->ReleaseStateSnapshot(this->InnerSnapshot)
+				);
+			});
+
+			It(TEXT("keeps every change until the outer snapshot is restored"), [=, this]()
+			{
+				TestEqual(TEXT("AbStrength"), this->GetStrength(), 30.0f);
+				TestTrue(TEXT("Has outer tag"), this->HasTag(this->OuterTagName));
+				TestTrue(TEXT("Has inner tag"), this->HasTag(this->InnerTagName));
+			});
+
+			It(TEXT("restores the state from before the outer snapshot was taken"), [=, this]()
+			{
+				TestTrue(
+					TEXT("RestoreStateSnapshot(OuterSnapshot)"),
+					this->Asc->RestoreStateSnapshot(this->OuterSnapshot)
+				);
+
+				TestEqual(TEXT("AbStrength"), this->GetStrength(), 10.0f);
+				TestFalse(TEXT("Has outer tag"), this->HasTag(this->OuterTagName));
+				TestFalse(TEXT("Has inner tag"), this->HasTag(this->InnerTagName));
+			});
+
+			It(TEXT("can no longer restore the nested snapshot"), [=, this]()
+			{
+				TestFalse(
+					TEXT("RestoreStateSnapshot(InnerSnapshot)"),
+					this->Asc->RestoreStateSnapshot(this->InnerSnapshot)
+				);
+
+				TestEqual(TEXT("AbStrength"), this->GetStrength(), 30.0f);
+			});
+		});
+
+		Describe(TEXT("and the state only changed after the nested snapshot was taken"), [=, this]()
+		{
+			BeforeEach([=, this]()
+			{
+				this->OuterSnapshot = this->Asc->TakeStateSnapshot();
+				this->InnerSnapshot = this->Asc->TakeStateSnapshot();
+
+				this->SetStrength(30.0f);
+				this->Asc->AddDynamicTag(PF2GameplayAbilityUtilities::GetTag(this->InnerTagName));
+
+				TestTrue(
+					TEXT("ReleaseStateSnapshot(InnerSnapshot)"),
+					this->Asc->ReleaseStateSnapshot(this->InnerSnapshot)
+				);
+			});
+
+			It(TEXT("hands the changes recorded by the nested snapshot to the outer snapshot"), [=, this]()
+			{
+				TestTrue(
+					TEXT("RestoreStateSnapshot(OuterSnapshot)"),
+					this->Asc->RestoreStateSnapshot(this->OuterSnapshot)
+				);
+
+				TestEqual(TEXT("AbStrength"), this->GetStrength(), 10.0f);
+				TestFalse(TEXT("Has inner tag"), this->HasTag(this->InnerTagName));
+			});
+		});
+
+		Describe(TEXT("and the state changed again after the nested snapshot was released"), [=, this]()
+		{
+			BeforeEach([=, this]()
+			{
+				this->OuterSnapshot = this->Asc->TakeStateSnapshot();
+				this->InnerSnapshot = this->Asc->TakeStateSnapshot();
+
+				this->SetStrength(30.0f);
+
+				TestTrue(
+					TEXT("ReleaseStateSnapshot(InnerSnapshot)"),
+					this->Asc->ReleaseStateSnapshot(this->InnerSnapshot)
+				);
+
+				this->SetStrength(40.0f);
+			});
+
+			It(TEXT("restores the value from before the outer snapshot was taken"), [=, this]()
+			{
+				TestTrue(
+					TEXT("RestoreStateSnapshot(OuterSnapshot)"),
+					this->Asc->RestoreStateSnapshot(this->OuterSnapshot)
+				);
+
+				TestEqual(TEXT("AbStrength"), this->GetStrength(), 10.0f);
+			});
+		});
+	});
+
+	Describe(TEXT("when the outer snapshot is released"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			this->OuterSnapshot = this->Asc->TakeStateSnapshot();
+			this->InnerSnapshot = this->Asc->TakeStateSnapshot();
+
+			this->SetStrength(30.0f);
+
+			TestTrue(TEXT("ReleaseStateSnapshot(OuterSnapshot)"), this->Asc->ReleaseStateSnapshot(this->OuterSnapshot));
+		});
+
+		It(TEXT("releases the nested snapshot as well"), [=, this]()
+		{
+			TestFalse(
+				TEXT("RestoreStateSnapshot(InnerSnapshot)"),
+				this->Asc->RestoreStateSnapshot(this->InnerSnapshot)
+			);
+			TestFalse(
+				TEXT("ReleaseStateSnapshot(InnerSnapshot)"),
+				this->Asc->ReleaseStateSnapshot(this->InnerSnapshot)
+			);
+
+			TestEqual(TEXT("AbStrength"), this->GetStrength(), 30.0f);
+		});
+	});
+}
+
+float FPF2StateSnapshotSpec::GetStrength() const
+{
+	return this->Asc->GetNumericAttributeBase(UPF2AttributeSet::GetAbStrengthAttribute());
+}
+
+void FPF2StateSnapshotSpec::SetStrength(const float Value) const
+{
+	this->Asc->SetNumericAttributeBase(UPF2AttributeSet::GetAbStrengthAttribute(), Value);
+}
+
+bool FPF2StateSnapshotSpec::HasTag(const FString& TagName) const
+{
+	return this->Asc->GetActiveGameplayTags().HasTagExact(PF2GameplayAbilityUtilities::GetTag(TagName));
+}
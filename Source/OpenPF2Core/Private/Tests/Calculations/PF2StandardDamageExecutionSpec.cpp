@@ -0,0 +1,197 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <GameplayEffect.h>
+
+#include "Abilities/PF2AttributeSet.h"
+#include "Calculations/PF2StandardDamageExecution.h"
+#include "Tests/PF2SpecBase.h"
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+BEGIN_DEFINE_PF_SPEC(FPF2StandardDamageExecutionSpec,
+                     "OpenPF2.StandardDamageExecution",
+                     EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	const float StartingHitPoints = 100.0f;
+
+	const FString DamageParameterTagName     = TEXT("GameplayEffect.Parameter.Damage");
+	const FString ResistanceParameterTagName = TEXT("GameplayEffect.Parameter.Resistance");
+	const FString SlashingDamageTagName      = TEXT("DamageType.Physical.Slashing");
+	const FString PhysicalDamageTagName      = TEXT("DamageType.Physical");
+
+	UPF2AttributeSet* GetAttributeSet() const;
+
+	UGameplayEffect* CreateDamageGE(const float Damage) const;
+	UGameplayEffect* CreateDamageGE(const float Damage, const float Resistance) const;
+
+	float ApplyDamage(UGameplayEffect* Effect, const TArray<FString>& DamageTypeTagNames) const;
+END_DEFINE_PF_SPEC(FPF2StandardDamageExecutionSpec)
+
+void FPF2StandardDamageExecutionSpec::Define()
+{
+	BeforeEach([=, this]()
+	{
+		this->SetupWorld();
+		this->SetupPawn();
+
+		this->BeginPlay();
+
+		FAttributeCapture Attributes = CaptureAttributes(this->GetAttributeSet());
+
+		*(Attributes[TEXT("MaxHitPoints")]) = this->StartingHitPoints;
+		*(Attributes[TEXT("HitPoints")])    = this->StartingHitPoints;
+	});
+
+	AfterEach([=, this]()
+	{
+		this->DestroyPawn();
+		this->DestroyWorld();
+	});
+
+	Describe(TEXT("when the target is immune to the damage type"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			const FGameplayTag DamageType = PF2GameplayAbilityUtilities::GetTag(this->SlashingDamageTagName);
+
+			this->GetAttributeSet()->SetDamageTypeImmunity(DamageType, true);
+			this->GetAttributeSet()->SetDamageTypeWeakness(DamageType, 5.0f);
+		});
+
+		It(TEXT("applies immunity before weakness, so no damage is done"), [=, this]()
+		{
+			const float DamageDone = this->ApplyDamage(this->CreateDamageGE(10.0f), {this->SlashingDamageTagName});
+
+			TestEqual(TEXT("Damage done"), DamageDone, 0.0f);
+		});
+	});
+
+	Describe(TEXT("when the target has both weakness and resistance to the damage type"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			const FGameplayTag DamageType = PF2GameplayAbilityUtilities::GetTag(this->SlashingDamageTagName);
+
+			this->GetAttributeSet()->SetDamageTypeWeakness(DamageType, 5.0f);
+			this->GetAttributeSet()->SetDamageTypeResistance(DamageType, 6.0f);
+		});
+
+		It(TEXT("applies weakness before resistance"), [=, this]()
+		{
+			// Resistance first would floor the damage at 0 before weakness adds 5 (i.e., 5 damage instead of 1).
+			const float DamageDone = this->ApplyDamage(this->CreateDamageGE(2.0f), {this->SlashingDamageTagName});
+
+			TestEqual(TEXT("Damage done"), DamageDone, 1.0f);
+		});
+	});
+
+	Describe(TEXT("when the resistance of the target exceeds the damage"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			const FGameplayTag DamageType = PF2GameplayAbilityUtilities::GetTag(this->SlashingDamageTagName);
+
+			this->GetAttributeSet()->SetDamageTypeResistance(DamageType, 10.0f);
+		});
+
+		It(TEXT("reduces the damage to 0 instead of healing the target"), [=, this]()
+		{
+			const float DamageDone = this->ApplyDamage(this->CreateDamageGE(3.0f), {this->SlashingDamageTagName});
+
+			TestEqual(TEXT("Damage done"), DamageDone, 0.0f);
+		});
+	});
+
+	Describe(TEXT("when the GE supplies the resistance of the target as a parameter"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			const FGameplayTag DamageType = PF2GameplayAbilityUtilities::GetTag(this->SlashingDamageTagName);
+
+			this->GetAttributeSet()->SetDamageTypeResistance(DamageType, 5.0f);
+		});
+
+		It(TEXT("uses the resistance parameter instead of the resistance in the damage type table"), [=, this]()
+		{
+			const float DamageDone =
+				this->ApplyDamage(this->CreateDamageGE(10.0f, 2.0f), {this->SlashingDamageTagName});
+
+			TestEqual(TEXT("Damage done"), DamageDone, 8.0f);
+		});
+	});
+
+	Describe(TEXT("when the GE is tagged with both a damage category and a type within it"), [=, this]()
+	{
+		BeforeEach([=, this]()
+		{
+			const FGameplayTag DamageType = PF2GameplayAbilityUtilities::GetTag(this->SlashingDamageTagName);
+
+			this->GetAttributeSet()->SetDamageTypeResistance(DamageType, 4.0f);
+		});
+
+		It(TEXT("uses the defenses of the most specific damage type"), [=, this]()
+		{
+			const float DamageDone =
+				this->ApplyDamage(
+					this->CreateDamageGE(10.0f),
+					{this->PhysicalDamageTagName, this->SlashingDamageTagName}
+				);
+
+			TestEqual(TEXT("Damage done"), DamageDone, 6.0f);
+		});
+	});
+}
+
+UPF2AttributeSet* FPF2StandardDamageExecutionSpec::GetAttributeSet() const
+{
+	return const_cast<UPF2AttributeSet*>(this->PawnAbilityComponent->GetSet<UPF2AttributeSet>());
+}
+
+UGameplayEffect* FPF2StandardDamageExecutionSpec::CreateDamageGE(const float Damage) const
+{
+	UGameplayEffect*                           Effect = NewObject<UGameplayEffect>(GetTransientPackage());
+	FGameplayEffectExecutionDefinition         Execution;
+	FGameplayEffectExecutionScopedModifierInfo DamageModifier(
+		PF2GameplayAbilityUtilities::GetTag(this->DamageParameterTagName)
+	);
+
+	DamageModifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(Damage));
+
+	Execution.CalculationClass = UPF2StandardDamageExecution::StaticClass();
+	Execution.CalculationModifiers.Add(DamageModifier);
+
+	Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+	Effect->Executions.Add(Execution);
+
+	return Effect;
+}
+
+UGameplayEffect* FPF2StandardDamageExecutionSpec::CreateDamageGE(const float Damage, const float Resistance) const
+{
+	UGameplayEffect*                           Effect = this->CreateDamageGE(Damage);
+	FGameplayEffectExecutionScopedModifierInfo ResistanceModifier(
+		PF2GameplayAbilityUtilities::GetTag(this->ResistanceParameterTagName)
+	);
+
+	ResistanceModifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(Resistance));
+
+	Effect->Executions[0].CalculationModifiers.Add(ResistanceModifier);
+
+	return Effect;
+}
+
+float FPF2StandardDamageExecutionSpec::ApplyDamage(UGameplayEffect*       Effect,
+                                                   const TArray<FString>& DamageTypeTagNames) const
+{
+	FGameplayEffectSpec Spec(Effect, this->PawnAbilityComponent->MakeEffectContext(), 1.0f);
+
+	for (const FString& DamageTypeTagName : DamageTypeTagNames)
+	{
+		Spec.AddDynamicAssetTag(PF2GameplayAbilityUtilities::GetTag(DamageTypeTagName));
+	}
+
+	this->PawnAbilityComponent->ApplyGameplayEffectSpecToSelf(Spec);
+
+	return this->StartingHitPoints - this->GetAttributeSet()->GetHitPoints();
+}
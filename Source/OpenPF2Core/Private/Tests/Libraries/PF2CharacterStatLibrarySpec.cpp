@@ -67,6 +67,11 @@ void FPF2CharacterStatLibrarySpec::Define()
 			{ 18, 1, 1 },
 			{ 10, 5, 9 },
 			{ 10, 0, 0 },
+			{ 10, 4, 8 },
+			{  8, 6, 11 },
+			{ 16, 3, 4 },
+			{ 17, 2, 3 },
+			{ 20, 3, 3 },
 		};
 
 		for (const auto& CurrentTestParameters : TestParameters)
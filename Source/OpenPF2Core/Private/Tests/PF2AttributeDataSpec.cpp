@@ -0,0 +1,153 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <HAL/IConsoleManager.h>
+#include <UObject/CoreNet.h>
+
+#include "Abilities/PF2AttributeData.h"
+#include "Tests/PF2SpecBase.h"
+
+BEGIN_DEFINE_PF_SPEC(FPF2AttributeDataSpec,
+                     "OpenPF2.AttributeData",
+                     EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	struct FAttributeValueTestTuple
+	{
+		FString Description;
+		float   BaseValue;
+		float   CurrentValue;
+	};
+
+	const TArray<FAttributeValueTestTuple> TestValues = {
+		{ TEXT("zero"),                                           0.0f,        0.0f         },
+		{ TEXT("a small whole number"),                           5.0f,        5.0f         },
+		{ TEXT("a negative whole number"),                        -4.0f,       -4.0f        },
+		{ TEXT("a current value that differs from the base"),     12.0f,       -3.0f        },
+		{ TEXT("a large whole number"),                           12345.0f,    -54321.0f    },
+		{ TEXT("the largest exactly-representable whole number"), 16777216.0f, -16777216.0f },
+		{ TEXT("a whole number too large to quantize"),           33554432.0f, 1.0e20f      },
+		{ TEXT("a fractional base value"),                        2.5f,        2.5f         },
+		{ TEXT("a fractional current value"),                     10.0f,       7.25f        },
+		{ TEXT("a negative fractional value"),                    -0.5f,       -1.75f       },
+	};
+
+	FPF2AttributeData RoundTrip(const FPF2AttributeData& Source, int64& OutNumBits);
+	static void SetQuantizeAttributes(const bool bQuantize);
+END_DEFINE_PF_SPEC(FPF2AttributeDataSpec)
+
+void FPF2AttributeDataSpec::Define()
+{
+	AfterEach([=, this]()
+	{
+		SetQuantizeAttributes(true);
+	});
+
+	for (const bool bQuantize : {true, false})
+	{
+		const FString QuantizeDescription =
+			bQuantize ? TEXT("when attributes are quantized") : TEXT("when attributes are not quantized");
+
+		Describe(QuantizeDescription, [=, this]()
+		{
+			BeforeEach([=, this]()
+			{
+				SetQuantizeAttributes(bQuantize);
+			});
+
+			for (const FAttributeValueTestTuple& TestValue : this->TestValues)
+			{
+				const FString Description  = TestValue.Description;
+				const float   BaseValue    = TestValue.BaseValue,
+				              CurrentValue = TestValue.CurrentValue;
+
+				It(FString::Format(TEXT("replicates {0} without any loss of precision"), {Description}), [=, this]()
+				{
+					FPF2AttributeData Source(BaseValue);
+					int64             NumBits;
+
+					Source.SetCurrentValue(CurrentValue);
+
+					const FPF2AttributeData Result = this->RoundTrip(Source, NumBits);
+
+					TestEqual(TEXT("BaseValue"), Result.GetBaseValue(), BaseValue);
+					TestEqual(TEXT("CurrentValue"), Result.GetCurrentValue(), CurrentValue);
+				});
+			}
+		});
+	}
+
+	Describe(TEXT("when the current value matches the base value"), [=, this]()
+	{
+		It(TEXT("sends a whole number in fewer bits than a single float"), [=, this]()
+		{
+			int64                   NumBits;
+			const FPF2AttributeData Result = this->RoundTrip(FPF2AttributeData(-3.0f), NumBits);
+
+			TestEqual(TEXT("CurrentValue"), Result.GetCurrentValue(), -3.0f);
+			TestTrue(FString::Format(TEXT("{0} bits < 32 bits"), {NumBits}), NumBits < 32);
+		});
+
+		It(TEXT("sends a fractional number as only one float"), [=, this]()
+		{
+			int64                   NumBits;
+			const FPF2AttributeData Result = this->RoundTrip(FPF2AttributeData(0.5f), NumBits);
+
+			TestEqual(TEXT("CurrentValue"), Result.GetCurrentValue(), 0.5f);
+			TestTrue(FString::Format(TEXT("{0} bits < 64 bits"), {NumBits}), NumBits < 64);
+		});
+
+		It(TEXT("restores the current value over a stale current value on the receiving side"), [=, this]()
+		{
+			FNetBitWriter     Writer(nullptr, 256);
+			FPF2AttributeData Source(8.0f),
+			                  Destination(1.0f);
+			bool              bSuccess = false;
+
+			Destination.SetCurrentValue(4.0f);
+
+			Source.NetSerialize(Writer, nullptr, bSuccess);
+
+			FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+
+			Destination.NetSerialize(Reader, nullptr, bSuccess);
+
+			TestTrue(TEXT("bSuccess"), bSuccess);
+			TestEqual(TEXT("BaseValue"), Destination.GetBaseValue(), 8.0f);
+			TestEqual(TEXT("CurrentValue"), Destination.GetCurrentValue(), 8.0f);
+		});
+	});
+}
+
+FPF2AttributeData FPF2AttributeDataSpec::RoundTrip(const FPF2AttributeData& Source, int64& OutNumBits)
+{
+	FNetBitWriter     Writer(nullptr, 256);
+	FPF2AttributeData Written = Source,
+	                  Result;
+	bool              bWriteSuccess = false,
+	                  bReadSuccess  = false;
+
+	Written.NetSerialize(Writer, nullptr, bWriteSuccess);
+
+	OutNumBits = Writer.GetNumBits();
+
+	FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+
+	Result.NetSerialize(Reader, nullptr, bReadSuccess);
+
+	TestTrue(TEXT("Wrote value successfully"), bWriteSuccess);
+	TestTrue(TEXT("Read value successfully"), bReadSuccess);
+	TestTrue(TEXT("Read every bit that was written"), Reader.AtEnd());
+
+	return Result;
+}
+
+void FPF2AttributeDataSpec::SetQuantizeAttributes(const bool bQuantize)
+{
+	IConsoleVariable* QuantizeVariable =
+		IConsoleManager::Get().FindConsoleVariable(TEXT("OpenPF2.QuantizeAttributes"));
+
+	check(QuantizeVariable != nullptr);
+
+	QuantizeVariable->Set(bQuantize, ECVF_SetByCode);
+}
@@ -0,0 +1,124 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <GameplayEffect.h>
+
+#include "PF2CharacterConstants.h"
+#include "Tests/PF2SpecBase.h"
+
+BEGIN_DEFINE_PF_SPEC(FPF2CharacterConstantsSpec,
+                     "OpenPF2.CharacterConstants",
+                     EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	const TArray<FName> ExpectedCoreEffectNames = {
+		TEXT("GE_ApplyBaseCharacterStats"),
+		TEXT("GE_GrantCharacterBaseAbilities"),
+		TEXT("GE_CalcKeyAbilityBoost"),
+		TEXT("GE_CalcAbilityModifiers"),
+		TEXT("GE_CalcClassDifficultyClass"),
+		TEXT("GE_CalcArmorClass"),
+		TEXT("GE_CalcPerceptionModifier"),
+		TEXT("GE_CalcSavingThrowModifiers"),
+		TEXT("GE_CalcSpellAttackRoll"),
+		TEXT("GE_CalcSpellDifficultyClass"),
+		TEXT("GE_CalcSkillModifiers"),
+		TEXT("GE_CalcAncestryFeatLimit"),
+	};
+
+	TArray<FName> GetCoreEffectNames() const;
+END_DEFINE_PF_SPEC(FPF2CharacterConstantsSpec)
+
+void FPF2CharacterConstantsSpec::Define()
+{
+	Describe(TEXT("GeCoreCharacterBlueprintPaths"), [=, this]()
+	{
+		It(TEXT("lists every core GE, including GEs that share a sub-folder with another GE"), [=, this]()
+		{
+			const TArray<FName> CoreEffectNames = this->GetCoreEffectNames();
+
+			if (TestEqual(TEXT("Core GE count"), CoreEffectNames.Num(), this->ExpectedCoreEffectNames.Num()))
+			{
+				for (int32 EffectIndex = 0; EffectIndex < CoreEffectNames.Num(); ++EffectIndex)
+				{
+					TestEqual(
+						FString::Format(TEXT("Core GE {0}"), {EffectIndex}),
+						CoreEffectNames[EffectIndex].ToString(),
+						this->ExpectedCoreEffectNames[EffectIndex].ToString()
+					);
+				}
+			}
+		});
+
+		It(TEXT("lists each core GE only once"), [=, this]()
+		{
+			TSet<FName> UniqueEffectNames;
+
+			for (const FName& EffectName : this->GetCoreEffectNames())
+			{
+				bool bIsAlreadyListed;
+
+				UniqueEffectNames.Add(EffectName, &bIsAlreadyListed);
+
+				TestFalse(
+					FString::Format(TEXT("{0} is listed more than once"), {EffectName.ToString()}),
+					bIsAlreadyListed
+				);
+			}
+		});
+
+		It(TEXT("points to a GE blueprint that exists for each core GE"), [=, this]()
+		{
+			for (const TTuple<FString, FName>& EffectInfo : PF2CharacterConstants::GeCoreCharacterBlueprintPaths)
+			{
+				const FString Subfolder  = EffectInfo.Key;
+				const FName   EffectName = EffectInfo.Value;
+				const FString EffectPath = PF2CharacterConstants::GetBlueprintPath(EffectName, Subfolder);
+
+				const TSubclassOf<UGameplayEffect> GameplayEffect =
+					TSoftClassPtr<UGameplayEffect>(FSoftObjectPath(EffectPath)).LoadSynchronous();
+
+				TestNotNull(EffectPath, GameplayEffect.Get());
+			}
+		});
+	});
+
+	Describe(TEXT("GeCoreCharacterAttributeGroups"), [=, this]()
+	{
+		It(TEXT("only assigns a group to GEs that are core GEs"), [=, this]()
+		{
+			const TArray<FName> CoreEffectNames = this->GetCoreEffectNames();
+
+			for (const TTuple<FName, EPF2AttributeGroup>& EffectGroup :
+			     PF2CharacterConstants::GeCoreCharacterAttributeGroups)
+			{
+				const FName EffectName = EffectGroup.Key;
+
+				TestTrue(
+					FString::Format(TEXT("{0} is a core GE"), {EffectName.ToString()}),
+					CoreEffectNames.Contains(EffectName)
+				);
+			}
+		});
+
+		It(TEXT("does not let characters opt out of the key ability boost GE"), [=, this]()
+		{
+			TestFalse(
+				TEXT("GE_CalcKeyAbilityBoost has a group other than Core"),
+				PF2CharacterConstants::GeCoreCharacterAttributeGroups.Contains(TEXT("GE_CalcKeyAbilityBoost"))
+			);
+		});
+	});
+}
+
+TArray<FName> FPF2CharacterConstantsSpec::GetCoreEffectNames() const
+{
+	TArray<FName> EffectNames;
+
+	for (const TTuple<FString, FName>& EffectInfo : PF2CharacterConstants::GeCoreCharacterBlueprintPaths)
+	{
+		EffectNames.Add(EffectInfo.Value);
+	}
+
+	return EffectNames;
+}
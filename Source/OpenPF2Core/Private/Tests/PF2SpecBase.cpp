@@ -5,6 +5,7 @@
 
 #include "Tests/PF2SpecBase.h"
 
+#include "Abilities/PF2AttributeRegistry.h"
 #include "Abilities/PF2AttributeSet.h"
 #include "Utilities/PF2GameplayAbilityUtilities.h"
 
@@ -22,107 +23,67 @@ TSubclassOf<BlueprintType> FPF2SpecBase::LoadBlueprint(const FString FolderPath,
 
 FAttributeCapture FPF2SpecBase::CaptureAttributes(const UPF2AttributeSet* AttributeSet)
 {
-	FAttributeCapture Capture =
+	FAttributeCapture Capture;
+
+	for (int32 AttributeIndex = 0; AttributeIndex < PF2AttributeRegistry::Num; ++AttributeIndex)
 	{
-		{ TEXT("Experience"),           const_cast<FGameplayAttributeData *>(&AttributeSet->Experience)           },
-		{ TEXT("AbBoostCount"),         const_cast<FGameplayAttributeData *>(&AttributeSet->AbBoostCount)         },
-		{ TEXT("AbBoostLimit"),         const_cast<FGameplayAttributeData *>(&AttributeSet->AbBoostLimit)         },
-		{ TEXT("ClassDifficultyClass"), const_cast<FGameplayAttributeData *>(&AttributeSet->ClassDifficultyClass) },
-		{ TEXT("Speed"),                const_cast<FGameplayAttributeData *>(&AttributeSet->Speed)                },
-		{ TEXT("MaxSpeed"),             const_cast<FGameplayAttributeData *>(&AttributeSet->MaxSpeed)             },
-		{ TEXT("ArmorClass"),           const_cast<FGameplayAttributeData *>(&AttributeSet->ArmorClass)           },
-		{ TEXT("HitPoints"),            const_cast<FGameplayAttributeData *>(&AttributeSet->HitPoints)            },
-		{ TEXT("MaxHitPoints"),         const_cast<FGameplayAttributeData *>(&AttributeSet->MaxHitPoints)         },
-		{ TEXT("PerceptionModifier"),   const_cast<FGameplayAttributeData *>(&AttributeSet->PerceptionModifier)   },
-		{ TEXT("FeAncestryFeatCount"),  const_cast<FGameplayAttributeData *>(&AttributeSet->FeAncestryFeatCount)  },
-		{ TEXT("FeAncestryFeatLimit"),  const_cast<FGameplayAttributeData *>(&AttributeSet->FeAncestryFeatLimit)  },
-		{ TEXT("TmpDamageIncoming"),    const_cast<FGameplayAttributeData *>(&AttributeSet->TmpDamageIncoming)    },
-	};
-
-	Capture.Append(CaptureAbilityAttributes(AttributeSet));
-	Capture.Append(CaptureAbilityModifierAttributes(AttributeSet));
-	Capture.Append(CaptureSavingThrowAttributes(AttributeSet));
-	Capture.Append(CaptureSkillModifierAttributes(AttributeSet));
-	Capture.Append(CaptureSpellAttributes(AttributeSet));
+		const EPF2AttributeIndex Index = static_cast<EPF2AttributeIndex>(AttributeIndex);
+
+		Capture.Add(
+			PF2AttributeRegistry::GetName(Index).ToString(),
+			PF2AttributeRegistry::GetAttribute(Index).GetGameplayAttributeData(
+				const_cast<UPF2AttributeSet*>(AttributeSet)
+			)
+		);
+	}
 
 	return Capture;
 }
 
 FAttributeCapture FPF2SpecBase::CaptureAbilityAttributes(const UPF2AttributeSet* AttributeSet)
 {
-	FAttributeCapture Capture =
-	{
-		{ TEXT("AbCharisma"),     const_cast<FGameplayAttributeData *>(&AttributeSet->AbCharisma) },
-		{ TEXT("AbConstitution"), const_cast<FGameplayAttributeData *>(&AttributeSet->AbConstitution) },
-		{ TEXT("AbDexterity"),    const_cast<FGameplayAttributeData *>(&AttributeSet->AbDexterity) },
-		{ TEXT("AbIntelligence"), const_cast<FGameplayAttributeData *>(&AttributeSet->AbIntelligence) },
-		{ TEXT("AbStrength"),     const_cast<FGameplayAttributeData *>(&AttributeSet->AbStrength) },
-		{ TEXT("AbWisdom"),       const_cast<FGameplayAttributeData *>(&AttributeSet->AbWisdom) },
-	};
-
-	return Capture;
+	return CaptureAttributesInCategory(AttributeSet, EPF2AttributeCategory::Ability);
 }
 
 FAttributeCapture FPF2SpecBase::CaptureAbilityModifierAttributes(const UPF2AttributeSet* AttributeSet)
 {
-	FAttributeCapture Capture =
-	{
-		{ TEXT("AbCharismaModifier"),     const_cast<FGameplayAttributeData *>(&AttributeSet->AbCharismaModifier) },
-		{ TEXT("AbConstitutionModifier"), const_cast<FGameplayAttributeData *>(&AttributeSet->AbConstitutionModifier) },
-		{ TEXT("AbDexterityModifier"),    const_cast<FGameplayAttributeData *>(&AttributeSet->AbDexterityModifier) },
-		{ TEXT("AbIntelligenceModifier"), const_cast<FGameplayAttributeData *>(&AttributeSet->AbIntelligenceModifier) },
-		{ TEXT("AbStrengthModifier"),     const_cast<FGameplayAttributeData *>(&AttributeSet->AbStrengthModifier) },
-		{ TEXT("AbWisdomModifier"),       const_cast<FGameplayAttributeData *>(&AttributeSet->AbWisdomModifier) },
-	};
-	return Capture;
+	return CaptureAttributesInCategory(AttributeSet, EPF2AttributeCategory::AbilityModifier);
 }
 
 FAttributeCapture FPF2SpecBase::CaptureSavingThrowAttributes(const UPF2AttributeSet* AttributeSet)
 {
-	FAttributeCapture Capture =
-	{
-		{ TEXT("StFortitudeModifier"), const_cast<FGameplayAttributeData *>(&AttributeSet->StFortitudeModifier) },
-		{ TEXT("StReflexModifier"),    const_cast<FGameplayAttributeData *>(&AttributeSet->StReflexModifier) },
-		{ TEXT("StWillModifier"),      const_cast<FGameplayAttributeData *>(&AttributeSet->StWillModifier) },
-	};
-
-	return Capture;
+	return CaptureAttributesInCategory(AttributeSet, EPF2AttributeCategory::SavingThrow);
 }
 
 FAttributeCapture FPF2SpecBase::CaptureSkillModifierAttributes(const UPF2AttributeSet* AttributeSet)
 {
-	FAttributeCapture Capture =
-	{
-		{ TEXT("SkAcrobaticsModifier"),   const_cast<FGameplayAttributeData *>(&AttributeSet->SkAcrobaticsModifier) },
-		{ TEXT("SkArcanaModifier"),       const_cast<FGameplayAttributeData *>(&AttributeSet->SkArcanaModifier) },
-		{ TEXT("SkAthleticsModifier"),    const_cast<FGameplayAttributeData *>(&AttributeSet->SkAthleticsModifier) },
-		{ TEXT("SkCraftingModifier"),     const_cast<FGameplayAttributeData *>(&AttributeSet->SkCraftingModifier) },
-		{ TEXT("SkDeceptionModifier"),    const_cast<FGameplayAttributeData *>(&AttributeSet->SkDeceptionModifier) },
-		{ TEXT("SkDiplomacyModifier"),    const_cast<FGameplayAttributeData *>(&AttributeSet->SkDiplomacyModifier) },
-		{ TEXT("SkIntimidationModifier"), const_cast<FGameplayAttributeData *>(&AttributeSet->SkIntimidationModifier) },
-		{ TEXT("SkLore1Modifier"),        const_cast<FGameplayAttributeData *>(&AttributeSet->SkLore1Modifier) },
-		{ TEXT("SkLore2Modifier"),        const_cast<FGameplayAttributeData *>(&AttributeSet->SkLore2Modifier) },
-		{ TEXT("SkMedicineModifier"),     const_cast<FGameplayAttributeData *>(&AttributeSet->SkMedicineModifier) },
-		{ TEXT("SkNatureModifier"),       const_cast<FGameplayAttributeData *>(&AttributeSet->SkNatureModifier) },
-		{ TEXT("SkOccultismModifier"),    const_cast<FGameplayAttributeData *>(&AttributeSet->SkOccultismModifier) },
-		{ TEXT("SkPerformanceModifier"),  const_cast<FGameplayAttributeData *>(&AttributeSet->SkPerformanceModifier) },
-		{ TEXT("SkReligionModifier"),     const_cast<FGameplayAttributeData *>(&AttributeSet->SkReligionModifier) },
-		{ TEXT("SkSocietyModifier"),      const_cast<FGameplayAttributeData *>(&AttributeSet->SkSocietyModifier) },
-		{ TEXT("SkStealthModifier"),      const_cast<FGameplayAttributeData *>(&AttributeSet->SkStealthModifier) },
-		{ TEXT("SkSurvivalModifier"),     const_cast<FGameplayAttributeData *>(&AttributeSet->SkSurvivalModifier) },
-		{ TEXT("SkThieveryModifier"),     const_cast<FGameplayAttributeData *>(&AttributeSet->SkThieveryModifier) },
-	};
-
-	return Capture;
+	return CaptureAttributesInCategory(AttributeSet, EPF2AttributeCategory::Skill);
 }
 
 FAttributeCapture FPF2SpecBase::CaptureSpellAttributes(const UPF2AttributeSet* AttributeSet)
 {
-	FAttributeCapture Capture =
+	return CaptureAttributesInCategory(AttributeSet, EPF2AttributeCategory::Spell);
+}
+
+FAttributeCapture FPF2SpecBase::CaptureAttributesInCategory(const UPF2AttributeSet*     AttributeSet,
+                                                            const EPF2AttributeCategory Category)
+{
+	FAttributeCapture Capture;
+
+	for (int32 AttributeIndex = 0; AttributeIndex < PF2AttributeRegistry::Num; ++AttributeIndex)
 	{
-		{ TEXT("SpellAttackRoll"),      const_cast<FGameplayAttributeData *>(&AttributeSet->SpellAttackRoll) },
-		{ TEXT("SpellDifficultyClass"), const_cast<FGameplayAttributeData *>(&AttributeSet->SpellDifficultyClass) },
-	};
+		const EPF2AttributeIndex Index = static_cast<EPF2AttributeIndex>(AttributeIndex);
+
+		if (PF2AttributeRegistry::GetCategory(Index) == Category)
+		{
+			Capture.Add(
+				PF2AttributeRegistry::GetName(Index).ToString(),
+				PF2AttributeRegistry::GetAttribute(Index).GetGameplayAttributeData(
+					const_cast<UPF2AttributeSet*>(AttributeSet)
+				)
+			);
+		}
+	}
 
 	return Capture;
 }
@@ -120,6 +120,9 @@ protected:
 	static FAttributeCapture CaptureSkillModifierAttributes(const UPF2AttributeSet* AttributeSet);
 	static FAttributeCapture CaptureSpellAttributes(const UPF2AttributeSet* AttributeSet);
 
+	static FAttributeCapture CaptureAttributesInCategory(const UPF2AttributeSet*     AttributeSet,
+	                                                     const EPF2AttributeCategory Category);
+
 	void SetupWorld();
 	void BeginPlay() const;
 	void DestroyWorld() const;
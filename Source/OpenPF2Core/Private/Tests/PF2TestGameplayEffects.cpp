@@ -0,0 +1,68 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include "Tests/PF2TestGameplayEffects.h"
+
+#include "Abilities/PF2AttributeSet.h"
+
+#include "Utilities/PF2GameplayAbilityUtilities.h"
+
+UPF2TestGrantArmorTagEffect::UPF2TestGrantArmorTagEffect(const FObjectInitializer& ObjectInitializer) :
+	Super(ObjectInitializer)
+{
+	const FGameplayTag    GrantedTag = PF2GameplayAbilityUtilities::GetTag(FName(TEXT("Armor.Equipped.Light")));
+	FGameplayModifierInfo Modifier;
+
+	this->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	Modifier.Attribute         = UPF2AttributeSet::GetSpeedAttribute();
+	Modifier.ModifierOp        = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(0.0f));
+
+	Modifier.SourceTags.RequireTags.AddTag(PF2GameplayAbilityUtilities::GetTag(FName(TEXT("Trait.Creature.Elf"))));
+
+	this->Modifiers.Add(Modifier);
+
+	this->InheritableOwnedTagsContainer.Added.AddTag(GrantedTag);
+	this->InheritableOwnedTagsContainer.CombinedTags.AddTag(GrantedTag);
+}
+
+UPF2TestArmorTagReaderEffect::UPF2TestArmorTagReaderEffect(const FObjectInitializer& ObjectInitializer) :
+	Super(ObjectInitializer)
+{
+	FGameplayModifierInfo Modifier;
+
+	this->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	Modifier.Attribute         = UPF2AttributeSet::GetSpeedAttribute();
+	Modifier.ModifierOp        = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(5.0f));
+
+	Modifier.SourceTags.RequireTags.AddTag(PF2GameplayAbilityUtilities::GetTag(FName(TEXT("Armor.Equipped.Light"))));
+
+	this->Modifiers.Add(Modifier);
+}
+
+UPF2TestArmorClassSnapshotEffect::UPF2TestArmorClassSnapshotEffect(const FObjectInitializer& ObjectInitializer) :
+	Super(ObjectInitializer)
+{
+	FAttributeBasedFloat  Magnitude;
+	FGameplayModifierInfo Modifier;
+
+	this->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	Magnitude.Coefficient      = FScalableFloat(1.0f);
+	Magnitude.BackingAttribute = FGameplayEffectAttributeCaptureDefinition(
+		UPF2AttributeSet::GetArmorClassAttribute(),
+		EGameplayEffectAttributeCaptureSource::Source,
+		true
+	);
+
+	Modifier.Attribute         = UPF2AttributeSet::GetMaxHitPointsAttribute();
+	Modifier.ModifierOp        = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(Magnitude);
+
+	this->Modifiers.Add(Modifier);
+}
@@ -10,7 +10,10 @@
 #include <GameplayEffectExtension.h>
 #include <GameFramework/Pawn.h>
 #include <GameFramework/PlayerController.h>
+#include <GameplayTagsManager.h>
+#include <Misc/ScopeRWLock.h>
 
+#include "OpenPF2Core.h"
 #include "PF2CharacterInterface.h"
 #include "Abilities/PF2CharacterAbilitySystemComponentInterface.h"
 
@@ -30,7 +33,16 @@ namespace PF2GameplayAbilityUtilities
 		return CaptureDefinition;
 	}
 
-	FName GetWeightGroupOfGameplayEffect(const TSubclassOf<UGameplayEffect> GameplayEffect, const FName DefaultWeight)
+	/**
+	 * Reads the name of the weight group tag of the given GE, without consulting or updating the cache.
+	 *
+	 * @param GameplayEffect
+	 *	The effect for which a weight group is desired.
+	 *
+	 * @return
+	 *	The name of the weight group for the effect; or NAME_None if the GE does not have a weight group tag.
+	 */
+	FName ReadWeightGroupOfGameplayEffect(const TSubclassOf<UGameplayEffect> GameplayEffect)
 	{
 		FName                  WeightGroup;
 		const FGameplayTag     WeightTagParent = GetTag(FName(TEXT("GameplayEffect.WeightGroup")));
@@ -41,7 +53,7 @@ namespace PF2GameplayAbilityUtilities
 
 		if (WeightTags.IsEmpty())
 		{
-			WeightGroup = DefaultWeight;
+			WeightGroup = NAME_None;
 		}
 		else
 		{
@@ -65,6 +77,226 @@ namespace PF2GameplayAbilityUtilities
 		return WeightGroup;
 	}
 
+	FName GetWeightGroupOfGameplayEffect(const TSubclassOf<UGameplayEffect> GameplayEffect, const FName DefaultWeight)
+	{
+		// GE definitions don't change at runtime, so the tag of each GE only needs to be examined once. A weak pointer
+		// is used as the key so that a GE class that gets unloaded cannot be confused for a new GE class that later
+		// occupies the same memory. Passive effect plans can be built off the game thread, so the cache is guarded by
+		// a lock.
+		static TMap<TWeakObjectPtr<UClass>, FName> WeightGroupCache;
+		static FRWLock                             WeightGroupCacheLock;
+
+		const TWeakObjectPtr<UClass> EffectType = GameplayEffect.Get();
+		FName                        WeightGroup;
+		bool                         bIsCached;
+
+		{
+			FReadScopeLock ReadLock(WeightGroupCacheLock);
+			const FName*   CachedWeightGroup = WeightGroupCache.Find(EffectType);
+
+			bIsCached = (CachedWeightGroup != nullptr);
+
+			if (bIsCached)
+			{
+				WeightGroup = *CachedWeightGroup;
+			}
+		}
+
+		if (!bIsCached)
+		{
+			WeightGroup = ReadWeightGroupOfGameplayEffect(GameplayEffect);
+
+			FWriteScopeLock WriteLock(WeightGroupCacheLock);
+
+			// Entries for GE classes that have since been unloaded (e.g., Blueprints that were recompiled in the editor)
+			// are dropped whenever a new GE is cached, so the cache only ever holds about as many entries as there are
+			// GE classes loaded.
+			for (auto CacheIterator = WeightGroupCache.CreateIterator(); CacheIterator; ++CacheIterator)
+			{
+				if (CacheIterator.Key().IsStale())
+				{
+					CacheIterator.RemoveCurrent();
+				}
+			}
+
+			WeightGroupCache.Add(EffectType, WeightGroup);
+		}
+
+		if (WeightGroup.IsNone())
+		{
+			WeightGroup = DefaultWeight;
+		}
+
+		return WeightGroup;
+	}
+
+	int32 GetWeightGroupOrdinal(const FName WeightGroup)
+	{
+		// Weight groups are gameplay tags, so this cache cannot hold more entries than there are weight group tags.
+		static TMap<FName, int32> OrdinalCache;
+		static FRWLock            OrdinalCacheLock;
+
+		int32 Ordinal;
+		bool  bIsCached;
+
+		{
+			FReadScopeLock ReadLock(OrdinalCacheLock);
+			const int32*   CachedOrdinal = OrdinalCache.Find(WeightGroup);
+
+			bIsCached = (CachedOrdinal != nullptr);
+
+			if (bIsCached)
+			{
+				Ordinal = *CachedOrdinal;
+			}
+		}
+
+		if (!bIsCached)
+		{
+			const FString WeightGroupString = WeightGroup.ToString();
+			FString       GroupName,
+			              OrdinalString;
+			int32         LastSeparatorIndex;
+			bool          bHasOrdinalPrefix;
+
+			if (WeightGroupString.FindLastChar(TEXT('.'), LastSeparatorIndex))
+			{
+				GroupName = WeightGroupString.RightChop(LastSeparatorIndex + 1);
+			}
+			else
+			{
+				GroupName = WeightGroupString;
+			}
+
+			bHasOrdinalPrefix = GroupName.Split(TEXT("_"), &OrdinalString, nullptr) && OrdinalString.IsNumeric();
+
+			if (bHasOrdinalPrefix)
+			{
+				Ordinal = FCString::Atoi(*OrdinalString);
+			}
+			else
+			{
+				UE_LOG(
+					LogPf2CoreAbilities,
+					Error,
+					TEXT("Weight group ('%s') should start with a numeric prefix that controls its order (e.g., '15_'). It will be applied after all weight groups that have a prefix, in name order."),
+					*WeightGroupString
+				);
+
+				// Digits sort before letters, so this keeps groups without a prefix in the same place relative to groups
+				// with a prefix as when weight groups were only ordered by name.
+				Ordinal = MAX_int32;
+			}
+
+			FWriteScopeLock WriteLock(OrdinalCacheLock);
+			OrdinalCache.Add(WeightGroup, Ordinal);
+		}
+
+		return Ordinal;
+	}
+
+	bool IsWeightGroupBefore(const FName WeightGroupA,
+	                         const int32 OrdinalA,
+	                         const FName WeightGroupB,
+	                         const int32 OrdinalB)
+	{
+		if (OrdinalA != OrdinalB)
+		{
+			return OrdinalA < OrdinalB;
+		}
+		else
+		{
+			return WeightGroupA.LexicalLess(WeightGroupB);
+		}
+	}
+
+	/**
+	 * The damage type tags known to the project, along with the ordinal of each one.
+	 */
+	struct FDamageTypeCache
+	{
+		/**
+		 * The tag of each damage type, indexed by damage type ordinal.
+		 */
+		TArray<FGameplayTag> Tags;
+
+		/**
+		 * The ordinal of each damage type, keyed by tag.
+		 */
+		TMap<FGameplayTag, int32> OrdinalsByTag;
+
+		/**
+		 * Whether the tags have been loaded into this cache. Once they have, this cache never changes again.
+		 */
+		bool bIsLoaded = false;
+	};
+
+	/**
+	 * Gets the damage type tags known to the project, loading them the first time the gameplay tags are available.
+	 *
+	 * Nothing is cached if this is called before the gameplay tag tables have been loaded, so that calling this too
+	 * early cannot leave the project without any damage types.
+	 *
+	 * @return
+	 *	The cache of damage type tags. The cache is empty if the tags have not been loaded yet.
+	 */
+	const FDamageTypeCache& GetDamageTypeCache()
+	{
+		static const FDamageTypeCache EmptyDamageTypeCache;
+		static FDamageTypeCache       DamageTypeCache;
+		static FRWLock                DamageTypeCacheLock;
+
+		bool bIsLoaded = false;
+
+		{
+			FReadScopeLock ReadLock(DamageTypeCacheLock);
+
+			if (DamageTypeCache.bIsLoaded)
+			{
+				return DamageTypeCache;
+			}
+		}
+
+		const FGameplayTag DamageTypeParent = FGameplayTag::RequestGameplayTag(FName(TEXT("DamageType")), false);
+
+		if (DamageTypeParent.IsValid())
+		{
+			const FGameplayTagContainer AllDamageTypes =
+				UGameplayTagsManager::Get().RequestGameplayTagChildren(DamageTypeParent);
+
+			FWriteScopeLock WriteLock(DamageTypeCacheLock);
+
+			if (!DamageTypeCache.bIsLoaded && !AllDamageTypes.IsEmpty())
+			{
+				AllDamageTypes.GetGameplayTagArray(DamageTypeCache.Tags);
+
+				for (int32 Ordinal = 0; Ordinal < DamageTypeCache.Tags.Num(); ++Ordinal)
+				{
+					DamageTypeCache.OrdinalsByTag.Add(DamageTypeCache.Tags[Ordinal], Ordinal);
+				}
+
+				DamageTypeCache.bIsLoaded = true;
+			}
+
+			bIsLoaded = DamageTypeCache.bIsLoaded;
+		}
+
+		// The cache is never handed out before it is loaded, since it could change while the caller is reading it.
+		return bIsLoaded ? DamageTypeCache : EmptyDamageTypeCache;
+	}
+
+	const TArray<FGameplayTag>& GetDamageTypeTags()
+	{
+		return GetDamageTypeCache().Tags;
+	}
+
+	int32 GetDamageTypeOrdinal(const FGameplayTag DamageType)
+	{
+		const int32* Ordinal = GetDamageTypeCache().OrdinalsByTag.Find(DamageType);
+
+		return (Ordinal == nullptr) ? INDEX_NONE : *Ordinal;
+	}
+
 	FORCEINLINE IPF2CharacterAbilitySystemComponentInterface* GetCharacterAbilitySystemComponent(
 		const FGameplayAbilityActorInfo* ActorInfo)
 	{
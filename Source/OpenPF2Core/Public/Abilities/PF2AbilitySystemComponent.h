@@ -6,7 +6,15 @@
 #pragma once
 
 #include <AbilitySystemComponent.h>
+
+#include "PF2ActivePassiveEffect.h"
+#include "PF2AttributeChangeFeed.h"
 #include "PF2CharacterAbilitySystemComponentInterface.h"
+#include "PF2DerivedStatistics.h"
+#include "PF2PassiveEffectPlan.h"
+#include "PF2PassiveEffectSpecCache.h"
+#include "PF2PassiveEffectStatsRecorder.h"
+#include "PF2StateSnapshot.h"
 
 #include "PF2AbilitySystemComponent.generated.h"
 
@@ -17,9 +25,33 @@ class OPENPF2CORE_API UPF2AbilitySystemComponent :
 	GENERATED_BODY()
 
 protected:
+	// =================================================================================================================
+	// Protected Types
+	// =================================================================================================================
+	/**
+	 * A passive GE in a specific weight group.
+	 */
+	using FPassiveEffectKey = TPair<FName, TSubclassOf<UGameplayEffect>>;
+
 	// =================================================================================================================
 	// Protected Properties - Blueprint Accessible
 	// =================================================================================================================
+	/**
+	 * Whether to combine consecutive passive GEs in the same weight group into composite GEs.
+	 *
+	 * Combining passive GEs (e.g., the GEs for the ancestry, background, and class of a character) reduces the number
+	 * of active GEs on this ASC, which makes re-applying passive GEs faster and reduces memory use. Only GEs that do
+	 * nothing more than grant tags and modify attributes are combined, and GEs are never combined with a GE whose
+	 * output they depend upon.
+	 *
+	 * Composite GEs are created at runtime rather than loaded from assets, so clients have no way to resolve them if
+	 * they are replicated. For that reason, passive GEs are only combined while this ASC does not replicate its active
+	 * GEs to clients (i.e., in standalone games, or when using the "Minimal" replication mode, which is what
+	 * EPF2AbilitySystemReplicationPolicy::Automatic picks for NPCs). This setting has no effect otherwise.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category="OpenPF2|Passive Effects")
+	bool bCombinePassiveGameplayEffects;
+
 	/**
 	 * The Gameplay Effects used to boost abilities.
 	 *
@@ -33,24 +65,26 @@ protected:
 	 * The list of tags on this ASC that are otherwise not granted by a GE.
 	 *
 	 * These are used to apply replicated tags that are specific to a particular character instance, such as age, size,
-	 * skill proficiency, etc.
+	 * skill proficiency, etc. Each tag in this container is granted to this ASC as a loose tag. The container itself is
+	 * replicated to every client, including the owning client (which does not receive minimal replication tags when
+	 * this ASC is in Mixed mode), and each client grants the same loose tags locally when it arrives.
 	 */
-	UPROPERTY(VisibleAnywhere)
+	UPROPERTY(VisibleAnywhere, ReplicatedUsing=OnRep_DynamicTags)
 	FGameplayTagContainer DynamicTags;
 
 	/**
-	 * The weight groups of Gameplay Effects that have been activated on this ASC.
+	 * The weight groups of Gameplay Effects that have been activated on this ASC, and the ordinal of each.
+	 *
+	 * The ordinal is kept with each group so that the active groups can be put in order without looking up the ordinal
+	 * of every group again (see PF2GameplayAbilityUtilities::GetWeightGroupOrdinal()).
 	 */
 	UPROPERTY(VisibleAnywhere)
-	TSet<FName> ActivatedWeightGroups;
+	TMap<FName, int32> ActivatedWeightGroups;
 
 	/**
-	 * A special, "dummy" GE that is used for applying dynamic tags.
-	 *
-	 * TODO: Find a different way to accomplish this without a GE. This feels very much like a kludge.
+	 * The passive GEs that this ASC has applied, and the handles of the resulting active GEs, organized by weight group.
 	 */
-	UPROPERTY()
-	TSubclassOf<UGameplayEffect> DynamicTagsEffect;
+	TMap<FName, TArray<FPF2ActivePassiveEffect>> ActivePassiveEffects;
 
 	/**
 	 * The list of Gameplay Effects (GEs) that are always passively applied to this ASC.
@@ -62,17 +96,240 @@ protected:
 	TMultiMap<FName, TSubclassOf<UGameplayEffect>> PassiveGameplayEffects;
 
 	/**
-	 * The cached list of all Gameplay Effects registered on this ASC with AddPassiveGameplayEffect() or
-	 * AddPassiveGameplayEffectWithWeight.
+	 * The number of passive GE batches that are currently open on this ASC.
+	 *
+	 * While this is greater than zero, changes to passive GEs and dynamic tags are recorded rather than applied.
+	 */
+	int32 PassiveEffectBatchDepth;
+
+	/**
+	 * The dynamic tags that this ASC had at the time the outermost passive GE batch was started.
+	 */
+	FGameplayTagContainer PassiveEffectBatchInitialDynamicTags;
+
+	/**
+	 * Whether activation of all passive GEs was requested during the current passive GE batch.
 	 */
-	TMultiMap<FName, TSubclassOf<UGameplayEffect>> CachedPassiveGameplayEffectsToApply;
+	bool bPassiveEffectBatchActivationRequested;
+
+	/**
+	 * Whether the level of the owning character changed during the current passive GE batch.
+	 */
+	bool bPassiveEffectBatchLevelChanged;
+
+	/**
+	 * The weight groups into which passive GEs were added during the current passive GE batch.
+	 */
+	TSet<FName> PassiveEffectBatchDirtyWeightGroups;
+
+	/**
+	 * The cached plan for applying all Gameplay Effects registered on this ASC with AddPassiveGameplayEffect(),
+	 * AddPassiveGameplayEffectWithWeight(), or SetPassiveGameplayEffects().
+	 *
+	 * The plan is rebuilt the next time it is needed after the list of passive GEs changes.
+	 */
+	TSharedPtr<const FPF2PassiveEffectPlan> CachedPassiveEffectPlan;
+
+	/**
+	 * The specs that were made the last time each passive GE was activated, for re-use on later activations.
+	 */
+	FPF2PassiveEffectSpecCache PassiveEffectSpecCache;
+
+	/**
+	 * The derived statistics of the character that were calculated ahead of applying the passive GEs of a weight group.
+	 *
+	 * This is only populated while ActivateAllPassiveGameplayEffectsInParallel() applies a weight group to this ASC, and
+	 * is discarded as soon as any tag of this ASC changes.
+	 */
+	FPF2PrecalculatedDerivedStatistics PrecalculatedDerivedStatistics;
+
+	/**
+	 * The passive GE work that this ASC has done, attributed to the entry point that caused it.
+	 */
+	FPF2PassiveEffectStatsRecorder PassiveEffectStats;
+
+	/**
+	 * The handles of the ability specs of this ASC, organized by the exact class of each ability.
+	 */
+	TMap<TSubclassOf<UGameplayAbility>, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<1>>> AbilitySpecsByClass;
+
+	/**
+	 * The handles of the ability specs of this ASC, organized by each ability tag (and each parent of each ability tag)
+	 * of each ability.
+	 */
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle>> AbilitySpecsByTag;
+
+	/**
+	 * The index of the spec for each ability spec handle within the activatable abilities of this ASC, as of the last
+	 * time the spec was looked up.
+	 *
+	 * Specs can move when other abilities are removed, so each index is verified before it is used and refreshed if it
+	 * is stale.
+	 */
+	mutable TMap<FGameplayAbilitySpecHandle, int32> AbilitySpecIndices;
+
+	/**
+	 * The layer of each state snapshot that is open on this ASC, from the oldest snapshot to the newest.
+	 */
+	TArray<FPF2StateSnapshotLayer> StateSnapshotLayers;
+
+	/**
+	 * The ID of the last state snapshot taken on this ASC.
+	 */
+	int32 LastStateSnapshotId;
+
+	/**
+	 * Whether a state snapshot is currently being restored.
+	 *
+	 * Changes made while a snapshot is restored are not recorded in the layers of older snapshots, since they only
+	 * return state to how it was when those layers were last updated.
+	 */
+	bool bRestoringStateSnapshot;
+
+	/**
+	 * The attributes and tags of this ASC that have changed since the last change notification was sent.
+	 */
+	FPF2AttributeChangeFeed AttributeChangeFeed;
+
+	/**
+	 * Whether this ASC is listening for changes to its attributes and tags for the change feed.
+	 */
+	bool bAttributeChangeFeedBound;
+
+	/**
+	 * Whether this ASC is forwarding changes to the values of its attributes to its attribute set.
+	 */
+	bool bAttributeValueCallbacksBound;
+
+	/**
+	 * Whether an input of derived statistics has changed since the server last updated what it sends to clients.
+	 */
+	bool bDerivedStatisticsReplicationDirty;
+
+	/**
+	 * The handle of the end-of-frame callback that sends the next change notification, if one has been scheduled.
+	 */
+	FDelegateHandle AttributeChangeFeedFlushHandle;
+
+	/**
+	 * The handle of the end-of-frame callback that derives statistics on a client again, if one has been scheduled.
+	 */
+	FDelegateHandle DerivedStatisticsUpdateHandle;
 
 public:
+	// =================================================================================================================
+	// Public Fields
+	// =================================================================================================================
+	/**
+	 * Event fired at the end of each frame during which attributes or tags of this ASC changed.
+	 *
+	 * This fires once per frame with all the attributes and tags that changed during the frame, on both the server and
+	 * clients. UI should bind to this instead of binding to the change delegate of each attribute, since re-applying
+	 * passive GEs can change dozens of attributes at once.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="OpenPF2|Attributes")
+	FPF2AttributeChangeSetDelegate OnAttributesChanged;
+
+	/**
+	 * Native version of OnAttributesChanged, which fires right before it.
+	 */
+	FPF2AttributeChangeSetNativeDelegate OnAttributesChangedNative;
+
+	// =================================================================================================================
+	// Public Static Methods
+	// =================================================================================================================
+	/**
+	 * Activates all passive GEs on many ASCs at once, spreading the work that does not modify GE state across threads.
+	 *
+	 * This is equivalent to calling ActivateAllPassiveGameplayEffects() on each ASC, but is faster when many characters
+	 * need their passive GEs activated at the same time (e.g., when a level with many NPCs is loaded). Weight groups are
+	 * activated in waves. Before each wave, the ability modifiers, tags, and level of every character are copied on the
+	 * game thread, and then the derived statistics of all characters (see FPF2DerivedStatistics) are calculated from
+	 * the copies in parallel. The GEs of the weight group are then made and applied to each ASC on the game thread, and
+	 * the MMCs of the derived statistics use the precalculated values instead of calculating them again.
+	 *
+	 * Only the calculations run off the game thread; they read nothing but their copies of the inputs. Making specs and
+	 * applying GEs, which read and update the state of each ASC, always happens on the game thread. ASCs that have a
+	 * passive GE batch open defer activation until the batch ends, just like they would for
+	 * ActivateAllPassiveGameplayEffects().
+	 *
+	 * In the passive GE stats of each ASC, every weight group that this activates counts as a separate call to activate
+	 * passive GEs, and only the time spent on the GEs of that ASC is counted.
+	 *
+	 * This must be called from the game thread.
+	 *
+	 * @param AbilitySystemComponents
+	 *	The ASCs for which passive GEs should be activated.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Passive Effects")
+	static void ActivateAllPassiveGameplayEffectsInParallel(
+		const TArray<UPF2AbilitySystemComponent*>& AbilitySystemComponents);
+
+	/**
+	 * Totals the passive GE stats of all the ASCs in a world, by entry point.
+	 *
+	 * @param WorldContextObject
+	 *	An object in the world for which stats are desired.
+	 *
+	 * @return
+	 *	The sum of the stats of every ASC in the world, keyed by entry point.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Passive Effects", meta=(WorldContext="WorldContextObject"))
+	static TMap<EPF2PassiveEffectTrigger, FPF2PassiveEffectStats> GetPassiveEffectStatsForWorld(
+		const UObject* WorldContextObject);
+
+	/**
+	 * Writes the passive GE stats of a world to an output device.
+	 *
+	 * The totals for the world are written first, by entry point, followed by the ASCs that have spent the most time
+	 * on passive GEs. This is what the "OpenPF2.DumpPassiveEffectStats" console command outputs.
+	 *
+	 * @param World
+	 *	The world for which stats are desired.
+	 * @param MaxAscs
+	 *	The maximum number of ASCs to list.
+	 * @param Output
+	 *	The device to which stats are written.
+	 */
+	static void DumpPassiveEffectStats(const UWorld* World, const int32 MaxAscs, FOutputDevice& Output);
+
+	/**
+	 * Compares two sets of passive GEs to determine which GEs were removed and which were added.
+	 *
+	 * Each set is treated as a multiset of (weight group, GE) pairs, so a GE that appears twice in the same weight group
+	 * of the new set but only once in the old set is considered to have been added once.
+	 *
+	 * @param OldEffects
+	 *	The passive GEs before the change.
+	 * @param NewEffects
+	 *	The passive GEs after the change.
+	 * @param RemovedEffects
+	 *	A reference to the map that receives the GEs that are in the old set but not the new set.
+	 * @param AddedEffects
+	 *	A reference to the map that receives the GEs that are in the new set but not the old set.
+	 */
+	static void DiffPassiveGameplayEffects(
+		const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& OldEffects,
+		const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& NewEffects,
+		TMultiMap<FName, TSubclassOf<UGameplayEffect>>&       RemovedEffects,
+		TMultiMap<FName, TSubclassOf<UGameplayEffect>>&       AddedEffects);
+
+
 	// =================================================================================================================
 	// Public Constructors
 	// =================================================================================================================
 	UPF2AbilitySystemComponent();
 
+	// =================================================================================================================
+	// Public Methods - UAbilitySystemComponent Overrides
+	// =================================================================================================================
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+	virtual void InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor) override;
+	virtual void OnUnregister() override;
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+
 	// =================================================================================================================
 	// Public Methods - IPF2AbilitySystemComponentInterface Implementation
 	// =================================================================================================================
@@ -93,7 +350,7 @@ public:
 		const TSubclassOf<UGameplayEffect> Effect
 	) override;
 
-	virtual void SetPassiveGameplayEffects(const TMultiMap<FName, TSubclassOf<UGameplayEffect>> Effects) override;
+	virtual void SetPassiveGameplayEffects(const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& Effects) override;
 
 	UFUNCTION(BlueprintCallable)
 	virtual void RemoveAllPassiveGameplayEffects() override;
@@ -134,9 +391,22 @@ public:
 	UFUNCTION(BlueprintCallable)
 	virtual void RemoveAllDynamicTags() override;
 
+	UFUNCTION(BlueprintCallable)
+	virtual void BeginPassiveGameplayEffectBatch() override;
+
+	UFUNCTION(BlueprintCallable)
+	virtual void EndPassiveGameplayEffectBatch() override;
+
 	UFUNCTION(BlueprintCallable)
 	virtual FGameplayTagContainer GetActiveGameplayTags() const override;
 
+	virtual FGameplayAbilitySpec* FindAbilitySpecByClass(
+		const TSubclassOf<UGameplayAbility> AbilityClass) const override;
+
+	virtual TArray<FGameplayAbilitySpec*> FindAbilitySpecsByTags(const FGameplayTagContainer& Tags) const override;
+
+	virtual TArray<FGameplayAbilitySpecHandle> GiveAbilities(const TArray<FGameplayAbilitySpec>& Specs) override;
+
 	// =================================================================================================================
 	// Public Methods - IPF2CharacterAbilitySystemComponentInterface Implementation
 	// =================================================================================================================
@@ -159,58 +429,504 @@ public:
 	UFUNCTION(BlueprintCallable)
 	virtual void ApplyAbilityBoost(const EPF2CharacterAbilityScoreType TargetAbilityScore) override;
 
+	UFUNCTION(BlueprintCallable)
+	virtual void UpdatePassiveGameplayEffectsForLevelChange() override;
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the passive GE work that this ASC has done, attributed to the entry point of this ASC that caused it.
+	 *
+	 * This is used to find out which changes to a character are responsible for the cost of re-applying its passive
+	 * GEs.
+	 *
+	 * @return
+	 *	The stats of this ASC, keyed by entry point. Entry points that have not been invoked are omitted.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Passive Effects")
+	FORCEINLINE TMap<EPF2PassiveEffectTrigger, FPF2PassiveEffectStats> GetPassiveEffectStats() const
+	{
+		return this->PassiveEffectStats.GetStats();
+	}
+
+	/**
+	 * Gets the derived statistics that were calculated for this ASC ahead of applying the passive GEs of a weight group.
+	 *
+	 * @return
+	 *	The precalculated statistics. These are empty unless ActivateAllPassiveGameplayEffectsInParallel() is applying
+	 *	a weight group to this ASC.
+	 */
+	FORCEINLINE const FPF2PrecalculatedDerivedStatistics& GetPrecalculatedDerivedStatistics() const
+	{
+		return this->PrecalculatedDerivedStatistics;
+	}
+
+	/**
+	 * Discards all of the passive GE stats that this ASC has recorded.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Passive Effects")
+	FORCEINLINE void ResetPassiveEffectStats()
+	{
+		this->PassiveEffectStats.Reset();
+	}
+
+	/**
+	 * Takes a snapshot of the attribute base values, dynamic tags, and passive GEs of this ASC.
+	 *
+	 * Taking a snapshot does not copy any state. Instead, the old value of each part of the state is saved the first
+	 * time it changes after the snapshot is taken. This allows tools (e.g., a character builder previewing a choice)
+	 * and gameplay (e.g., undoing the last action in an encounter) to roll a character back without having to remove
+	 * and re-apply all of its passive GEs.
+	 *
+	 * Snapshots can be nested. Each snapshot must eventually be either restored or released.
+	 *
+	 * @return
+	 *	A handle to the new snapshot.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Snapshots")
+	FPF2StateSnapshotHandle TakeStateSnapshot();
+
+	/**
+	 * Returns the attribute base values, dynamic tags, and passive GEs of this ASC to how they were in a snapshot.
+	 *
+	 * Only the parts of the state that have changed since the snapshot was taken are touched, and only the passive GEs
+	 * affected by those changes are re-applied. The snapshot, and any snapshots taken after it, are released.
+	 *
+	 * @param Snapshot
+	 *	The handle of the snapshot to restore.
+	 *
+	 * @return
+	 *	- TRUE if the snapshot was restored.
+	 *	- FALSE if the handle does not refer to a snapshot that is open on this ASC.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Snapshots")
+	bool RestoreStateSnapshot(const FPF2StateSnapshotHandle Snapshot);
+
+	/**
+	 * Keeps all changes made since a snapshot was taken, and releases the snapshot.
+	 *
+	 * Any snapshots taken after the snapshot are released as well. Snapshots taken before it can still restore the
+	 * state they captured.
+	 *
+	 * @param Snapshot
+	 *	The handle of the snapshot to release.
+	 *
+	 * @return
+	 *	- TRUE if the snapshot was released.
+	 *	- FALSE if the handle does not refer to a snapshot that is open on this ASC.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Snapshots")
+	bool ReleaseStateSnapshot(const FPF2StateSnapshotHandle Snapshot);
+
+	/**
+	 * Records the base value that an attribute had before it changed, for the newest open state snapshot.
+	 *
+	 * This is called by attribute sets right before the base value of one of their attributes changes (see
+	 * UPF2AttributeSet::PreAttributeBaseChange()).
+	 *
+	 * @param Attribute
+	 *	The attribute that changed.
+	 * @param OldValue
+	 *	The base value of the attribute before the change.
+	 */
+	void RecordAttributeBaseValueForSnapshot(const FGameplayAttribute& Attribute, const float OldValue);
+
+	/**
+	 * Schedules the statistics of the character to be derived again at the end of the current frame.
+	 *
+	 * The inputs from which clients derive statistics replicate separately: ability modifiers with the attribute set,
+	 * tags with this ASC, and the level with the character. They can arrive in any order, so this is called whenever
+	 * any of them changes; however many of them arrive in the same frame, statistics are only derived once.
+	 *
+	 * On the server, this instead schedules an update of the overrides and checksum that it sends to clients, so that
+	 * they are only recalculated in frames where an input has changed.
+	 *
+	 * This has no effect unless clients derive statistics locally (see FPF2DerivedStatistics).
+	 */
+	void ScheduleDerivedStatisticsUpdate();
+
 protected:
+	// =================================================================================================================
+	// Protected Replication Callbacks
+	// =================================================================================================================
+	/**
+	 * Callback invoked on clients when the dynamic tags of this ASC have been replicated.
+	 *
+	 * @param OldDynamicTags
+	 *	The dynamic tags that this ASC had before replication.
+	 */
+	UFUNCTION()
+	void OnRep_DynamicTags(const FGameplayTagContainer& OldDynamicTags);
+
+	// =================================================================================================================
+	// Protected Methods - UAbilitySystemComponent Overrides
+	// =================================================================================================================
+	virtual void OnTagUpdated(const FGameplayTag& Tag, bool TagExists) override;
+
 	// =================================================================================================================
 	// Protected Methods
 	// =================================================================================================================
 	/**
-	 * Gets or builds the list of all passive gameplay effects to activate, organized by weight group.
+	 * Gets or builds the plan for activating all passive gameplay effects, organized by weight group.
 	 *
-	 * The returned list includes all of the passive GEs that have been added to this GE as well as the dynamic tag GE.
+	 * The plan includes all of the passive GEs that have been added to this ASC.
 	 *
-	 * The list is cached, for performance reasons.
+	 * The plan is cached, for performance reasons. Callers should hold on to the returned reference while iterating
+	 * over the plan, since the plan of this ASC gets replaced if passive GEs are added during iteration.
 	 *
 	 * @return
-	 *	The map of passive GEs to activate, keyed by weight group.
+	 *	The plan of passive GEs to activate.
 	 */
-	TMultiMap<FName, TSubclassOf<UGameplayEffect>> GetPassiveGameplayEffectsToApply();
+	TSharedRef<const FPF2PassiveEffectPlan> GetPassiveEffectPlan();
 
 	/**
-	 * Builds the list of all passive gameplay effects to activate, organized by weight group.
+	 * Builds the plan for activating all passive gameplay effects, organized by weight group.
 	 *
-	 * The returned list includes all of the passive GEs that have been added to this GE as well as the dynamic tag GE.
+	 * The plan includes all of the passive GEs that have been added to this ASC. All of the boosts to the same ability
+	 * are combined into a single entry, so that they are applied as one GE with one stack per boost.
 	 *
-	 * The list is not cached.
+	 * The plan is not cached.
 	 *
 	 * @return
-	 *	The map of passive GEs to activate, keyed by weight group.
+	 *	The plan of passive GEs to activate.
 	 */
-	TMultiMap<FName, TSubclassOf<UGameplayEffect>> BuildPassiveGameplayEffectsToApply() const;
+	TSharedRef<const FPF2PassiveEffectPlan> BuildPassiveEffectPlan() const;
 
 	/**
-	 * Activates a specific passive Gameplay Effect on this ASC.
+	 * Clears the cached plan of passive GEs to activate.
+	 *
+	 * This must be called any time that the passive GEs of this ASC change.
+	 */
+	void ClearPassiveGameplayEffectsCache();
+
+	/**
+	 * Determines whether changes to passive GEs and dynamic tags are currently being batched.
+	 *
+	 * @return
+	 *	- TRUE if a passive GE batch is open on this ASC.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool IsPassiveGameplayEffectBatchOpen() const
+	{
+		return this->PassiveEffectBatchDepth > 0;
+	}
+
+	/**
+	 * Determines whether passive GEs on this ASC should be combined into composite GEs.
+	 *
+	 * @return
+	 *	- TRUE if bCombinePassiveGameplayEffects is set and this ASC does not replicate active GEs to clients.
+	 *	- FALSE, otherwise.
+	 */
+	bool ShouldCombinePassiveGameplayEffects() const;
+
+	/**
+	 * Applies all of the changes that were recorded during a passive GE batch.
+	 *
+	 * Passive GEs are re-applied at most once by this method, and only for the weight groups and GEs affected by the
+	 * recorded changes.
+	 */
+	void ReconcilePassiveGameplayEffectBatch();
+
+	/**
+	 * Re-applies all active passive GEs in the given weight groups and in every active weight group after them.
+	 *
+	 * @param WeightGroups
+	 *	The weight groups that have changed.
+	 */
+	void ReapplyPassiveGameplayEffectsFromWeightGroups(const TSet<FName>& WeightGroups);
+
+	/**
+	 * Gets the ordinal of a weight group, for ordering weight groups relative to each other.
+	 *
+	 * The ordinal of an active weight group is the one stored when the group was activated; otherwise, it is looked up.
 	 *
 	 * @param WeightGroup
-	 *	The weight group for which the effect is being activated.
-	 * @param GameplayEffect
-	 *	The effect to activate.
+	 *	The name of the weight group for which an ordinal is desired.
+	 *
+	 * @return
+	 *	The ordinal of the weight group.
+	 */
+	int32 GetWeightGroupOrdinal(const FName WeightGroup) const;
+
+	/**
+	 * Activates a specific passive Gameplay Effect on this ASC.
+	 *
+	 * @param Entry
+	 *	The entry of the passive effect plan for the GE to activate. If the entry combines multiple additions of a
+	 *	stackable GE, the GE is applied once with one stack per addition.
+	 */
+	void ActivatePassiveGameplayEffect(const FPF2PassiveEffectPlanEntry& Entry);
+
+	/**
+	 * Activates a specific passive Gameplay Effect on this ASC, using a spec that has already been made for it.
+	 *
+	 * @param Entry
+	 *	The entry of the passive effect plan for the GE to activate.
+	 * @param SpecHandle
+	 *	The spec that was made for the entry by GetPassiveGameplayEffectSpec().
 	 */
 	void ActivatePassiveGameplayEffect(
-		const FName                        WeightGroup,
-		const TSubclassOf<UGameplayEffect> GameplayEffect);
+		const FPF2PassiveEffectPlanEntry& Entry,
+		const FGameplayEffectSpecHandle&  SpecHandle);
+
+	/**
+	 * Removes an active passive Gameplay Effect from this ASC.
+	 *
+	 * @param Handle
+	 *	The handle of the active GE to remove.
+	 *
+	 * @return
+	 *	- TRUE if the GE was removed.
+	 *	- FALSE, otherwise.
+	 */
+	bool RemovePassiveGameplayEffect(const FActiveGameplayEffectHandle Handle);
+
+	/**
+	 * Finds the spec of an ability that has been granted to this ASC, by its handle.
+	 *
+	 * This is equivalent to FindAbilitySpecFromHandle(), but usually does not need to scan all the abilities of this
+	 * ASC.
+	 *
+	 * @param Handle
+	 *	The handle of the ability spec.
+	 *
+	 * @return
+	 *	Either the spec; or, nullptr if this ASC has no spec with the given handle.
+	 */
+	FGameplayAbilitySpec* FindIndexedAbilitySpec(const FGameplayAbilitySpecHandle Handle) const;
+
+	/**
+	 * Gets the layer of the newest open state snapshot, for recording state that is about to change.
+	 *
+	 * @return
+	 *	Either the layer of the newest snapshot; or, nullptr if no snapshots are open or a snapshot is being restored.
+	 */
+	FPF2StateSnapshotLayer* GetStateSnapshotLayerForChange();
+
+	/**
+	 * Finds the position of the layer of a state snapshot among the open snapshots of this ASC.
+	 *
+	 * @param Snapshot
+	 *	The handle of the snapshot.
+	 *
+	 * @return
+	 *	Either the index of the layer in StateSnapshotLayers; or, INDEX_NONE if the snapshot is not open.
+	 */
+	int32 FindStateSnapshotLayer(const FPF2StateSnapshotHandle Snapshot) const;
+
+	/**
+	 * Removes the layers of a state snapshot and every snapshot taken after it, combining them into a single layer.
+	 *
+	 * @param LayerIndex
+	 *	The index of the layer of the snapshot in StateSnapshotLayers.
+	 *
+	 * @return
+	 *	A layer having the state from when the snapshot was taken, for everything that has changed since.
+	 */
+	FPF2StateSnapshotLayer PopStateSnapshotLayers(const int32 LayerIndex);
+
+	/**
+	 * Records the dynamic tags that this ASC had before they changed, for the newest open state snapshot.
+	 *
+	 * @param OldDynamicTags
+	 *	The dynamic tags of this ASC before the change.
+	 */
+	void RecordDynamicTagsForSnapshot(const FGameplayTagContainer& OldDynamicTags);
+
+	/**
+	 * Records the passive GEs of this ASC for the newest open state snapshot, before they change.
+	 */
+	void RecordPassiveGameplayEffectsForSnapshot();
+
+	/**
+	 * Starts forwarding changes to the current values of the attributes of this ASC to its attribute set.
+	 *
+	 * GAS does not notify attribute sets of changes to current values on every engine version this plug-in supports,
+	 * but the change delegate of each attribute is always available. This has no effect if this ASC is already
+	 * forwarding changes.
+	 */
+	void BindAttributeValueCallbacks();
 
 	/**
-	 * Invokes the logic of the specified callable, with special handling if passive GEs are already active on this ASC.
+	 * Callback invoked when the current value of an attribute of this ASC changes.
 	 *
-	 * If passive GEs are active on this ASC before this call, they are deactivated; then the callable is invoked, and
-	 * passive GEs are re-activated. If passive GEs are not active before this call, then they are not activated at the
-	 * end of this call.
+	 * @param ChangeData
+	 *	Information about the change.
+	 */
+	void OnAttributeValueChanged(const FOnAttributeChangeData& ChangeData);
+
+	/**
+	 * Starts listening for changes to the attributes and tags of this ASC, for the change feed.
+	 *
+	 * This has no effect if this ASC is already listening.
+	 */
+	void BindAttributeChangeFeed();
+
+	/**
+	 * Callback invoked when the value of an attribute of this ASC changes.
+	 *
+	 * @param ChangeData
+	 *	Information about the change.
+	 * @param Index
+	 *	The index of the attribute in the attribute registry.
+	 */
+	void OnAttributeChangedForFeed(const FOnAttributeChangeData& ChangeData, const EPF2AttributeIndex Index);
+
+	/**
+	 * Callback invoked when a tag is added to or removed from this ASC.
+	 *
+	 * @param Tag
+	 *	The tag that was added or removed.
+	 * @param NewCount
+	 *	The new count of the tag on this ASC.
+	 */
+	void OnTagChangedForFeed(const FGameplayTag Tag, const int32 NewCount);
+
+	/**
+	 * Schedules a change notification to be sent at the end of the current frame, if one has not been already.
+	 */
+	void ScheduleAttributeChangeFeedFlush();
+
+	/**
+	 * Callback invoked at the end of each frame for which a change notification has been scheduled.
+	 *
+	 * @param World
+	 *	The world that has finished ticking its actors.
+	 * @param TickType
+	 *	The type of tick.
+	 * @param DeltaSeconds
+	 *	The time since the last tick.
+	 */
+	void FlushAttributeChangeFeed(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/**
+	 * Updates the overrides and checksum of derived statistics that the server sends to clients.
+	 *
+	 * This must only be called on the server.
+	 */
+	void UpdateDerivedStatisticsForReplication();
+
+	/**
+	 * Callback invoked at the end of each frame for which an update of derived statistics has been scheduled.
+	 *
+	 * @param World
+	 *	The world that has finished ticking its actors.
+	 * @param TickType
+	 *	The type of tick.
+	 * @param DeltaSeconds
+	 *	The time since the last tick.
+	 */
+	void UpdateDerivedStatistics(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/**
+	 * Removes every active instance of specific passive Gameplay Effects and re-applies them according to a plan.
+	 *
+	 * If any of the GEs have been combined into a composite GE, either while active or in the plan, all of the other
+	 * GEs combined with them are replaced as well.
+	 *
+	 * @param Plan
+	 *	The plan from which to re-apply the GEs. This is typically the current plan of this ASC.
+	 * @param Effects
+	 *	The GEs to replace, along with the weight group of each.
+	 */
+	void ReplacePassiveGameplayEffects(const FPF2PassiveEffectPlan& Plan, const TSet<FPassiveEffectKey>& Effects);
+
+	/**
+	 * Gets a spec for activating a passive Gameplay Effect on this ASC.
+	 *
+	 * A cached spec from a prior activation of the same GE in the same weight group and at the same character level is
+	 * re-used if none of the tags that the GE reads have changed since the spec was made. Otherwise, a new spec is made
+	 * and cached. Specs for GEs that capture attributes as a snapshot are never cached, since the spec would need to be
+	 * re-made any time one of the attributes changes.
+	 *
+	 * @param Entry
+	 *	The entry of the passive effect plan for the GE being activated.
+	 *
+	 * @return
+	 *	The handle of the spec to apply.
+	 */
+	FGameplayEffectSpecHandle GetPassiveGameplayEffectSpec(const FPF2PassiveEffectPlanEntry& Entry);
+
+	/**
+	 * Invokes the logic of the specified callable, then re-applies only passive GEs affected by dynamic tag changes.
+	 *
+	 * The dynamic tags of this ASC before and after the callable is invoked are compared to determine which tags were
+	 * added or removed. If passive GEs are active on this ASC, only the passive GEs that read those tags, and the
+	 * passive GEs downstream of them, are re-applied. If passive GEs are not active, no GEs are activated by this call.
+	 *
+	 * If a passive GE batch is open, the callable is invoked and the re-application is deferred until the batch ends.
 	 *
 	 * @param Callable
-	 *	A lambda that is invoked to perform the task.
+	 *	A lambda that is invoked to modify the dynamic tags of this ASC.
 	 */
 	template<typename Func>
-	void InvokeAndReapplyAllPassiveGEs(const Func Callable);
+	void InvokeAndReapplyPassiveGEsAffectedByDynamicTags(const Func Callable);
+
+	/**
+	 * Removes and re-applies all active passive GEs that are affected by a change to the given tags.
+	 *
+	 * @param ChangedTags
+	 *	The tags that have been added to or removed from this ASC.
+	 */
+	void ReapplyPassiveGameplayEffectsAffectedByTags(const FGameplayTagContainer& ChangedTags);
+
+	/**
+	 * Removes and then re-applies the specified passive GEs, in weight order.
+	 *
+	 * Only GEs in weight groups that are active are re-applied.
+	 *
+	 * @param Effects
+	 *	The passive GEs to re-apply.
+	 */
+	void ReapplyPassiveGameplayEffects(const TSet<TSubclassOf<UGameplayEffect>>& Effects);
+
+	/**
+	 * Removes and applies only the passive GEs that changed when the passive GEs of this ASC were replaced.
+	 *
+	 * Each GE that was removed or added is removed from its weight group and then applied again as many times as the
+	 * new plan calls for (if its weight group is active); and any GEs in weight groups after the earliest changed group
+	 * that depend on a changed GE are re-applied. Replacing the GE as a whole keeps the stack count of stackable GEs in
+	 * sync with the number of times they were added, and keeps composite GEs in sync with the GEs they combine.
+	 *
+	 * @param OldPlan
+	 *	The plan of passive GEs before the change.
+	 * @param RemovedEffects
+	 *	The GEs that were removed, keyed by weight group.
+	 * @param AddedEffects
+	 *	The GEs that were added, keyed by weight group.
+	 */
+	void ApplyPassiveGameplayEffectChanges(
+		const FPF2PassiveEffectPlan&                          OldPlan,
+		const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& RemovedEffects,
+		const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& AddedEffects);
+
+	/**
+	 * Determines which tags differ between two sets of tags.
+	 *
+	 * @param OldTags
+	 *	The tags before a change.
+	 * @param NewTags
+	 *	The tags after a change.
+	 *
+	 * @return
+	 *	The tags that are in only one of the two containers (i.e., tags that were added or removed).
+	 */
+	static FGameplayTagContainer GetChangedTags(
+		const FGameplayTagContainer& OldTags,
+		const FGameplayTagContainer& NewTags);
+
+	/**
+	 * Grants or revokes the loose tags of this ASC for dynamic tags that have changed.
+	 *
+	 * Each tag that is now in the dynamic tags of this ASC is granted; each tag that is no longer in the dynamic tags is
+	 * revoked.
+	 *
+	 * @param ChangedTags
+	 *	The dynamic tags that were added or removed.
+	 */
+	void UpdateLooseDynamicTags(const FGameplayTagContainer& ChangedTags);
 
 	/**
 	 * Invokes the logic of the specified callable, then re-applies passive GEs in weight groups after it.
@@ -245,6 +961,8 @@ protected:
 	 * If the given weight group is not active, or no passive GEs were active in subsequent weight groups before this
 	 * call, no additional weight groups are activated at the end of this call.
 	 *
+	 * If a passive GE batch is open, the callable is invoked and the re-application is deferred until the batch ends.
+	 *
 	 * @param WeightGroup
 	 *	The weight group that the callable affects. If this weight group is currently active on this ASC, all subsequent
 	 *	weight groups will be re-applied, if they are active.
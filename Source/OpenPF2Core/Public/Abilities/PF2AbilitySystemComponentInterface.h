@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <GameplayAbilitySpec.h>
 #include <GameplayEffect.h>
 #include <GameplayTagContainer.h>
 #include <UObject/Interface.h>
@@ -87,15 +88,17 @@ public:
 	/**
 	 * Sets all of the passive Gameplay Effects on this ASC to the given set.
 	 *
-	 * If passive GEs are currently active on this ASC, they will be removed and the new GEs will be applied as part of
-	 * this call.
+	 * If passive GEs are currently active on this ASC, the new set is compared against the current set: GEs that are no
+	 * longer in the set are removed, GEs that are new to the set are applied, and GEs in later weight groups that
+	 * depend on any of the changed GEs are re-applied. GEs that are in both sets are left untouched. The order of GEs
+	 * within the same weight group is not considered a change.
 	 *
 	 * @param Effects
 	 *	The list of Gameplay Effects (GEs) to always passively apply to this ASC. Each value must be a gameplay effect
 	 *	and the key must be the weight group of that GE. The weight controls the order that all GEs are applied. Lower
 	 *	weights are applied earlier than higher weights.
 	 */
-	virtual void SetPassiveGameplayEffects(const TMultiMap<FName, TSubclassOf<UGameplayEffect>> Effects) = 0;
+	virtual void SetPassiveGameplayEffects(const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& Effects) = 0;
 
 	/**
 	 * Clears all of the passive Gameplay Effects on this ASC.
@@ -175,9 +178,10 @@ public:
 	 * Applies a tag to this ASC that is otherwise not granted by a GE.
 	 *
 	 * This can be used to apply a replicated tag that is specific to a particular character instance, such as age,
-	 * size, skill proficiency, etc. If passive GEs are currently active on this ASC, they will be re-applied when this
-	 * method is called. Consequently, calling AppendDynamicTags() is preferred over this method when there are multiple
-	 * tags that should be applied at the same time, to avoid unnecessary overhead from re-applying all passive GEs.
+	 * size, skill proficiency, etc. If passive GEs are currently active on this ASC, the passive GEs that depend on the
+	 * tag (and any passive GEs that depend on those GEs) will be re-applied when this method is called. Consequently,
+	 * calling AppendDynamicTags() is preferred over this method when there are multiple tags that should be applied at
+	 * the same time, to avoid unnecessary overhead from re-applying passive GEs multiple times.
 	 *
 	 * @param Tag
 	 *	The tag to apply to this Ability System Component.
@@ -189,9 +193,10 @@ public:
 	 * Applies multiple replicated tags to this ASC that are otherwise not granted by a GE.
 	 *
 	 * This can be used to apply replicated tags that are specific to a particular character instance, such as age,
-	 * size, skill proficiency, etc. If passive GEs are currently active on this ASC, they will be re-applied when this
-	 * method is called. Consequently, calling this method is preferred over AddDynamicTag() when there are multiple
-	 * tags that should be applied at the same time, to avoid unnecessary overhead from re-applying all passive GEs.
+	 * size, skill proficiency, etc. If passive GEs are currently active on this ASC, the passive GEs that depend on the
+	 * tags (and any passive GEs that depend on those GEs) will be re-applied when this method is called. Consequently,
+	 * calling this method is preferred over AddDynamicTag() when there are multiple tags that should be applied at the
+	 * same time, to avoid unnecessary overhead from re-applying passive GEs multiple times.
 	 *
 	 * @param Tags
 	 *	The tag to apply to this Ability System Component.
@@ -203,7 +208,8 @@ public:
 	 * Sets all of the replicated tags in this ASC that are otherwise not granted by a GE.
 	 *
 	 * This can be used to apply replicated tags that are specific to a particular character instance, such as age,
-	 * size, skill proficiency, etc. If passive GEs are currently active on this ASC, they will be re-applied when this
+	 * size, skill proficiency, etc. If passive GEs are currently active on this ASC, the passive GEs that depend on any
+	 * tags that were added or removed (and any passive GEs that depend on those GEs) will be re-applied when this
 	 * method is called.
 	 *
 	 * @param Tags
@@ -216,9 +222,10 @@ public:
 	 * Removes a tag from this ASC that was previously added with AddDynamicTag() or AppendDynamicTags().
 	 *
 	 * This can be used to remove a tag that is specific to a particular character instance, such as age, size, skill
-	 * proficiency, etc. If passive GEs are currently active on this ASC, they will be re-applied when this method is
-	 * called. Consequently, calling RemoveDynamicTags() is preferred over this method when there are multiple tags that
-	 * should be removed at the same time, to avoid unnecessary overhead from re-applying all passive GEs.
+	 * proficiency, etc. If passive GEs are currently active on this ASC, the passive GEs that depend on the tag (and
+	 * any passive GEs that depend on those GEs) will be re-applied when this method is called. Consequently, calling
+	 * RemoveDynamicTags() is preferred over this method when there are multiple tags that should be removed at the same
+	 * time, to avoid unnecessary overhead from re-applying passive GEs multiple times.
 	 *
 	 * @param Tag
 	 *	The tag to remove from this Ability System Component.
@@ -230,9 +237,10 @@ public:
 	 * Removes multiple tags from this ASC that were previously added with AddDynamicTag() or AppendDynamicTags().
 	 *
 	 * This can be used to remove tags that are specific to a particular character instance, such as age, size, skill
-	 * proficiency, etc. If passive GEs are currently active on this ASC, they will be re-applied when this method is
-	 * called. Consequently, calling this method is preferred over RemoveDynamicTag() when there are multiple tags that
-	 * should be applied at the same time, to avoid unnecessary overhead from re-applying all passive GEs.
+	 * proficiency, etc. If passive GEs are currently active on this ASC, the passive GEs that depend on the tags (and
+	 * any passive GEs that depend on those GEs) will be re-applied when this method is called. Consequently, calling
+	 * this method is preferred over RemoveDynamicTag() when there are multiple tags that should be applied at the same
+	 * time, to avoid unnecessary overhead from re-applying passive GEs multiple times.
 	 *
 	 * @param Tags
 	 *	The tags to remove from this Ability System Component.
@@ -243,11 +251,37 @@ public:
 	/**
 	 * Clears all of the dynamic tags that were previously added to this ASC.
 	 *
-	 * If passive GEs are currently active on this ASC, they will be re-applied when this method is called.
+	 * If passive GEs are currently active on this ASC, the passive GEs that depend on the removed tags (and any passive
+	 * GEs that depend on those GEs) will be re-applied when this method is called.
 	 */
 	UFUNCTION(BlueprintCallable, Category="OpenPF2|Ability System Components")
 	virtual void RemoveAllDynamicTags() = 0;
 
+	/**
+	 * Starts a batch of changes to the passive GEs and dynamic tags of this ASC.
+	 *
+	 * Until the batch is ended with EndPassiveGameplayEffectBatch(), changes made by methods that would normally
+	 * re-apply passive GEs (adding or setting passive GEs, changing dynamic tags, applying ability boosts, and
+	 * activating all passive GEs) are recorded instead of being applied right away. When the batch ends, all of the
+	 * changes are reconciled at once, so that passive GEs are only re-applied a single time, and only to the extent
+	 * needed.
+	 *
+	 * Batches can be nested. Changes are only reconciled when the outermost batch ends. Every call to this method must
+	 * be paired with a call to EndPassiveGameplayEffectBatch(). In C++, prefer FPF2PassiveEffectBatch, which ends the
+	 * batch automatically when it goes out of scope.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Ability System Components")
+	virtual void BeginPassiveGameplayEffectBatch() = 0;
+
+	/**
+	 * Ends a batch of changes to the passive GEs and dynamic tags of this ASC.
+	 *
+	 * If this ends the outermost batch, all of the changes made since the batch was started are reconciled, and any
+	 * passive GEs affected by those changes are re-applied.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Ability System Components")
+	virtual void EndPassiveGameplayEffectBatch() = 0;
+
 	/**
 	 * Gets all of the tags that are active on this ASC as a result of active GEs and Gameplay Cues.
 	 *
@@ -256,4 +290,51 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="OpenPF2|Ability System Components")
 	virtual FGameplayTagContainer GetActiveGameplayTags() const = 0;
+
+	/**
+	 * Finds the spec of an ability that has been granted to this ASC, by the class of the ability.
+	 *
+	 * This is equivalent to FindAbilitySpecFromClass(), but does not need to scan all the abilities of this ASC.
+	 *
+	 * @param AbilityClass
+	 *	The type of ability for which a spec is desired.
+	 *
+	 * @return
+	 *	Either the first spec that was granted for an ability of the exact given type; or, nullptr if this ASC has not
+	 *	been granted an ability of that type.
+	 */
+	virtual FGameplayAbilitySpec* FindAbilitySpecByClass(const TSubclassOf<UGameplayAbility> AbilityClass) const = 0;
+
+	/**
+	 * Finds the specs of all abilities that have been granted to this ASC and have all of the specified ability tags.
+	 *
+	 * This is equivalent to GetActivatableGameplayAbilitySpecsByAllMatchingTags() without tag requirement checks, but
+	 * only examines the abilities that have at least one of the tags instead of all the abilities of this ASC.
+	 *
+	 * @param Tags
+	 *	The tags that each ability must have. Parent tags match any of their child tags.
+	 *
+	 * @return
+	 *	The specs of all the matching abilities, in the order they were granted.
+	 */
+	virtual TArray<FGameplayAbilitySpec*> FindAbilitySpecsByTags(const FGameplayTagContainer& Tags) const = 0;
+
+	/**
+	 * Grants several abilities to this ASC at once.
+	 *
+	 * Each spec is granted through GiveAbility(), so each ability is validated, replicated, and announced the same way
+	 * as an ability granted on its own. The list of abilities of this ASC is grown only once for all of the specs, and
+	 * the specs are granted together, in order, once all of them have been queued. This should be used instead of
+	 * GiveAbility() when granting many abilities at the same time (e.g., while setting up a high-level character).
+	 *
+	 * This can only be called on the server. When called on a client, a warning is logged and no abilities are granted.
+	 *
+	 * @param Specs
+	 *	The specs of the abilities to grant.
+	 *
+	 * @return
+	 *	The handle of each granted ability, in the same order as the specs; or an empty array, if called on a client.
+	 *	The handle of a spec that does not have a valid ability is invalid, and that spec is skipped.
+	 */
+	virtual TArray<FGameplayAbilitySpecHandle> GiveAbilities(const TArray<FGameplayAbilitySpec>& Specs) = 0;
 };
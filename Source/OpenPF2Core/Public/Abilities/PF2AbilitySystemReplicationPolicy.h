@@ -0,0 +1,44 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <UObject/ObjectMacros.h>
+
+#include "PF2AbilitySystemReplicationPolicy.generated.h"
+
+/**
+ * An enumeration of the ways that the Gameplay Effects (GEs) on the ASC of a character can be replicated to clients.
+ *
+ * Attributes and gameplay tags (including the tags granted by passive GEs and the dynamic tags of the ASC) are always
+ * replicated, so stats and other derived values shown in the UI are available on every client no matter which policy
+ * is used. The policy only controls whether clients also receive the active GEs themselves.
+ */
+UENUM(BlueprintType)
+enum class EPF2AbilitySystemReplicationPolicy : uint8
+{
+	/**
+	 * Use "Mixed" replication while the character is controlled by a player, and "Minimal" replication otherwise.
+	 *
+	 * This is the best choice for most characters. The owning player receives all active GEs of their own character,
+	 * while other clients (and all clients, for NPCs) only receive tags, cues, and attributes.
+	 */
+	Automatic,
+
+	/**
+	 * Replicate all active GEs to all clients.
+	 */
+	Full,
+
+	/**
+	 * Replicate all active GEs to the owning client, and only tags, cues, and attributes to other clients.
+	 */
+	Mixed,
+
+	/**
+	 * Only replicate tags, cues, and attributes to all clients; active GEs are never replicated.
+	 */
+	Minimal,
+};
@@ -0,0 +1,70 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayEffect.h>
+#include <GameplayEffectTypes.h>
+
+/**
+ * A passive Gameplay Effect (GE) that an ASC has applied, along with the handle of the resulting active GE.
+ *
+ * Tracking the handle allows the ASC to remove its passive GEs directly, without having to search through all the
+ * active GEs on the ASC (which may include many GEs that are unrelated to passive GEs).
+ */
+struct OPENPF2CORE_API FPF2ActivePassiveEffect
+{
+	/**
+	 * The passive GEs that were applied.
+	 *
+	 * This is a single GE unless several passive GEs were combined into a composite GE, in which case this is all of
+	 * the GEs that were combined.
+	 */
+	TArray<TSubclassOf<UGameplayEffect>, TInlineAllocator<1>> Effects;
+
+	/**
+	 * The handle of the active GE that resulted from applying the passive GE.
+	 */
+	FActiveGameplayEffectHandle Handle;
+
+	/**
+	 * Determines whether the active GE applies the specified passive GE.
+	 *
+	 * @param Effect
+	 *	The GE to check.
+	 *
+	 * @return
+	 *	- TRUE if the GE is one of the GEs that were applied.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool ContainsEffect(const TSubclassOf<UGameplayEffect> Effect) const
+	{
+		return this->Effects.Contains(Effect);
+	}
+
+	/**
+	 * Determines whether the active GE applies any of the specified passive GEs.
+	 *
+	 * @param OtherEffects
+	 *	The GEs to check.
+	 *
+	 * @return
+	 *	- TRUE if at least one of the GEs is one of the GEs that were applied.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool ContainsAnyEffect(const TSet<TSubclassOf<UGameplayEffect>>& OtherEffects) const
+	{
+		for (const TSubclassOf<UGameplayEffect>& Effect : this->Effects)
+		{
+			if (OtherEffects.Contains(Effect))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
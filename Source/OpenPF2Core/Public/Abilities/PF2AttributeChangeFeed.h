@@ -0,0 +1,154 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <AttributeSet.h>
+#include <CoreMinimal.h>
+#include <GameplayTagContainer.h>
+
+#include "Abilities/PF2AttributeRegistry.h"
+
+#include "PF2AttributeChangeFeed.generated.h"
+
+/**
+ * The attributes and tags of a character that changed during a single frame.
+ */
+USTRUCT(BlueprintType)
+struct OPENPF2CORE_API FPF2AttributeChangeSet
+{
+	GENERATED_BODY()
+
+	/**
+	 * The attributes that changed, in the order of PF2_ATTRIBUTES.
+	 */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FGameplayAttribute> Attributes;
+
+	/**
+	 * The tags that were added to or removed from the character.
+	 */
+	UPROPERTY(BlueprintReadOnly)
+	FGameplayTagContainer Tags;
+
+	/**
+	 * One bit for each attribute in the attribute registry, set if that attribute changed.
+	 *
+	 * This allows native listeners to check for a specific attribute without scanning the list of attributes.
+	 */
+	TBitArray<> AttributeFlags;
+
+	/**
+	 * Determines whether the attribute at the specified index changed.
+	 *
+	 * @param Index
+	 *	The index of the attribute in the attribute registry.
+	 *
+	 * @return
+	 *	- TRUE if the attribute changed.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool ContainsAttribute(const EPF2AttributeIndex Index) const
+	{
+		const int32 BitIndex = PF2AttributeRegistry::ToInt(Index);
+
+		return this->AttributeFlags.IsValidIndex(BitIndex) && this->AttributeFlags[BitIndex];
+	}
+};
+
+/**
+ * Delegate for Blueprints to receive the attributes and tags of a character that changed during a frame.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+	FPF2AttributeChangeSetDelegate,
+	const FPF2AttributeChangeSet&,
+	Changes
+);
+
+/**
+ * Delegate for native code to receive the attributes and tags of a character that changed during a frame.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FPF2AttributeChangeSetNativeDelegate, const FPF2AttributeChangeSet&);
+
+/**
+ * Accumulates the attributes and tags of a character that change during a frame.
+ *
+ * Re-applying passive GEs can change dozens of attributes and tags at once, each of which would otherwise notify UI
+ * separately. The ASC marks each change here as it happens, then consumes all of them at the end of the frame to send
+ * a single notification.
+ */
+class OPENPF2CORE_API FPF2AttributeChangeFeed
+{
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * One bit for each attribute in the attribute registry, set if that attribute has changed this frame.
+	 */
+	TBitArray<> ChangedAttributes;
+
+	/**
+	 * The number of attributes that have changed this frame.
+	 */
+	int32 NumChangedAttributes;
+
+	/**
+	 * The tags that have been added or removed this frame.
+	 */
+	FGameplayTagContainer ChangedTags;
+
+public:
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Default constructor for FPF2AttributeChangeFeed.
+	 */
+	explicit FPF2AttributeChangeFeed() :
+		ChangedAttributes(false, PF2AttributeRegistry::Num),
+		NumChangedAttributes(0)
+	{
+	}
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Determines whether any attributes or tags have changed since changes were last consumed.
+	 *
+	 * @return
+	 *	- TRUE if there are changes to consume.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool HasChanges() const
+	{
+		return (this->NumChangedAttributes != 0) || !this->ChangedTags.IsEmpty();
+	}
+
+	/**
+	 * Marks an attribute as having changed this frame.
+	 *
+	 * @param Index
+	 *	The index of the attribute in the attribute registry.
+	 */
+	void MarkAttributeChanged(const EPF2AttributeIndex Index);
+
+	/**
+	 * Marks a tag as having been added or removed this frame.
+	 *
+	 * @param Tag
+	 *	The tag that was added or removed.
+	 */
+	void MarkTagChanged(const FGameplayTag Tag);
+
+	/**
+	 * Gets all the changes made since changes were last consumed, and clears them.
+	 *
+	 * @return
+	 *	The attributes and tags that changed.
+	 */
+	FPF2AttributeChangeSet ConsumeChanges();
+};
@@ -0,0 +1,68 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <AttributeSet.h>
+
+#include "PF2AttributeData.generated.h"
+
+/**
+ * The value of a replicated OpenPF2 character attribute.
+ *
+ * This is identical to FGameplayAttributeData except for how it is sent over the network. Almost every PF2 statistic
+ * is a whole number, so whenever both the base and current value of an attribute are whole numbers, they are sent as
+ * variable-length integers instead of as two 32-bit floats; and the current value is omitted entirely when it matches
+ * the base value. Attributes that have a fractional value are sent as floats, so the encoding is always lossless.
+ *
+ * Integer encoding can be turned off on the server with the "OpenPF2.QuantizeAttributes" console variable. Clients
+ * always accept both encodings.
+ */
+USTRUCT(BlueprintType)
+struct OPENPF2CORE_API FPF2AttributeData : public FGameplayAttributeData
+{
+	GENERATED_BODY()
+
+	/**
+	 * Default constructor for FPF2AttributeData.
+	 */
+	FPF2AttributeData() : FGameplayAttributeData()
+	{
+	}
+
+	/**
+	 * Constructor for FPF2AttributeData.
+	 *
+	 * @param DefaultValue
+	 *	The initial base and current value of the attribute.
+	 */
+	FPF2AttributeData(const float DefaultValue) : FGameplayAttributeData(DefaultValue)
+	{
+	}
+
+	/**
+	 * Serializes this attribute value for replication.
+	 *
+	 * @param Ar
+	 *	The archive to which the value is written, or from which the value is read.
+	 * @param Map
+	 *	The package map for the connection (unused).
+	 * @param bOutSuccess
+	 *	Set to whether the value was serialized successfully.
+	 *
+	 * @return
+	 *	Always TRUE, since this struct has handled its own serialization.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPF2AttributeData> : public TStructOpsTypeTraitsBase2<FPF2AttributeData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
@@ -0,0 +1,50 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <UObject/ObjectMacros.h>
+
+#include "PF2AttributeGroup.generated.h"
+
+/**
+ * Flags for the groups of attributes in UPF2AttributeSet that a character can use.
+ *
+ * Every character has every attribute, but only the attributes in the groups that a character uses are calculated by
+ * the core GEs of the character and derived on clients. Attributes in other groups keep their default values, and
+ * since attributes are only replicated when they change, they are never sent to clients. This allows NPCs and hazards
+ * to skip the calculations for data that only matters to player characters (e.g., ability boosts, feat limits, or
+ * skills) without giving up the attribute set that existing GEs are authored against.
+ */
+UENUM(BlueprintType, meta=(Bitflags, UseEnumValuesAsMaskValuesInEditor="true"))
+enum class EPF2AttributeGroup : uint8
+{
+	None              = 0 UMETA(Hidden),
+
+	/**
+	 * Ability scores, class DC, speed, AC, saving throws, hit points, Perception, spell statistics, and encounter
+	 * points.
+	 */
+	Core              = 1 << 0,
+
+	/**
+	 * Skill modifiers.
+	 */
+	Skills            = 1 << 1,
+
+	/**
+	 * Experience, ability boosts, and feat limits, which only matter while building or advancing a character.
+	 */
+	CharacterBuilding = 1 << 2 UMETA(DisplayName="Character Building"),
+
+	/**
+	 * Damage resistances.
+	 */
+	Resistances       = 1 << 3,
+
+	All               = Core | Skills | CharacterBuilding | Resistances UMETA(Hidden),
+};
+
+ENUM_CLASS_FLAGS(EPF2AttributeGroup)
@@ -0,0 +1,283 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <AttributeSet.h>
+
+#include "Abilities/PF2AttributeGroup.h"
+
+// =====================================================================================================================
+// Macros
+// =====================================================================================================================
+/**
+ * The single list of all attributes in UPF2AttributeSet that are replicated.
+ *
+ * Each entry has the form X(Name, Category, DefaultValue, Replication), where:
+ *	- Name is the name of the attribute property in UPF2AttributeSet.
+ *	- Category is the EPF2AttributeCategory of the attribute.
+ *	- DefaultValue is the value that the attribute has when the attribute set is constructed.
+ *	- Replication is how the attribute is replicated; one of Public (to all connections), OwnerOnly (only to the
+ *	  owner), DerivedStat (to all connections, unless clients derive it), OwnerDerivedStat (only to the owner,
+ *	  unless clients derive it), or Mirrored (never, because its value reaches clients through another replicated
+ *	  property, such as the damage type table).
+ *
+ * Entries must be in the same order that attributes are declared in UPF2AttributeSet, since this list is also used to
+ * generate the initializer list of its constructor. Everything else that needs a per-attribute declaration or
+ * definition (accessors, replication registration, rep notifies, capture definitions, and the dense index of each
+ * attribute) is generated from this list, so adding an attribute only requires adding its property to the attribute
+ * set and an entry here.
+ */
+#define PF2_REPLICATED_ATTRIBUTES(X) \
+	X(Experience,             Advancement,     0.0f,  OwnerOnly)        \
+	X(AbBoostCount,           Advancement,     0.0f,  OwnerOnly)        \
+	X(AbBoostLimit,           Advancement,     0.0f,  OwnerOnly)        \
+	X(AbStrength,             Ability,         10.0f, Public)           \
+	X(AbStrengthModifier,     AbilityModifier, 0.0f,  Public)           \
+	X(AbDexterity,            Ability,         10.0f, Public)           \
+	X(AbDexterityModifier,    AbilityModifier, 0.0f,  Public)           \
+	X(AbConstitution,         Ability,         10.0f, Public)           \
+	X(AbConstitutionModifier, AbilityModifier, 0.0f,  Public)           \
+	X(AbIntelligence,         Ability,         10.0f, Public)           \
+	X(AbIntelligenceModifier, AbilityModifier, 0.0f,  Public)           \
+	X(AbWisdom,               Ability,         10.0f, Public)           \
+	X(AbWisdomModifier,       AbilityModifier, 0.0f,  Public)           \
+	X(AbCharisma,             Ability,         10.0f, Public)           \
+	X(AbCharismaModifier,     AbilityModifier, 0.0f,  Public)           \
+	X(ClassDifficultyClass,   Character,       0.0f,  OwnerDerivedStat) \
+	X(Speed,                  Character,       1.0f,  Public)           \
+	X(MaxSpeed,               Character,       1.0f,  Public)           \
+	X(ArmorClass,             Character,       10.0f, DerivedStat)      \
+	X(StFortitudeModifier,    SavingThrow,     0.0f,  OwnerDerivedStat) \
+	X(StReflexModifier,       SavingThrow,     0.0f,  OwnerDerivedStat) \
+	X(StWillModifier,         SavingThrow,     0.0f,  OwnerDerivedStat) \
+	X(HitPoints,              Character,       1.0f,  Public)           \
+	X(MaxHitPoints,           Character,       1.0f,  Public)           \
+	X(RstPhysicalBludgeoning, Resistance,      0.0f,  Mirrored)         \
+	X(RstPhysicalPiercing,    Resistance,      0.0f,  Mirrored)         \
+	X(RstPhysicalSlashing,    Resistance,      0.0f,  Mirrored)         \
+	X(RstEnergyAcid,          Resistance,      0.0f,  Mirrored)         \
+	X(RstEnergyCold,          Resistance,      0.0f,  Mirrored)         \
+	X(RstEnergyFire,          Resistance,      0.0f,  Mirrored)         \
+	X(RstEnergySonic,         Resistance,      0.0f,  Mirrored)         \
+	X(RstEnergyPositive,      Resistance,      0.0f,  Mirrored)         \
+	X(RstEnergyNegative,      Resistance,      0.0f,  Mirrored)         \
+	X(RstEnergyForce,         Resistance,      0.0f,  Mirrored)         \
+	X(RstAlignmentChaotic,    Resistance,      0.0f,  Mirrored)         \
+	X(RstAlignmentEvil,       Resistance,      0.0f,  Mirrored)         \
+	X(RstAlignmentGood,       Resistance,      0.0f,  Mirrored)         \
+	X(RstAlignmentLawful,     Resistance,      0.0f,  Mirrored)         \
+	X(RstMental,              Resistance,      0.0f,  Mirrored)         \
+	X(RstPoison,              Resistance,      0.0f,  Mirrored)         \
+	X(RstBleed,               Resistance,      0.0f,  Mirrored)         \
+	X(RstPrecision,           Resistance,      0.0f,  Mirrored)         \
+	X(PerceptionModifier,     Character,       0.0f,  OwnerDerivedStat) \
+	X(SkAcrobaticsModifier,   Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkArcanaModifier,       Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkAthleticsModifier,    Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkCraftingModifier,     Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkDeceptionModifier,    Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkDiplomacyModifier,    Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkIntimidationModifier, Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkLore1Modifier,        Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkLore2Modifier,        Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkMedicineModifier,     Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkNatureModifier,       Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkOccultismModifier,    Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkPerformanceModifier,  Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkReligionModifier,     Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkSocietyModifier,      Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkStealthModifier,      Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkSurvivalModifier,     Skill,           0.0f,  OwnerDerivedStat) \
+	X(SkThieveryModifier,     Skill,           0.0f,  OwnerDerivedStat) \
+	X(SpellAttackRoll,        Spell,           0.0f,  OwnerOnly)        \
+	X(SpellDifficultyClass,   Spell,           0.0f,  OwnerOnly)        \
+	X(FeAncestryFeatCount,    Feat,            0.0f,  OwnerOnly)        \
+	X(FeAncestryFeatLimit,    Feat,            0.0f,  OwnerOnly)        \
+	X(EncActionPoints,        Encounter,       0.0f,  Public)           \
+	X(EncReactionPoints,      Encounter,       0.0f,  Public)
+
+/**
+ * The single list of all attributes in UPF2AttributeSet, including server-side meta attributes that never replicate.
+ *
+ * See PF2_REPLICATED_ATTRIBUTES for the form of each entry.
+ */
+#define PF2_ATTRIBUTES(X) \
+	PF2_REPLICATED_ATTRIBUTES(X) \
+	X(TmpDamageIncoming, Temporary, 0.0f, None)
+
+// =====================================================================================================================
+// Normal Declarations
+// =====================================================================================================================
+/**
+ * The broad group to which an attribute in UPF2AttributeSet belongs.
+ */
+enum class EPF2AttributeCategory : uint8
+{
+	/**
+	 * General character statistics (class DC, speed, AC, hit points, and Perception).
+	 */
+	Character,
+
+	/**
+	 * Experience and ability boosts, which only matter while advancing a character.
+	 */
+	Advancement,
+
+	/**
+	 * Ability scores.
+	 */
+	Ability,
+
+	/**
+	 * Ability modifiers.
+	 */
+	AbilityModifier,
+
+	/**
+	 * Saving throw modifiers.
+	 */
+	SavingThrow,
+
+	/**
+	 * Damage resistances.
+	 */
+	Resistance,
+
+	/**
+	 * Skill modifiers.
+	 */
+	Skill,
+
+	/**
+	 * Spell attack roll and spell DC.
+	 */
+	Spell,
+
+	/**
+	 * Feat counts and limits.
+	 */
+	Feat,
+
+	/**
+	 * Points that are only meaningful during an encounter.
+	 */
+	Encounter,
+
+	/**
+	 * Server-side meta attributes that are only used during calculations.
+	 */
+	Temporary,
+};
+
+/**
+ * The dense index of each attribute in UPF2AttributeSet, in the order of PF2_ATTRIBUTES.
+ *
+ * This allows per-attribute data to be kept in flat arrays instead of maps keyed on attribute names.
+ */
+enum class EPF2AttributeIndex : uint8
+{
+#define PF2_DECLARE_ATTRIBUTE_INDEX(Name, Category, DefaultValue, Replication) Name,
+	PF2_ATTRIBUTES(PF2_DECLARE_ATTRIBUTE_INDEX)
+#undef PF2_DECLARE_ATTRIBUTE_INDEX
+
+	/**
+	 * The number of attributes in UPF2AttributeSet. Not a valid index.
+	 */
+	Count
+};
+
+/**
+ * Registry of the attributes in UPF2AttributeSet, generated from PF2_ATTRIBUTES.
+ */
+namespace PF2AttributeRegistry
+{
+	/**
+	 * The number of attributes in UPF2AttributeSet.
+	 */
+	constexpr int32 Num = static_cast<int32>(EPF2AttributeIndex::Count);
+
+	/**
+	 * Gets the position of an attribute in the registry, for indexing into arrays that have one element per attribute.
+	 *
+	 * @param Index
+	 *	The index of the attribute.
+	 *
+	 * @return
+	 *	The position of the attribute, from 0 to Num - 1.
+	 */
+	FORCEINLINE constexpr int32 ToInt(const EPF2AttributeIndex Index)
+	{
+		return static_cast<int32>(Index);
+	}
+
+	/**
+	 * Gets the gameplay attribute at the specified index.
+	 *
+	 * @param Index
+	 *	The index of the attribute. Must not be EPF2AttributeIndex::Count.
+	 *
+	 * @return
+	 *	The gameplay attribute.
+	 */
+	OPENPF2CORE_API const FGameplayAttribute& GetAttribute(const EPF2AttributeIndex Index);
+
+	/**
+	 * Gets the name of the attribute at the specified index.
+	 *
+	 * @param Index
+	 *	The index of the attribute. Must not be EPF2AttributeIndex::Count.
+	 *
+	 * @return
+	 *	The name of the attribute property.
+	 */
+	OPENPF2CORE_API FName GetName(const EPF2AttributeIndex Index);
+
+	/**
+	 * Gets the category of the attribute at the specified index.
+	 *
+	 * @param Index
+	 *	The index of the attribute. Must not be EPF2AttributeIndex::Count.
+	 *
+	 * @return
+	 *	The category of the attribute.
+	 */
+	OPENPF2CORE_API EPF2AttributeCategory GetCategory(const EPF2AttributeIndex Index);
+
+	/**
+	 * Gets the group of the attribute at the specified index.
+	 *
+	 * @param Index
+	 *	The index of the attribute. Must not be EPF2AttributeIndex::Count.
+	 *
+	 * @return
+	 *	The group that a character must use for the attribute to be calculated on it.
+	 */
+	OPENPF2CORE_API EPF2AttributeGroup GetGroup(const EPF2AttributeIndex Index);
+
+	/**
+	 * Looks up the index of a gameplay attribute.
+	 *
+	 * @param Attribute
+	 *	The attribute for which an index is desired.
+	 *
+	 * @return
+	 *	Either the index of the attribute; or EPF2AttributeIndex::Count if the attribute is not an attribute of
+	 *	UPF2AttributeSet.
+	 */
+	OPENPF2CORE_API EPF2AttributeIndex IndexOf(const FGameplayAttribute& Attribute);
+
+	/**
+	 * Looks up the index of an attribute by the name of its property.
+	 *
+	 * @param Name
+	 *	The name of the attribute property.
+	 *
+	 * @return
+	 *	Either the index of the attribute; or EPF2AttributeIndex::Count if UPF2AttributeSet does not have an attribute
+	 *	with the given name.
+	 */
+	OPENPF2CORE_API EPF2AttributeIndex IndexOfName(const FName Name);
+}
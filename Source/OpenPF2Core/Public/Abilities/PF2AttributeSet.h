@@ -14,6 +14,12 @@
 
 #include <AttributeSet.h>
 #include <AbilitySystemComponent.h>
+#include <Engine/EngineTypes.h>
+
+#include "Abilities/PF2AttributeData.h"
+#include "Abilities/PF2AttributeRegistry.h"
+#include "Abilities/PF2DamageTypeTable.h"
+#include "Abilities/PF2DerivedStatistics.h"
 
 #include "PF2AttributeSet.generated.h"
 
@@ -27,6 +33,9 @@
 	GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
 	GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
+#define PF2_DECLARE_ATTRIBUTE_ACCESSORS(Name, Category, DefaultValue, Replication) \
+	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, Name)
+
 // =====================================================================================================================
 // Forward Declarations (to break recursive dependencies)
 // =====================================================================================================================
@@ -65,8 +74,7 @@ public:
 	 * progressing toward the next level."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Experience", ReplicatedUsing=OnRep_Experience)
-	FGameplayAttributeData Experience;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, Experience)
+	FPF2AttributeData Experience;
 
 	// Ability Scores --------------------------------------------------------------------------------------------------
 	/**
@@ -75,8 +83,7 @@ public:
 	 * Capped by AbBoostLimit.
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbBoostCount)
-	FGameplayAttributeData AbBoostCount;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbBoostCount)
+	FPF2AttributeData AbBoostCount;
 
 	/**
 	 * The limit on how many ability boosts this character can apply.
@@ -85,8 +92,7 @@ public:
 	 * ability boosts that the player or story (for NPCs) has not yet applied.
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbBoostLimit)
-	FGameplayAttributeData AbBoostLimit;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbBoostLimit)
+	FPF2AttributeData AbBoostLimit;
 
 	/**
 	 * Strength measures a character’s physical power.
@@ -95,8 +101,7 @@ public:
 	 * damage rolls and determines how much a character can carry. (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbStrength)
-	FGameplayAttributeData AbStrength;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbStrength)
+	FPF2AttributeData AbStrength;
 
 	/**
 	 * Strength measures a character’s physical power.
@@ -106,8 +111,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbStrengthModifier)
-	FGameplayAttributeData AbStrengthModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbStrengthModifier)
+	FPF2AttributeData AbStrengthModifier;
 
 	/**
 	 * Dexterity measures a character’s agility, balance, and reflexes.
@@ -117,8 +121,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbDexterity)
-	FGameplayAttributeData AbDexterity;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbDexterity)
+	FPF2AttributeData AbDexterity;
 
 	/**
 	 * Dexterity measures a character’s agility, balance, and reflexes.
@@ -128,8 +131,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbDexterityModifier)
-	FGameplayAttributeData AbDexterityModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbDexterityModifier)
+	FPF2AttributeData AbDexterityModifier;
 
 	/**
 	 * Constitution measures a character’s overall health and stamina.
@@ -139,8 +141,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbConstitution)
-	FGameplayAttributeData AbConstitution;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbConstitution)
+	FPF2AttributeData AbConstitution;
 
 	/**
 	 * Constitution measures a character’s overall health and stamina.
@@ -150,8 +151,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbConstitutionModifier)
-	FGameplayAttributeData AbConstitutionModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbConstitutionModifier)
+	FPF2AttributeData AbConstitutionModifier;
 
 	/**
 	 * Intelligence measures how well a character can learn and reason.
@@ -161,8 +161,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbIntelligence)
-	FGameplayAttributeData AbIntelligence;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbIntelligence)
+	FPF2AttributeData AbIntelligence;
 
 	/**
 	 * Intelligence measures how well a character can learn and reason.
@@ -172,8 +171,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbIntelligenceModifier)
-	FGameplayAttributeData AbIntelligenceModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbIntelligenceModifier)
+	FPF2AttributeData AbIntelligenceModifier;
 
 	/**
 	 * Wisdom measures a character’s common sense, awareness, and intuition.
@@ -182,8 +180,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbWisdom)
-	FGameplayAttributeData AbWisdom;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbWisdom)
+	FPF2AttributeData AbWisdom;
 
 	/**
 	 * Wisdom measures a character’s common sense, awareness, and intuition.
@@ -192,8 +189,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbWisdomModifier)
-	FGameplayAttributeData AbWisdomModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbWisdomModifier)
+	FPF2AttributeData AbWisdomModifier;
 
 	/**
 	 * Charisma measures a character’s personal magnetism and strength of personality.
@@ -202,8 +198,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbCharisma)
-	FGameplayAttributeData AbCharisma;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbCharisma)
+	FPF2AttributeData AbCharisma;
 
 	/**
 	 * Charisma measures a character’s personal magnetism and strength of personality.
@@ -212,8 +207,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 19)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Ability Scores", ReplicatedUsing=OnRep_AbCharismaModifier)
-	FGameplayAttributeData AbCharismaModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, AbCharismaModifier)
+	FPF2AttributeData AbCharismaModifier;
 
 	// Class DC --------------------------------------------------------------------------------------------------------
 	/**
@@ -222,23 +216,20 @@ public:
 	 * This controls how hard or easy certain types of tasks are for this character.
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Class DC", ReplicatedUsing=OnRep_ClassDifficultyClass)
-	FGameplayAttributeData ClassDifficultyClass;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, ClassDifficultyClass)
+	FPF2AttributeData ClassDifficultyClass;
 
 	// Speed -----------------------------------------------------------------------------------------------------------
 	/**
 	 * How fast this character can move (in centimeters per second).
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Speed", ReplicatedUsing = OnRep_Speed)
-	FGameplayAttributeData Speed;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, Speed)
+	FPF2AttributeData Speed;
 
 	/**
 	 * The maximum speed of this character (in centimeters per second).
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Speed", ReplicatedUsing = OnRep_MaxSpeed)
-	FGameplayAttributeData MaxSpeed;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, MaxSpeed)
+	FPF2AttributeData MaxSpeed;
 
 	// Armor Class -----------------------------------------------------------------------------------------------------
 	/**
@@ -248,8 +239,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 12)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Armor Class", ReplicatedUsing = OnRep_ArmorClass)
-	FGameplayAttributeData ArmorClass;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, ArmorClass)
+	FPF2AttributeData ArmorClass;
 
 	// Saving Throws ---------------------------------------------------------------------------------------------------
 	/**
@@ -257,24 +247,21 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 449)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Saving Throws", ReplicatedUsing = OnRep_StFortitudeModifier)
-	FGameplayAttributeData StFortitudeModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, StFortitudeModifier)
+	FPF2AttributeData StFortitudeModifier;
 
 	/**
 	 * Reflex saving throws measure how quickly and gracefully a character responds to a situation.
 	 * (Pathfinder 2E Core Rulebook, page 449)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Saving Throws", ReplicatedUsing = OnRep_StReflexModifier)
-	FGameplayAttributeData StReflexModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, StReflexModifier)
+	FPF2AttributeData StReflexModifier;
 
 	/**
 	 * Will saving throws measure how well a character resists attacks to mind and spirit.
 	 * (Pathfinder 2E Core Rulebook, page 449)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Saving Throws", ReplicatedUsing = OnRep_StWillModifier)
-	FGameplayAttributeData StWillModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, StWillModifier)
+	FPF2AttributeData StWillModifier;
 
 	// Hit Points ------------------------------------------------------------------------------------------------------
 	/**
@@ -291,15 +278,13 @@ public:
 	 * Capped by MaxHitPoints.
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_HitPoints)
-	FGameplayAttributeData HitPoints;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, HitPoints)
+	FPF2AttributeData HitPoints;
 
 	/**
 	 * The maximum number of hit points for this character.
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_MaxHitPoints)
-	FGameplayAttributeData MaxHitPoints;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, MaxHitPoints)
+	FPF2AttributeData MaxHitPoints;
 
 	/**
 	 * The character's resistance to Bludgeoning damage (DamageType.Physical.Bludgeoning).
@@ -309,8 +294,7 @@ public:
 	 * being dashed against rocks."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstPhysicalBludgeoning)
-	FGameplayAttributeData RstPhysicalBludgeoning;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstPhysicalBludgeoning)
+	FPF2AttributeData RstPhysicalBludgeoning;
 
 	/**
 	 * The character's resistance to Piercing damage (DamageType.Physical.Piercing).
@@ -319,8 +303,7 @@ public:
 	 * "Piercing (P) damage is dealt from stabs and punctures, whether from a dragon's fangs or the thrust of a spear."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstPhysicalPiercing)
-	FGameplayAttributeData RstPhysicalPiercing;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstPhysicalPiercing)
+	FPF2AttributeData RstPhysicalPiercing;
 
 	/**
 	 * The character's resistance to Slashing damage (DamageType.Physical.Slashing).
@@ -329,8 +312,7 @@ public:
 	 * "Slashing (S) damage is delivered by a cut, be it the swing of the sword or the blow from a scythe blades trap."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstPhysicalSlashing)
-	FGameplayAttributeData RstPhysicalSlashing;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstPhysicalSlashing)
+	FPF2AttributeData RstPhysicalSlashing;
 
 	/**
 	 * The character's resistance to Acid damage (DamageType.Energy.Acid).
@@ -340,8 +322,7 @@ public:
 	 * materials."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstEnergyAcid)
-	FGameplayAttributeData RstEnergyAcid;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstEnergyAcid)
+	FPF2AttributeData RstEnergyAcid;
 
 	/**
 	 * The character's resistance to Cold damage (DamageType.Energy.Cold).
@@ -352,8 +333,7 @@ public:
 	 *
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstEnergyCold)
-	FGameplayAttributeData RstEnergyCold;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstEnergyCold)
+	FPF2AttributeData RstEnergyCold;
 
 	/**
 	 * The character's resistance to Fire damage (DamageType.Energy.Fire).
@@ -362,8 +342,7 @@ public:
 	 * "Fire damage burns through heat and combustion."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstEnergyFire)
-	FGameplayAttributeData RstEnergyFire;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstEnergyFire)
+	FPF2AttributeData RstEnergyFire;
 
 	/**
 	 * The character's resistance to Sonic damage (DamageType.Energy.Sonic).
@@ -372,8 +351,7 @@ public:
 	 * "Sonic damage assaults matter with high-frequency vibration and sound waves."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstEnergySonic)
-	FGameplayAttributeData RstEnergySonic;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstEnergySonic)
+	FPF2AttributeData RstEnergySonic;
 
 	/**
 	 * The character's resistance to Positive damage (DamageType.Energy.Positive).
@@ -382,8 +360,7 @@ public:
 	 * "Positive damage harms only undead creatures, withering undead bodies and disrupting incorporeal undead."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstEnergyPositive)
-	FGameplayAttributeData RstEnergyPositive;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstEnergyPositive)
+	FPF2AttributeData RstEnergyPositive;
 
 	/**
 	 * The character's resistance to Negative damage (DamageType.Energy.Negative).
@@ -392,8 +369,7 @@ public:
 	 * "Negative damage saps life, damaging only living creatures."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstEnergyNegative)
-	FGameplayAttributeData RstEnergyNegative;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstEnergyNegative)
+	FPF2AttributeData RstEnergyNegative;
 
 	/**
 	 * The character's resistance to Force damage (DamageType.Energy.Force).
@@ -403,8 +379,7 @@ public:
 	 * damage—not even incorporeal creatures such as ghosts and wraiths."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstEnergyForce)
-	FGameplayAttributeData RstEnergyForce;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstEnergyForce)
+	FPF2AttributeData RstEnergyForce;
 
 	/**
 	 * The character's resistance to Chaotic damage (DamageType.Alignment.Chaotic).
@@ -413,8 +388,7 @@ public:
 	 * "Chaotic damage harms only lawful creatures."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstAlignmentChaotic)
-	FGameplayAttributeData RstAlignmentChaotic;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstAlignmentChaotic)
+	FPF2AttributeData RstAlignmentChaotic;
 
 	/**
 	 * The character's resistance to Evil damage (DamageType.Alignment.Evil).
@@ -423,8 +397,7 @@ public:
 	 * "Evil damage harms only good creatures."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstAlignmentEvil)
-	FGameplayAttributeData RstAlignmentEvil;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstAlignmentEvil)
+	FPF2AttributeData RstAlignmentEvil;
 
 	/**
 	 * The character's resistance to Good damage (DamageType.Alignment.Good).
@@ -433,8 +406,7 @@ public:
 	 * "Good damage harms only evil creatures."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstAlignmentGood)
-	FGameplayAttributeData RstAlignmentGood;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstAlignmentGood)
+	FPF2AttributeData RstAlignmentGood;
 
 	/**
 	 * The character's resistance to Lawful damage (DamageType.Alignment.Lawful).
@@ -443,8 +415,7 @@ public:
 	 * "Lawful damage harms only chaotic creatures."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstAlignmentLawful)
-	FGameplayAttributeData RstAlignmentLawful;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstAlignmentLawful)
+	FPF2AttributeData RstAlignmentLawful;
 
 	/**
 	 * The character's resistance to Mental damage (DamageType.Mental).
@@ -455,8 +426,7 @@ public:
 	 * are often immune to mental damage and effects."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstMental)
-	FGameplayAttributeData RstMental;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstMental)
+	FPF2AttributeData RstMental;
 
 	/**
 	 * The character's resistance to Poison damage (DamageType.Poison).
@@ -467,8 +437,7 @@ public:
 	 * often caused by ongoing afflictions, which follow special rules."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstPoison)
-	FGameplayAttributeData RstPoison;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstPoison)
+	FPF2AttributeData RstPoison;
 
 	/**
 	 * The character's resistance to Bleed damage (DamageType.Bleed).
@@ -478,8 +447,7 @@ public:
 	 * living creatures that don't need blood to live."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstBleed)
-	FGameplayAttributeData RstBleed;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstBleed)
+	FPF2AttributeData RstBleed;
 
 	/**
 	 * The character's resistance to Precision damage (DamageType.Precision).
@@ -489,8 +457,7 @@ public:
 	 * damage, using the same damage type, rather than tracking a separate pool of damage."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Hit Points", ReplicatedUsing=OnRep_RstPrecision)
-	FGameplayAttributeData RstPrecision;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, RstPrecision)
+	FPF2AttributeData RstPrecision;
 
 	// Perception ------------------------------------------------------------------------------------------------------
 	/**
@@ -498,8 +465,7 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 448)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Perception", ReplicatedUsing = OnRep_PerceptionModifier)
-	FGameplayAttributeData PerceptionModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, PerceptionModifier)
+	FPF2AttributeData PerceptionModifier;
 
 	// Skills ------------------------------------------------------------------------------------------------------
 	/**
@@ -507,88 +473,77 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 240)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkAcrobaticsModifier)
-	FGameplayAttributeData SkAcrobaticsModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkAcrobaticsModifier)
+	FPF2AttributeData SkAcrobaticsModifier;
 
 	/**
 	 * Arcana measures how much a character knows about arcane magic and creatures.
 	 * (Pathfinder 2E Core Rulebook, page 241)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkArcanaModifier)
-	FGameplayAttributeData SkArcanaModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkArcanaModifier)
+	FPF2AttributeData SkArcanaModifier;
 
 	/**
 	 * Athletics allows a character to perform deeds of physical prowess.
 	 * (Pathfinder 2E Core Rulebook, page 241)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkAthleticsModifier)
-	FGameplayAttributeData SkAthleticsModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkAthleticsModifier)
+	FPF2AttributeData SkAthleticsModifier;
 
 	/**
 	 * Crafting allows a character to create and repair items.
 	 * (Pathfinder 2E Core Rulebook, page 243)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkCraftingModifier)
-	FGameplayAttributeData SkCraftingModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkCraftingModifier)
+	FPF2AttributeData SkCraftingModifier;
 
 	/**
 	 * Deception allows a character to trick and mislead others using disguises, lies, and other forms of subterfuge.
 	 * (Pathfinder 2E Core Rulebook, page 245)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkDeceptionModifier)
-	FGameplayAttributeData SkDeceptionModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkDeceptionModifier)
+	FPF2AttributeData SkDeceptionModifier;
 
 	/**
 	 * Diplomacy allows a character to influence others through negotiation and flattery.
 	 * (Pathfinder 2E Core Rulebook, page 245)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkDiplomacyModifier)
-	FGameplayAttributeData SkDiplomacyModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkDiplomacyModifier)
+	FPF2AttributeData SkDiplomacyModifier;
 
 	/**
 	 * Intimidation allows a character to bend others to their will using threats.
 	 * (Pathfinder 2E Core Rulebook, page 247)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkIntimidationModifier)
-	FGameplayAttributeData SkIntimidationModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkIntimidationModifier)
+	FPF2AttributeData SkIntimidationModifier;
 
 	/**
 	 * Lore gives a character specialized information on a narrow topic.
 	 * (Pathfinder 2E Core Rulebook, page 247)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkLore1Modifier)
-	FGameplayAttributeData SkLore1Modifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkLore1Modifier)
+	FPF2AttributeData SkLore1Modifier;
 
 	/**
 	 * Lore gives a character specialized information on a narrow topic.
 	 * (Pathfinder 2E Core Rulebook, page 247)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkLore2Modifier)
-	FGameplayAttributeData SkLore2Modifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkLore2Modifier)
+	FPF2AttributeData SkLore2Modifier;
 
 	/**
 	 * Medicine allows a character to patch up wounds and help people recover from diseases and poisons.
 	 * (Pathfinder 2E Core Rulebook, page 248)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkMedicineModifier)
-	FGameplayAttributeData SkMedicineModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkMedicineModifier)
+	FPF2AttributeData SkMedicineModifier;
 
 	/**
 	 * Nature gives a character knowledge about the natural world, including commanding and training animals and beasts.
 	 * (Pathfinder 2E Core Rulebook, page 249)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkNatureModifier)
-	FGameplayAttributeData SkNatureModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkNatureModifier)
+	FPF2AttributeData SkNatureModifier;
 
 	/**
 	 * Occultism gives a character knowledge about ancient philosophies, esoteric lore, obscure mysticism, and
@@ -597,72 +552,63 @@ public:
 	 * (Pathfinder 2E Core Rulebook, page 249)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkOccultismModifier)
-	FGameplayAttributeData SkOccultismModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkOccultismModifier)
+	FPF2AttributeData SkOccultismModifier;
 
 	/**
 	 * Performance gives a character skill impressing crowds by performing live.
 	 * (Pathfinder 2E Core Rulebook, page 250)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkPerformanceModifier)
-	FGameplayAttributeData SkPerformanceModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkPerformanceModifier)
+	FPF2AttributeData SkPerformanceModifier;
 
 	/**
 	 * Religion gives a character knowledge of the secrets of deities, dogma, faith, and the realms of divine
 	 * creatures -- both sublime and sinister. (Pathfinder 2E Core Rulebook, page 250)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkReligionModifier)
-	FGameplayAttributeData SkReligionModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkReligionModifier)
+	FPF2AttributeData SkReligionModifier;
 
 	/**
 	 * Society gives a character an understanding of the people and systems that make civilization run, including the
 	 * historical events that make societies what they are today. (Pathfinder 2E Core Rulebook, page 250)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkSocietyModifier)
-	FGameplayAttributeData SkSocietyModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkSocietyModifier)
+	FPF2AttributeData SkSocietyModifier;
 
 	/**
 	 * Stealth gives a character the ability to avoid detection, slip past foes, hide, and conceal items.
 	 * (Pathfinder 2E Core Rulebook, page 251)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkStealthModifier)
-	FGameplayAttributeData SkStealthModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkStealthModifier)
+	FPF2AttributeData SkStealthModifier;
 
 	/**
 	 * Survival gives a character aptitude to live in the wilderness, foraging for food, and building shelter.
 	 * (Pathfinder 2E Core Rulebook, page 252)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkSurvivalModifier)
-	FGameplayAttributeData SkSurvivalModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkSurvivalModifier)
+	FPF2AttributeData SkSurvivalModifier;
 
 	/**
 	 * Thievery gives a character training in the particular set of skills favored by thieves and miscreants.
 	 * (Pathfinder 2E Core Rulebook, page 253)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Skills", ReplicatedUsing = OnRep_SkThieveryModifier)
-	FGameplayAttributeData SkThieveryModifier;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SkThieveryModifier)
+	FPF2AttributeData SkThieveryModifier;
 
 	/**
 	 * A measure of how potent a character's spells are against the defenses of other creatures.
 	 * (Pathfinder 2E Core Rulebook, "Spell Attack Roll and Spell DC", page 298)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Spells", ReplicatedUsing=OnRep_SpellAttackRoll)
-	FGameplayAttributeData SpellAttackRoll;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SpellAttackRoll)
+	FPF2AttributeData SpellAttackRoll;
 
 	/**
 	 * How hard it is to resist a character's spells with saving throws, or to counteract them.
 	 * (Pathfinder 2E Core Rulebook, page 636)
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Spells", ReplicatedUsing=OnRep_SpellDifficultyClass)
-	FGameplayAttributeData SpellDifficultyClass;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, SpellDifficultyClass)
+	FPF2AttributeData SpellDifficultyClass;
 
 	// Feats -----------------------------------------------------------------------------------------------------------
 	/**
@@ -671,8 +617,7 @@ public:
 	 * Capped by FeAncestryFeatLimit.
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Feats", ReplicatedUsing=OnRep_FeAncestryFeatCount)
-	FGameplayAttributeData FeAncestryFeatCount;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, FeAncestryFeatCount)
+	FPF2AttributeData FeAncestryFeatCount;
 
 	/**
 	 * The limit on how many ancestry feats this character can apply.
@@ -681,8 +626,7 @@ public:
 	 * for additional ancestry feats that the player or story (for NPCs) has not yet applied.
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Feats", ReplicatedUsing=OnRep_FeAncestryFeatLimit)
-	FGameplayAttributeData FeAncestryFeatLimit;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, FeAncestryFeatLimit)
+	FPF2AttributeData FeAncestryFeatLimit;
 
 	// Encounters ------------------------------------------------------------------------------------------------------
 	/**
@@ -696,8 +640,7 @@ public:
 	 * can't "save" actions or reactions from one turn to use during the next turn."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Encounters", ReplicatedUsing=OnRep_EncActionPoints)
-	FGameplayAttributeData EncActionPoints;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, EncActionPoints)
+	FPF2AttributeData EncActionPoints;
 
 	/**
 	 * The number of reaction points this character has available in the current encounter.
@@ -710,8 +653,7 @@ public:
 	 * You can use 1 [...] reaction with a trigger of “Your turn begins” or something similar."
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Encounters", ReplicatedUsing=OnRep_EncReactionPoints)
-	FGameplayAttributeData EncReactionPoints;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, EncReactionPoints)
+	FPF2AttributeData EncReactionPoints;
 
 	// Transient/Temporary Attributes ----------------------------------------------------------------------------------
 	/**
@@ -723,227 +665,462 @@ public:
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Temporary Attributes")
 	FGameplayAttributeData TmpDamageIncoming;
-	ATTRIBUTE_ACCESSORS(UPF2AttributeSet, TmpDamageIncoming)
+
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The derived statistics for which the server has a different value than clients derive on their own.
+	 *
+	 * This is only replicated when clients derive statistics locally (see FPF2DerivedStatistics).
+	 */
+	UPROPERTY(Replicated)
+	TArray<FPF2DerivedStatisticOverride> DerivedStatisticOverrides;
+
+	/**
+	 * A checksum of the value of every derived statistic on the server.
+	 *
+	 * This is only replicated when clients derive statistics locally (see FPF2DerivedStatistics).
+	 */
+	UPROPERTY(Replicated)
+	uint32 DerivedStatisticsChecksum;
+
+	/**
+	 * The last server checksum of derived statistics that a client reported it does not match.
+	 *
+	 * This keeps a client from reporting the same divergence every time it receives an update.
+	 */
+	uint32 LastMismatchedDerivedStatisticsChecksum;
+
+	/**
+	 * The timer that verifies the statistics derived on a client against the server checksum, if one is pending.
+	 */
+	FTimerHandle DerivedStatisticsVerificationTimer;
+
+	/**
+	 * The resistance, weakness, and immunity of this character to each type of damage.
+	 *
+	 * The resistance to each damage type that has an "Rst" attribute (e.g., RstEnergyFire) mirrors the current value of
+	 * that attribute, so GEs can continue to grant resistance by modifying those attributes. This table is what gets
+	 * replicated to the owner, instead of the attributes themselves.
+	 */
+	UPROPERTY(Replicated)
+	FPF2DamageTypeTable DamageTypeTable;
+
+	/**
+	 * The groups of attributes that the character that owns this attribute set uses.
+	 *
+	 * Attributes in other groups are not calculated by the core GEs of the character, so they are not derived on
+	 * clients either.
+	 */
+	UPROPERTY(Replicated)
+	EPF2AttributeGroup AttributeGroups;
+
+public:
+	// =================================================================================================================
+	// Attribute Accessors
+	// =================================================================================================================
+	// Generated for every attribute in PF2_ATTRIBUTES (see PF2AttributeRegistry.h).
+	PF2_ATTRIBUTES(PF2_DECLARE_ATTRIBUTE_ACCESSORS)
 
 	// =================================================================================================================
 	// Constructors
 	// =================================================================================================================
 	explicit UPF2AttributeSet();
 
+	// =================================================================================================================
+	// UObject Overrides
+	// =================================================================================================================
+	virtual void PostNetReceive() override;
+
 	// =================================================================================================================
 	// UAttributeSet Callbacks
 	// =================================================================================================================
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
+	virtual void PreAttributeBaseChange(const FGameplayAttribute& Attribute, float& NewValue) const override;
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
 
 	// =================================================================================================================
 	// Attribute Replication Callbacks
 	// =================================================================================================================
 	// These exist to make sure that the ability system internal representations are synchronized properly during
-	// replication.
+	// replication. Their definitions are generated from PF2_REPLICATED_ATTRIBUTES, but UHT does not expand macros, so
+	// each declaration here has to be kept in sync with that list by hand.
 	UFUNCTION()
-    virtual void OnRep_Experience(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_Experience(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbBoostCount(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbBoostCount(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbBoostLimit(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbBoostLimit(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbStrength(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbStrength(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbStrengthModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbStrengthModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_AbDexterity(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_AbDexterity(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbDexterityModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbDexterityModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_AbConstitution(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_AbConstitution(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbConstitutionModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbConstitutionModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_AbIntelligence(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_AbIntelligence(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbIntelligenceModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbIntelligenceModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_AbWisdom(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_AbWisdom(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbWisdomModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbWisdomModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_AbCharisma(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_AbCharisma(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_AbCharismaModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_AbCharismaModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_ClassDifficultyClass(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_ClassDifficultyClass(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_Speed(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_Speed(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_MaxSpeed(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_MaxSpeed(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_ArmorClass(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_ArmorClass(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_StFortitudeModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_StFortitudeModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_StReflexModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_StReflexModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_StWillModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_StWillModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_HitPoints(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_HitPoints(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_MaxHitPoints(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_MaxHitPoints(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstPhysicalBludgeoning(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstPhysicalBludgeoning(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstPhysicalPiercing(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstPhysicalPiercing(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstPhysicalSlashing(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstPhysicalSlashing(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstEnergyAcid(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstEnergyAcid(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstEnergyCold(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstEnergyCold(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstEnergyFire(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstEnergyFire(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstEnergySonic(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstEnergySonic(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstEnergyPositive(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstEnergyPositive(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstEnergyNegative(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstEnergyNegative(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstEnergyForce(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstEnergyForce(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstAlignmentChaotic(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstAlignmentChaotic(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstAlignmentEvil(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstAlignmentEvil(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstAlignmentGood(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstAlignmentGood(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstAlignmentLawful(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstAlignmentLawful(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstMental(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstMental(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstPoison(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstPoison(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstBleed(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstBleed(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_RstPrecision(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_RstPrecision(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_PerceptionModifier(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_PerceptionModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkAcrobaticsModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkAcrobaticsModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkArcanaModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkArcanaModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkAthleticsModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkAthleticsModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkCraftingModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkCraftingModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkDeceptionModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkDeceptionModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkDiplomacyModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkDiplomacyModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkIntimidationModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkIntimidationModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkLore1Modifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkLore1Modifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkLore2Modifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkLore2Modifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkMedicineModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkMedicineModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkNatureModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkNatureModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkOccultismModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkOccultismModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkPerformanceModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkPerformanceModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkReligionModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkReligionModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkSocietyModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkSocietyModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkStealthModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkStealthModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkSurvivalModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkSurvivalModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_SkThieveryModifier(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_SkThieveryModifier(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-    virtual void OnRep_FeAncestryFeatCount(const FGameplayAttributeData& OldValue);
+    virtual void OnRep_FeAncestryFeatCount(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_FeAncestryFeatLimit(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_FeAncestryFeatLimit(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_SpellAttackRoll(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_SpellAttackRoll(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_SpellDifficultyClass(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_SpellDifficultyClass(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_EncReactionPoints(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_EncReactionPoints(const FPF2AttributeData& OldValue);
 
 	UFUNCTION()
-	virtual void OnRep_EncActionPoints(const FGameplayAttributeData& OldValue);
+	virtual void OnRep_EncActionPoints(const FPF2AttributeData& OldValue);
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Updates the overrides and checksum of derived statistics that the server sends to clients.
+	 *
+	 * This must only be called on the server. It has no effect unless clients derive statistics locally (see
+	 * FPF2DerivedStatistics).
+	 *
+	 * This is normally invoked by the ASC at the end of any frame in which an input changed (see
+	 * UPF2AbilitySystemComponent::ScheduleDerivedStatisticsUpdate()).
+	 */
+	void UpdateDerivedStatisticsForReplication();
+
+	/**
+	 * Derives statistics on a client from the inputs it has received.
+	 *
+	 * Any statistic the server has sent an override for takes the value of the override instead. If the result does
+	 * not match the server checksum, the statistics are verified again after a short delay, since the inputs replicate
+	 * separately and the rest of them may still be on their way. Only a divergence that outlasts the delay is reported.
+	 *
+	 * This is normally invoked by the ASC at the end of any frame in which an input arrived (see
+	 * UPF2AbilitySystemComponent::ScheduleDerivedStatisticsUpdate()).
+	 */
+	void ApplyDerivedStatistics();
+
+	/**
+	 * Notifies this attribute set that the current value of one of its attributes has changed.
+	 *
+	 * This is invoked by the owning ASC from the change delegate of the attribute (see
+	 * UPF2AbilitySystemComponent::BindAttributeValueCallbacks()), which GAS fires on every supported engine version.
+	 *
+	 * @param Attribute
+	 *	The attribute that changed.
+	 * @param OldValue
+	 *	The current value of the attribute before the change.
+	 * @param NewValue
+	 *	The current value of the attribute after the change.
+	 */
+	void NotifyAttributeValueChanged(const FGameplayAttribute& Attribute, const float OldValue, const float NewValue);
+
+	/**
+	 * Gets the groups of attributes that the character that owns this attribute set uses.
+	 *
+	 * @return
+	 *	The flags of the attribute groups in use.
+	 */
+	FORCEINLINE EPF2AttributeGroup GetAttributeGroups() const
+	{
+		return this->AttributeGroups;
+	}
+
+	/**
+	 * Sets the groups of attributes that the character that owns this attribute set uses.
+	 *
+	 * This must only be called on the server, before passive GEs are applied to the character.
+	 *
+	 * @param NewAttributeGroups
+	 *	The flags of the attribute groups in use.
+	 */
+	void SetAttributeGroups(const EPF2AttributeGroup NewAttributeGroups);
+
+	/**
+	 * Gets the resistance, weakness, and immunity of this character to each type of damage.
+	 *
+	 * @return
+	 *	The damage type table of this character.
+	 */
+	FORCEINLINE const FPF2DamageTypeTable& GetDamageTypeTable() const
+	{
+		return this->DamageTypeTable;
+	}
+
+	/**
+	 * Sets the resistance of this character to the specified type of damage.
+	 *
+	 * This is meant for damage types that do not have an "Rst" attribute (e.g., categories of damage, like
+	 * "DamageType.Physical"). The resistance to a damage type that has an attribute is overwritten by the value of the
+	 * attribute whenever the attribute changes.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type. If this is a category of damage, the resistance applies to every type in it.
+	 * @param Resistance
+	 *	The new resistance to the damage type.
+	 */
+	void SetDamageTypeResistance(const FGameplayTag DamageType, const float Resistance);
+
+	/**
+	 * Sets the weakness of this character to the specified type of damage.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type. If this is a category of damage, the weakness applies to every type in it.
+	 * @param Weakness
+	 *	The new weakness to the damage type.
+	 */
+	void SetDamageTypeWeakness(const FGameplayTag DamageType, const float Weakness);
+
+	/**
+	 * Sets whether this character is immune to the specified type of damage.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type. If this is a category of damage, the immunity applies to every type in it.
+	 * @param bIsImmune
+	 *	Whether this character is immune to the damage type.
+	 */
+	void SetDamageTypeImmunity(const FGameplayTag DamageType, const bool bIsImmune);
 
 protected:
+	// =================================================================================================================
+	// Protected Methods
+	// =================================================================================================================
+	/**
+	 * Reports if the statistics derived on a client still do not match the server checksum.
+	 */
+	void VerifyDerivedStatistics();
+
+	/**
+	 * Marks an attribute of this set as needing to be replicated, for the push model.
+	 *
+	 * @param Attribute
+	 *	The attribute that changed. Nothing happens if the attribute is not replicated.
+	 */
+	void MarkAttributeDirty(const FGameplayAttribute& Attribute) const;
+
+	/**
+	 * Derives the value of each statistic from the inputs in this attribute set and the tags and level of its owner.
+	 *
+	 * @param OutValues
+	 *	The array to which the value of each statistic is written, in the same order as
+	 *	FPF2DerivedStatistics::GetAttributes().
+	 *
+	 * @return
+	 *	- TRUE if the statistics were derived.
+	 *	- FALSE if this attribute set is not owned by a character ASC, so the inputs are not available.
+	 */
+	bool CalculateDerivedStatistics(TArray<float>& OutValues) const;
+
+	/**
+	 * Derives the value of each statistic the same way as CalculateDerivedStatistics(), then applies server overrides.
+	 *
+	 * @param OutValues
+	 *	The array to which the value of each statistic is written, in the same order as
+	 *	FPF2DerivedStatistics::GetAttributes().
+	 *
+	 * @return
+	 *	- TRUE if the statistics were derived.
+	 *	- FALSE if this attribute set is not owned by a character ASC, so the inputs are not available.
+	 */
+	bool CalculateDerivedStatisticsWithOverrides(TArray<float>& OutValues) const;
+
+	/**
+	 * Gets whether an attribute is in one of the groups of attributes that the owning character uses.
+	 *
+	 * @param Attribute
+	 *	The attribute to check.
+	 *
+	 * @return
+	 *	- TRUE if the attribute is in a group that is in use, or is not an attribute of this set.
+	 *	- FALSE, otherwise.
+	 */
+	bool IsAttributeInUse(const FGameplayAttribute& Attribute) const;
+
+	/**
+	 * Copies the value of a resistance attribute into the damage type table.
+	 *
+	 * @param Attribute
+	 *	The attribute that changed. Nothing happens if this is not a resistance attribute.
+	 * @param NewValue
+	 *	The new current value of the attribute.
+	 */
+	void MirrorResistanceAttribute(const FGameplayAttribute& Attribute, const float NewValue);
+
 	/**
 	 * Notifies this ASC that the incoming damage attribute has changed.
 	 *
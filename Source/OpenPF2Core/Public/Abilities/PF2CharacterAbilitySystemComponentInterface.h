@@ -84,10 +84,26 @@ public:
 	 * immediately. In addition, any Passive GEs in weight groups after the default weight group of the GE are
 	 * automatically re-applied.
 	 *
+	 * All of the boosts to the same ability are consolidated into a single active GE that has one stack per boost, so
+	 * each additional boost replaces the active GE for that ability rather than adding another one.
 	 *
 	 * @param TargetAbilityScore
 	 *	The ability score that will be boosted.
 	 */
 	UFUNCTION(BlueprintCallable, Category="OpenPF2|Character Ability System Components")
     virtual void ApplyAbilityBoost(const EPF2CharacterAbilityScoreType TargetAbilityScore) = 0;
+
+	/**
+	 * Updates the active passive GEs on this ASC to reflect a change to the level of the owning character.
+	 *
+	 * This must be called after the level of the owning character has changed. Passive GEs that depend on the level
+	 * have the level of their active spec updated in place, so only their level-dependent modifiers are re-evaluated.
+	 * Only passive GEs that cannot be updated in place (e.g., GEs that grant abilities or that take a snapshot of an
+	 * attribute modified by a level-dependent GE) are removed and re-applied. Passive GEs that do not depend on the
+	 * level are left untouched.
+	 *
+	 * If passive GEs are not active on this ASC, this has no effect; the new level is used when they are next activated.
+	 */
+	UFUNCTION(BlueprintCallable, Category="OpenPF2|Character Ability System Components")
+	virtual void UpdatePassiveGameplayEffectsForLevelChange() = 0;
 };
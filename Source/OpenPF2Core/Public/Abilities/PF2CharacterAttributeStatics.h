@@ -6,25 +6,17 @@
 #pragma once
 
 #include "GameplayEffectExecutionCalculation.h"
+#include "Abilities/PF2AttributeRegistry.h"
 #include "Abilities/PF2AttributeSet.h"
 
-#define DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(S, P, T, B) \
-{ \
-	DEFINE_ATTRIBUTE_CAPTUREDEF(S, P, T, B) \
-	this->CaptureDefinitions.Add(P##Property->GetName(), P##Def); \
-}
+#define PF2_DECLARE_ATTRIBUTE_CAPTUREDEF(Name, Category, DefaultValue, Replication) \
+	DECLARE_ATTRIBUTE_CAPTUREDEF(Name);
 
-#define DEFINE_ABILITY_CAPTUREDEF(S, P, T, B) \
-{ \
-	DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(S, P, T, B) \
-	this->AbilityNames.Add(P##Property->GetName()); \
-}
-
-#define DEFINE_ABILITY_MODIFIER_CAPTUREDEF(S, P, T, B) \
-{ \
-	DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(S, P, T, B) \
-	this->AbilityModifierNames.Add(P##Property->GetName()); \
-}
+#define PF2_DEFINE_ATTRIBUTE_CAPTUREDEF(Name, Category, DefaultValue, Replication) \
+	{ \
+		DEFINE_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, Name, Target, false) \
+		this->CaptureDefinitions.Add(Name##Def); \
+	}
 
 /**
  * Singleton container for PF2 character attribute capture definitions.
@@ -35,51 +27,9 @@
 class OPENPF2CORE_API FPF2CharacterAttributeStatics final
 {
 public:
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbBoostCount);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbCharisma);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbCharismaModifier);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbConstitution);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbConstitutionModifier);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbDexterity);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbDexterityModifier);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbIntelligence);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbIntelligenceModifier);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbStrength);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbStrengthModifier);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbWisdom);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(AbWisdomModifier);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(HitPoints);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstPhysicalBludgeoning);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstPhysicalPiercing);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstPhysicalSlashing);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstEnergyAcid);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstEnergyCold);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstEnergyFire);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstEnergySonic);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstEnergyPositive);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstEnergyNegative);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstEnergyForce);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstAlignmentChaotic);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstAlignmentEvil);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstAlignmentGood);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstAlignmentLawful);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstMental);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstPoison);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstBleed);
-	DECLARE_ATTRIBUTE_CAPTUREDEF(RstPrecision);
-
-	DECLARE_ATTRIBUTE_CAPTUREDEF(TmpDamageIncoming);
+	// Capture definitions (e.g., AbDexterityModifierDef and AbDexterityModifierProperty) for every attribute in
+	// PF2_ATTRIBUTES.
+	PF2_ATTRIBUTES(PF2_DECLARE_ATTRIBUTE_CAPTUREDEF)
 
 	/**
 	 * Gets an instance of this container.
@@ -98,9 +48,12 @@ public:
 	 * Gets all of the character capture definitions.
 	 *
 	 * @return
-	 *	An array of all the capture definitions for character attributes.
+	 *	An array of all the capture definitions for character attributes, in the order of PF2_ATTRIBUTES.
 	 */
-	TArray<FGameplayEffectAttributeCaptureDefinition> GetCaptureDefinitions() const;
+	FORCEINLINE const TArray<FGameplayEffectAttributeCaptureDefinition>& GetCaptureDefinitions() const
+	{
+		return this->CaptureDefinitions;
+	}
 
 	/**
 	 * Gets the names of all character ability attributes.
@@ -124,6 +77,21 @@ public:
 		return this->AbilityModifierNames;
 	}
 
+	/**
+	 * Gets the capture definition for the character attribute at the specified index.
+	 *
+	 * @param Index
+	 *	The index of the attribute for which a capture definition is desired. Must not be EPF2AttributeIndex::Count.
+	 *
+	 * @return
+	 *	The desired capture definition.
+	 */
+	FORCEINLINE const FGameplayEffectAttributeCaptureDefinition& GetCaptureByIndex(
+		const EPF2AttributeIndex Index) const
+	{
+		return this->CaptureDefinitions[PF2AttributeRegistry::ToInt(Index)];
+	}
+
 	/**
 	 * Gets a capture definition for the given character attribute.
 	 *
@@ -131,13 +99,12 @@ public:
 	 *	The attribute for which a capture definition is desired.
 	 *
 	 * @return
-	 *	Either the desired capture definition; or nullptr if the given attribute doesn't correspond to a character
-	 *	ability.
+	 *	Either the desired capture definition; or nullptr if the given attribute is not a character attribute.
 	 */
 	FORCEINLINE const FGameplayEffectAttributeCaptureDefinition* GetCaptureByAttribute(
 		const FGameplayAttribute Attribute) const
 	{
-		return this->GetCaptureByName(Attribute.GetName());
+		return this->FindCapture(PF2AttributeRegistry::IndexOf(Attribute));
 	}
 
 	/**
@@ -147,26 +114,19 @@ public:
 	 *	The name of the attribute for which a capture definition is desired.
 	 *
 	 * @return
-	 *	Either the desired capture definition; or nullptr if the given attribute name doesn't correspond to a character
-	 *	ability.
+	 *	Either the desired capture definition; or nullptr if the given attribute name is not the name of a character
+	 *	attribute.
 	 */
 	FORCEINLINE const FGameplayEffectAttributeCaptureDefinition* GetCaptureByName(const FString Name) const
 	{
-		if (this->CaptureDefinitions.Contains(Name))
-		{
-			return &(this->CaptureDefinitions[Name]);
-		}
-		else
-		{
-			return nullptr;
-		}
+		return this->FindCapture(PF2AttributeRegistry::IndexOfName(FName(*Name)));
 	}
 
 private:
 	/**
-	 * A map of all capture definitions, keyed by property name.
+	 * All capture definitions, indexed by EPF2AttributeIndex.
 	 */
-	TMap<FString, FGameplayEffectAttributeCaptureDefinition> CaptureDefinitions;
+	TArray<FGameplayEffectAttributeCaptureDefinition> CaptureDefinitions;
 
 	/**
 	 * The names of all ability-related attributes.
@@ -181,48 +141,26 @@ private:
 	/**
 	 * Constructor for FPF2CharacterAttributeStatics.
 	 */
-	FPF2CharacterAttributeStatics()
+	FPF2CharacterAttributeStatics();
+
+	/**
+	 * Gets the capture definition for the character attribute at the specified index, if it is a valid index.
+	 *
+	 * @param Index
+	 *	The index of the attribute for which a capture definition is desired.
+	 *
+	 * @return
+	 *	Either the desired capture definition; or nullptr if the index is EPF2AttributeIndex::Count.
+	 */
+	FORCEINLINE const FGameplayEffectAttributeCaptureDefinition* FindCapture(const EPF2AttributeIndex Index) const
 	{
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, AbBoostCount, Target, false);
-
-		DEFINE_ABILITY_CAPTUREDEF(UPF2AttributeSet, AbCharisma, Target, false);
-		DEFINE_ABILITY_CAPTUREDEF(UPF2AttributeSet, AbConstitution, Target, false);
-		DEFINE_ABILITY_CAPTUREDEF(UPF2AttributeSet, AbDexterity, Target, false);
-		DEFINE_ABILITY_CAPTUREDEF(UPF2AttributeSet, AbIntelligence, Target, false);
-		DEFINE_ABILITY_CAPTUREDEF(UPF2AttributeSet, AbStrength, Target, false);
-		DEFINE_ABILITY_CAPTUREDEF(UPF2AttributeSet, AbWisdom, Target, false);
-
-		DEFINE_ABILITY_MODIFIER_CAPTUREDEF(UPF2AttributeSet, AbCharismaModifier, Target, false);
-		DEFINE_ABILITY_MODIFIER_CAPTUREDEF(UPF2AttributeSet, AbConstitutionModifier, Target, false);
-		DEFINE_ABILITY_MODIFIER_CAPTUREDEF(UPF2AttributeSet, AbDexterityModifier, Target, false);
-		DEFINE_ABILITY_MODIFIER_CAPTUREDEF(UPF2AttributeSet, AbIntelligenceModifier, Target, false);
-		DEFINE_ABILITY_MODIFIER_CAPTUREDEF(UPF2AttributeSet, AbStrengthModifier, Target, false);
-		DEFINE_ABILITY_MODIFIER_CAPTUREDEF(UPF2AttributeSet, AbWisdomModifier, Target, false);
-
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, HitPoints, Target, false);
-
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstPhysicalBludgeoning, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstPhysicalPiercing, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstPhysicalSlashing, Target, false);
-
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstEnergyAcid, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstEnergyCold, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstEnergyFire, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstEnergySonic, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstEnergyPositive, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstEnergyNegative, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstEnergyForce, Target, false);
-
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstAlignmentChaotic, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstAlignmentEvil, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstAlignmentGood, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstAlignmentLawful, Target, false);
-
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstMental, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstPoison, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstBleed, Target, false);
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, RstPrecision, Target, false);
-
-		DEFINE_PF2_ATTRIBUTE_CAPTUREDEF(UPF2AttributeSet, TmpDamageIncoming, Target, false);
+		if (Index == EPF2AttributeIndex::Count)
+		{
+			return nullptr;
+		}
+		else
+		{
+			return &this->GetCaptureByIndex(Index);
+		}
 	}
 };
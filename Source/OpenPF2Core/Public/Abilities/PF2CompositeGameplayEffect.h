@@ -0,0 +1,103 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <GameplayEffect.h>
+
+#include "PF2CompositeGameplayEffect.generated.h"
+
+/**
+ * A Gameplay Effect (GE) that combines the modifiers and tags of several passive GEs into a single GE.
+ *
+ * Applying a composite GE results in a single active GE on the ASC, with a single spec and effect context, instead of
+ * one active GE for each of the GEs it combines. Modifiers are concatenated in the order of the GEs that were combined,
+ * so the attributes of the character end up the same as if each GE had been applied on its own.
+ *
+ * Composite GEs are created at runtime rather than loaded from assets, and are owned by the composite GE subsystem of
+ * the game instance (see UPF2CompositeGameplayEffectSubsystem). The same composite GE is returned each time the same
+ * list of GEs is combined, so that specs for it can be cached and re-used just like the specs of any other GE.
+ */
+UCLASS(Transient)
+class OPENPF2CORE_API UPF2CompositeGameplayEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The GEs that were combined into this GE, in the order that their modifiers were added.
+	 */
+	UPROPERTY()
+	TArray<TSubclassOf<UGameplayEffect>> SourceEffects;
+
+public:
+	// =================================================================================================================
+	// Public Static Methods
+	// =================================================================================================================
+	/**
+	 * Determines whether a GE can be combined with other GEs into a composite GE.
+	 *
+	 * Only GEs that do nothing more than grant tags and modify attributes for as long as they are active can be
+	 * combined. GEs that have a duration, a period, stacking rules, executions, tag requirements, or cues, or that grant
+	 * abilities or apply other GEs, all depend on being a separate active GE, so they are never combined.
+	 *
+	 * @param Effect
+	 *	The GE to check.
+	 *
+	 * @return
+	 *	- TRUE if the GE can be combined with other GEs.
+	 *	- FALSE, otherwise.
+	 */
+	static bool CanCombine(const TSubclassOf<UGameplayEffect> Effect);
+
+	/**
+	 * Creates a new composite GE that combines the given GEs.
+	 *
+	 * Most code should use UPF2CompositeGameplayEffectSubsystem::FindOrCreate() instead, so that the same composite GE
+	 * is shared by every ASC that combines the same GEs.
+	 *
+	 * @param Outer
+	 *	The object that owns the new composite GE.
+	 * @param Name
+	 *	The name of the new composite GE.
+	 * @param Effects
+	 *	The GEs to combine, in the order their modifiers should be evaluated. Each GE must satisfy CanCombine().
+	 *
+	 * @return
+	 *	The new composite GE.
+	 */
+	static UPF2CompositeGameplayEffect* Create(UObject*                                    Outer,
+	                                           const FName                                 Name,
+	                                           const TArray<TSubclassOf<UGameplayEffect>>& Effects);
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the GEs that were combined into this GE.
+	 *
+	 * @return
+	 *	The GEs that were combined, in the order that their modifiers were added.
+	 */
+	FORCEINLINE const TArray<TSubclassOf<UGameplayEffect>>& GetSourceEffects() const
+	{
+		return this->SourceEffects;
+	}
+
+protected:
+	// =================================================================================================================
+	// Protected Methods
+	// =================================================================================================================
+	/**
+	 * Copies the modifiers and tags of the given GEs into this GE.
+	 *
+	 * @param Effects
+	 *	The GEs to combine, in the order their modifiers should be evaluated.
+	 */
+	void Combine(const TArray<TSubclassOf<UGameplayEffect>>& Effects);
+};
@@ -0,0 +1,70 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <Subsystems/GameInstanceSubsystem.h>
+
+#include "Abilities/PF2CompositeGameplayEffect.h"
+
+#include "PF2CompositeGameplayEffectSubsystem.generated.h"
+
+/**
+ * Owns the composite Gameplay Effects (GEs) that the ASCs of a game instance apply.
+ *
+ * Composite GEs are shared by every ASC that combines the same GEs, so they cannot be owned by any one ASC. Keeping
+ * them in this subsystem ties their lifetime to the game instance: they stay alive for as long as any character in the
+ * game might apply them, and they are released when the game instance shuts down (e.g., at the end of a PIE session).
+ */
+UCLASS()
+class OPENPF2CORE_API UPF2CompositeGameplayEffectSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The composite GEs that have been created for this game instance, keyed by object name.
+	 */
+	UPROPERTY()
+	TMap<FName, UPF2CompositeGameplayEffect*> CompositeEffects;
+
+public:
+	// =================================================================================================================
+	// Public Static Methods
+	// =================================================================================================================
+	/**
+	 * Gets the composite GE subsystem of the game instance of the specified world.
+	 *
+	 * @param World
+	 *	The world for which the subsystem is desired.
+	 *
+	 * @return
+	 *	Either the subsystem; or, nullptr if the world is not part of a game instance (e.g., an editor preview world).
+	 */
+	static UPF2CompositeGameplayEffectSubsystem* Get(const UWorld* World);
+
+	// =================================================================================================================
+	// Public Methods - UGameInstanceSubsystem Overrides
+	// =================================================================================================================
+	virtual void Deinitialize() override;
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the composite GE that combines the given GEs, creating it if it does not yet exist.
+	 *
+	 * @param Effects
+	 *	The GEs to combine, in the order their modifiers should be evaluated. Each GE must satisfy
+	 *	UPF2CompositeGameplayEffect::CanCombine().
+	 *
+	 * @return
+	 *	The composite GE.
+	 */
+	const UPF2CompositeGameplayEffect* FindOrCreate(const TArray<TSubclassOf<UGameplayEffect>>& Effects);
+};
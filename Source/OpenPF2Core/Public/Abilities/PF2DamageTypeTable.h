@@ -0,0 +1,278 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// Content from Pathfinder 2nd Edition is licensed under the Open Game License (OGL) v1.0a, subject to the following:
+//   - Open Game License v 1.0a, Copyright 2000, Wizards of the Coast, Inc.
+//   - System Reference Document, Copyright 2000, Wizards of the Coast, Inc.
+//   - Pathfinder Core Rulebook (Second Edition), Copyright 2019, Paizo Inc.
+//
+// Except for material designated as Product Identity, the game mechanics and logic in this file are Open Game Content,
+// as defined in the Open Game License version 1.0a, Section 1(d) (see accompanying LICENSE.TXT). No portion of this
+// file other than the material designated as Open Game Content may be reproduced in any form without written
+// permission.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayTagContainer.h>
+#include <Engine/NetSerialization.h>
+
+#include "PF2DamageTypeTable.generated.h"
+
+/**
+ * The resistance, weakness, and immunity of a character to a single type of damage.
+ *
+ * From the Pathfinder 2E Core Rulebook, page 453, "Immunities, Weaknesses, and Resistances":
+ * "If you have more than one type of these adjustments, apply immunities first, then weaknesses, and resistances last."
+ */
+USTRUCT(BlueprintType)
+struct OPENPF2CORE_API FPF2DamageTypeDefenses
+{
+	GENERATED_BODY()
+
+	/**
+	 * How much damage of this type is reduced by each time the character takes it (to a minimum of 0 damage).
+	 */
+	UPROPERTY(BlueprintReadOnly)
+	float Resistance;
+
+	/**
+	 * How much damage of this type is increased by each time the character takes it.
+	 */
+	UPROPERTY(BlueprintReadOnly)
+	float Weakness;
+
+	/**
+	 * Whether the character takes no damage of this type at all.
+	 */
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsImmune;
+
+	/**
+	 * Default constructor for FPF2DamageTypeDefenses.
+	 */
+	explicit FPF2DamageTypeDefenses() : Resistance(0.0f), Weakness(0.0f), bIsImmune(false)
+	{
+	}
+
+	bool operator==(const FPF2DamageTypeDefenses& Other) const
+	{
+		return (this->Resistance == Other.Resistance) &&
+		       (this->Weakness == Other.Weakness) &&
+		       (this->bIsImmune == Other.bIsImmune);
+	}
+
+	bool operator!=(const FPF2DamageTypeDefenses& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+/**
+ * The defenses of a character against a single type of damage, as an item of a damage type table.
+ */
+USTRUCT()
+struct OPENPF2CORE_API FPF2DamageTypeTableEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/**
+	 * The ordinal of the damage type (see PF2GameplayAbilityUtilities::GetDamageTypeOrdinal()).
+	 */
+	UPROPERTY()
+	uint8 DamageTypeOrdinal;
+
+	/**
+	 * The defenses of the character against the damage type.
+	 */
+	UPROPERTY()
+	FPF2DamageTypeDefenses Defenses;
+
+	/**
+	 * Default constructor for FPF2DamageTypeTableEntry.
+	 */
+	explicit FPF2DamageTypeTableEntry() : DamageTypeOrdinal(0)
+	{
+	}
+
+	/**
+	 * Constructor for FPF2DamageTypeTableEntry.
+	 *
+	 * @param DamageTypeOrdinal
+	 *	The ordinal of the damage type.
+	 */
+	explicit FPF2DamageTypeTableEntry(const uint8 DamageTypeOrdinal) : DamageTypeOrdinal(DamageTypeOrdinal)
+	{
+	}
+};
+
+/**
+ * A compact table of the resistance, weakness, and immunity of a character to each type of damage.
+ *
+ * Only damage types against which a character has non-default defenses have an entry, and the table is replicated as a
+ * fast array, so each change sends only the entries that changed. Every machine also keeps a dense copy of the table
+ * indexed by damage type ordinal, so that looking up the defenses against a type of damage during damage execution is
+ * a single array access.
+ */
+USTRUCT(BlueprintType)
+struct OPENPF2CORE_API FPF2DamageTypeTable : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The entry for each damage type against which the character has had defenses.
+	 */
+	UPROPERTY()
+	TArray<FPF2DamageTypeTableEntry> Entries;
+
+	/**
+	 * The defenses against each damage type, indexed by damage type ordinal.
+	 *
+	 * This is rebuilt from the entries as they change or are replicated, and is not replicated itself.
+	 */
+	TArray<FPF2DamageTypeDefenses> DefensesByOrdinal;
+
+public:
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the defenses of the character against the damage type that has the specified ordinal.
+	 *
+	 * @param DamageTypeOrdinal
+	 *	The ordinal of the damage type (see PF2GameplayAbilityUtilities::GetDamageTypeOrdinal()).
+	 *
+	 * @return
+	 *	The defenses against the damage type. If the character has no defenses against the damage type, or the ordinal
+	 *	is INDEX_NONE, the defenses are all zero.
+	 */
+	const FPF2DamageTypeDefenses& GetDefenses(const int32 DamageTypeOrdinal) const;
+
+	/**
+	 * Gets the defenses of the character against the specified type of damage.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type.
+	 *
+	 * @return
+	 *	The defenses against the damage type. If the character has no defenses against the damage type, or the tag is
+	 *	not a damage type, the defenses are all zero.
+	 */
+	const FPF2DamageTypeDefenses& GetDefensesForDamageType(const FGameplayTag DamageType) const;
+
+	/**
+	 * Sets the resistance of the character to the specified type of damage.
+	 *
+	 * If the tag is for a category of damage (e.g., "DamageType.Physical"), the resistance applies to every type of
+	 * damage in the category.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type.
+	 * @param Resistance
+	 *	The new resistance to the damage type.
+	 *
+	 * @return
+	 *	- TRUE if the table changed.
+	 *	- FALSE, otherwise.
+	 */
+	bool SetResistance(const FGameplayTag DamageType, const float Resistance);
+
+	/**
+	 * Sets the weakness of the character to the specified type of damage.
+	 *
+	 * If the tag is for a category of damage (e.g., "DamageType.Physical"), the weakness applies to every type of
+	 * damage in the category.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type.
+	 * @param Weakness
+	 *	The new weakness to the damage type.
+	 *
+	 * @return
+	 *	- TRUE if the table changed.
+	 *	- FALSE, otherwise.
+	 */
+	bool SetWeakness(const FGameplayTag DamageType, const float Weakness);
+
+	/**
+	 * Sets whether the character is immune to the specified type of damage.
+	 *
+	 * If the tag is for a category of damage (e.g., "DamageType.Physical"), the immunity applies to every type of
+	 * damage in the category.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type.
+	 * @param bIsImmune
+	 *	Whether the character is immune to the damage type.
+	 *
+	 * @return
+	 *	- TRUE if the table changed.
+	 *	- FALSE, otherwise.
+	 */
+	bool SetImmunity(const FGameplayTag DamageType, const bool bIsImmune);
+
+	// =================================================================================================================
+	// Public Methods - FFastArraySerializer Callbacks
+	// =================================================================================================================
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+
+	/**
+	 * Serializes the changes to the entries of this table for replication.
+	 *
+	 * @param DeltaParms
+	 *	The parameters for delta serialization.
+	 *
+	 * @return
+	 *	- TRUE if serialization succeeded.
+	 *	- FALSE, otherwise.
+	 */
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FPF2DamageTypeTableEntry, FPF2DamageTypeTable>(
+			this->Entries,
+			DeltaParms,
+			*this
+		);
+	}
+
+protected:
+	// =================================================================================================================
+	// Protected Methods
+	// =================================================================================================================
+	/**
+	 * Applies a change to the defenses against a damage type, and against every damage type in it if it is a category.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type.
+	 * @param Update
+	 *	A callback that changes the defenses against a single damage type.
+	 *
+	 * @return
+	 *	- TRUE if the table changed.
+	 *	- FALSE, otherwise.
+	 */
+	bool UpdateDefenses(const FGameplayTag                                 DamageType,
+	                    const TFunctionRef<void (FPF2DamageTypeDefenses&)> Update);
+
+	/**
+	 * Copies the defenses in an entry into the dense table of defenses.
+	 *
+	 * @param Entry
+	 *	The entry to copy.
+	 */
+	void RefreshDefenses(const FPF2DamageTypeTableEntry& Entry);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPF2DamageTypeTable> : public TStructOpsTypeTraitsBase2<FPF2DamageTypeTable>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,322 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <AttributeSet.h>
+#include <GameplayTagContainer.h>
+
+#include "PF2DerivedStatistics.generated.h"
+
+// =====================================================================================================================
+// Forward Declarations (to break recursive dependencies)
+// =====================================================================================================================
+class IPF2CalculationDependencyInterface;
+class UPF2AttributeSet;
+struct FGameplayEffectSpec;
+
+/**
+ * A derived statistic for which the server has a different value than clients derive on their own.
+ *
+ * This happens when a GE other than the passive GE that calculates the statistic also modifies it (e.g., an item bonus
+ * to AC, or a status penalty to a saving throw).
+ */
+USTRUCT()
+struct OPENPF2CORE_API FPF2DerivedStatisticOverride
+{
+	GENERATED_BODY()
+
+	/**
+	 * The index of the statistic in the list returned by FPF2DerivedStatistics::GetAttributes().
+	 */
+	UPROPERTY()
+	uint8 StatisticIndex;
+
+	/**
+	 * The value of the statistic on the server.
+	 */
+	UPROPERTY()
+	float Value;
+
+	/**
+	 * Default constructor for FPF2DerivedStatisticOverride.
+	 */
+	explicit FPF2DerivedStatisticOverride() : StatisticIndex(0), Value(0.0f)
+	{
+	}
+
+	/**
+	 * Constructor for FPF2DerivedStatisticOverride.
+	 *
+	 * @param StatisticIndex
+	 *	The index of the statistic in the list returned by FPF2DerivedStatistics::GetAttributes().
+	 * @param Value
+	 *	The value of the statistic on the server.
+	 */
+	explicit FPF2DerivedStatisticOverride(const uint8 StatisticIndex, const float Value) :
+		StatisticIndex(StatisticIndex),
+		Value(Value)
+	{
+	}
+
+	bool operator==(const FPF2DerivedStatisticOverride& Other) const
+	{
+		return (this->StatisticIndex == Other.StatisticIndex) && (this->Value == Other.Value);
+	}
+};
+
+/**
+ * A copy of the inputs from which the derived statistics of a character are calculated.
+ *
+ * Since the inputs are copied out of the attribute set and ASC of the character, statistics can be calculated from them
+ * on any thread, while the game thread goes on to modify the character.
+ */
+struct OPENPF2CORE_API FPF2DerivedStatisticInputs
+{
+	/**
+	 * The ability modifiers of the character.
+	 *
+	 * The modifiers are in the same order as FPF2DerivedStatistics::GetAbilityModifierAttributes().
+	 */
+	TArray<float> AbilityModifiers;
+
+	/**
+	 * The tags of the character.
+	 */
+	FGameplayTagContainer CharacterTags;
+
+	/**
+	 * The level of the character.
+	 */
+	float CharacterLevel;
+
+	/**
+	 * Default constructor for FPF2DerivedStatisticInputs.
+	 */
+	explicit FPF2DerivedStatisticInputs() : CharacterLevel(0.0f)
+	{
+	}
+
+	/**
+	 * Constructor for FPF2DerivedStatisticInputs.
+	 *
+	 * @param AttributeSet
+	 *	The attribute set from which to copy the ability modifiers of the character.
+	 * @param CharacterTags
+	 *	The tags of the character.
+	 * @param CharacterLevel
+	 *	The level of the character.
+	 */
+	explicit FPF2DerivedStatisticInputs(
+		const UPF2AttributeSet&      AttributeSet,
+		const FGameplayTagContainer& CharacterTags,
+		const float                  CharacterLevel);
+
+	/**
+	 * Gets the copy of the modifier of the character in an ability.
+	 *
+	 * @param Attribute
+	 *	The attribute of the ability modifier.
+	 *
+	 * @return
+	 *	The value of the modifier; or 0, if the attribute is not an ability modifier.
+	 */
+	float GetAbilityModifier(const FGameplayAttribute& Attribute) const;
+};
+
+/**
+ * Derived statistics that were calculated ahead of the GEs that calculate the same statistics.
+ *
+ * See UPF2AbilitySystemComponent::ActivateAllPassiveGameplayEffectsInParallel().
+ */
+struct OPENPF2CORE_API FPF2PrecalculatedDerivedStatistics
+{
+	/**
+	 * The level of the character at the time the statistics were calculated.
+	 */
+	float CharacterLevel;
+
+	/**
+	 * The value of each statistic, in the same order as FPF2DerivedStatistics::GetAttributes().
+	 *
+	 * This is empty if no statistics have been calculated.
+	 */
+	TArray<float> Values;
+
+	/**
+	 * The ability modifier on which each statistic was based, in the same order as Values.
+	 */
+	TArray<float> AbilityModifiers;
+
+	/**
+	 * Default constructor for FPF2PrecalculatedDerivedStatistics.
+	 */
+	explicit FPF2PrecalculatedDerivedStatistics() : CharacterLevel(0.0f)
+	{
+	}
+
+	/**
+	 * Discards all of the calculated statistics.
+	 */
+	void Reset()
+	{
+		this->Values.Reset();
+		this->AbilityModifiers.Reset();
+	}
+};
+
+/**
+ * Derives the statistics of a character that are deterministic functions of the character's ability modifiers, level,
+ * and proficiency tags: Armor Class, saving throws, Perception, class DC, and skills.
+ *
+ * When "OpenPF2.DeriveStatisticsOnClients" is enabled, the server stops replicating these statistics. Instead, each
+ * client derives them locally from the ability modifiers and tags it already receives, using the same calculations
+ * that the MMCs of these statistics perform on the server. The server only sends the statistics that differ from what
+ * it derives itself (see FPF2DerivedStatisticOverride), plus a checksum of all of the values so that clients can
+ * detect if their derived values have diverged from the server.
+ *
+ * The rules for each statistic follow the Pathfinder 2E Core Rulebook (e.g., Acrobatics is based on Dexterity). A
+ * project that calculates any of these statistics differently still gets the correct values on clients, because the
+ * server sends an override for every statistic that does not match, but it loses the savings for that statistic.
+ */
+class OPENPF2CORE_API FPF2DerivedStatistics
+{
+public:
+	// =================================================================================================================
+	// Public Static Methods
+	// =================================================================================================================
+	/**
+	 * Determines whether clients derive statistics locally instead of receiving them from the server.
+	 *
+	 * This is controlled by the "OpenPF2.DeriveStatisticsOnClients" console variable, which must have the same value on
+	 * the server and all clients (e.g., by setting it in the "[SystemSettings]" section of "DefaultEngine.ini").
+	 *
+	 * @return
+	 *	- TRUE if derived statistics are not replicated and clients derive them locally.
+	 *	- FALSE, otherwise.
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * Gets the attributes of all derived statistics.
+	 *
+	 * The order of this list is stable, so that an index into this list identifies the same statistic on both the
+	 * server and clients.
+	 *
+	 * @return
+	 *	The attribute of each derived statistic.
+	 */
+	static const TArray<FGameplayAttribute>& GetAttributes();
+
+	/**
+	 * Gets the attributes of the ability modifiers on which derived statistics are based.
+	 *
+	 * @return
+	 *	The attribute of each ability modifier.
+	 */
+	static const TArray<FGameplayAttribute>& GetAbilityModifierAttributes();
+
+	/**
+	 * Gets the index of the derived statistic held by an attribute.
+	 *
+	 * @param Attribute
+	 *	The attribute of the statistic.
+	 *
+	 * @return
+	 *	The index of the statistic in the list returned by GetAttributes(); or INDEX_NONE, if the attribute does not
+	 *	hold a derived statistic.
+	 */
+	static int32 IndexOf(const FGameplayAttribute& Attribute);
+
+	/**
+	 * Gets the index of the derived statistic that is an ability modifier plus a TEML proficiency bonus.
+	 *
+	 * @param ProficiencyRootTag
+	 *	The root tag of the TEML proficiency tags of the statistic (e.g., "Skill.Arcana").
+	 * @param AbilityModifierAttribute
+	 *	The attribute of the ability modifier on which the statistic is based.
+	 *
+	 * @return
+	 *	The index of the statistic in the list returned by GetAttributes(); or INDEX_NONE, if no derived statistic is
+	 *	calculated from the given proficiency and ability.
+	 */
+	static int32 IndexOfTemlModifier(
+		const FGameplayTag&       ProficiencyRootTag,
+		const FGameplayAttribute& AbilityModifierAttribute);
+
+	/**
+	 * Derives the value of each statistic from the inputs in an attribute set.
+	 *
+	 * @param AttributeSet
+	 *	The attribute set that provides the ability modifiers of the character.
+	 * @param CharacterTags
+	 *	The tags of the character, which determine the proficiency of the character in each statistic, the key ability
+	 *	of the character, and the type of armor the character is wearing.
+	 * @param CharacterLevel
+	 *	The level of the character.
+	 * @param OutValues
+	 *	The array to which the value of each statistic is written, in the same order as GetAttributes().
+	 */
+	static void Calculate(
+		const UPF2AttributeSet&      AttributeSet,
+		const FGameplayTagContainer& CharacterTags,
+		const float                  CharacterLevel,
+		TArray<float>&               OutValues);
+
+	/**
+	 * Derives the value of each statistic from a copy of the inputs of a character.
+	 *
+	 * This only reads the given inputs, so it can be called on any thread.
+	 *
+	 * @param Inputs
+	 *	The ability modifiers, tags, and level of the character.
+	 * @param OutStatistics
+	 *	The statistics to which the value of each statistic and the ability modifier it was based on are written.
+	 */
+	static void Calculate(const FPF2DerivedStatisticInputs& Inputs, FPF2PrecalculatedDerivedStatistics& OutStatistics);
+
+	/**
+	 * Looks up the value that was precalculated for a derived statistic, for use by the MMC of the statistic.
+	 *
+	 * A value is only returned if it is known to be the same as what the MMC would calculate from the spec: the ASC
+	 * that made the spec must have precalculated statistics (see
+	 * UPF2AbilitySystemComponent::ActivateAllPassiveGameplayEffectsInParallel()), the level of the spec and the ability
+	 * modifier the MMC captured must match the inputs of the precalculated value, and the spec must not carry any tags
+	 * of its own that the MMC depends upon.
+	 *
+	 * @param Spec
+	 *	The GE spec for which the MMC is calculating the statistic.
+	 * @param StatisticIndex
+	 *	The index of the statistic in the list returned by GetAttributes().
+	 * @param AbilityModifier
+	 *	The ability modifier that the MMC captured from the spec.
+	 * @param Calculation
+	 *	The MMC, which provides the tags that it depends upon.
+	 * @param OutValue
+	 *	The variable to which the precalculated value is written.
+	 *
+	 * @return
+	 *	- TRUE if a precalculated value was found.
+	 *	- FALSE, otherwise.
+	 */
+	static bool FindPrecalculatedValue(
+		const FGameplayEffectSpec&                Spec,
+		const int32                               StatisticIndex,
+		const float                               AbilityModifier,
+		const IPF2CalculationDependencyInterface& Calculation,
+		float&                                    OutValue);
+
+	/**
+	 * Calculates a checksum of the value of each derived statistic.
+	 *
+	 * @param Values
+	 *	The value of each statistic, in the same order as GetAttributes().
+	 *
+	 * @return
+	 *	The checksum of the values.
+	 */
+	static uint32 CalculateChecksum(const TArray<float>& Values);
+};
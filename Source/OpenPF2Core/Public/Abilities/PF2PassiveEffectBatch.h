@@ -0,0 +1,72 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "Abilities/PF2AbilitySystemComponentInterface.h"
+
+/**
+ * A scope during which changes to the passive GEs and dynamic tags of an ASC are collected instead of applied.
+ *
+ * When the outermost batch on an ASC goes out of scope, the ASC re-applies only the passive GEs that were affected by
+ * all the changes made during the batch, in a single pass. Batches can be nested.
+ *
+ * Example:
+ * @code
+ * {
+ *     FPF2PassiveEffectBatch Batch(Asc);
+ *
+ *     Asc->AddDynamicTag(FirstTag);
+ *     Asc->AddDynamicTag(SecondTag);
+ * } // Passive GEs get re-applied once here.
+ * @endcode
+ */
+class FPF2PassiveEffectBatch
+{
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The ASC on which the batch is open.
+	 */
+	IPF2AbilitySystemComponentInterface* AbilitySystemComponent;
+
+public:
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Constructor for FPF2PassiveEffectBatch.
+	 *
+	 * @param AbilitySystemComponent
+	 *	The ASC on which to open a batch. Can be null, in which case the batch does nothing.
+	 */
+	explicit FPF2PassiveEffectBatch(IPF2AbilitySystemComponentInterface* AbilitySystemComponent) :
+		AbilitySystemComponent(AbilitySystemComponent)
+	{
+		if (this->AbilitySystemComponent != nullptr)
+		{
+			this->AbilitySystemComponent->BeginPassiveGameplayEffectBatch();
+		}
+	}
+
+	FPF2PassiveEffectBatch(const FPF2PassiveEffectBatch&) = delete;
+
+	FPF2PassiveEffectBatch& operator=(const FPF2PassiveEffectBatch&) = delete;
+
+	// =================================================================================================================
+	// Public Destructor
+	// =================================================================================================================
+	~FPF2PassiveEffectBatch()
+	{
+		if (this->AbilitySystemComponent != nullptr)
+		{
+			this->AbilitySystemComponent->EndPassiveGameplayEffectBatch();
+		}
+	}
+};
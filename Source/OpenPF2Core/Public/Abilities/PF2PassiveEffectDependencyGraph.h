@@ -0,0 +1,290 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayEffect.h>
+#include <GameplayTagContainer.h>
+
+/**
+ * A graph of the tags and attributes that each passive Gameplay Effect (GE) on a character reads and writes.
+ *
+ * Each GE is a node in the graph. A GE reads the tags that its MMCs inspect (via
+ * IPF2CalculationDependencyInterface) and the tags in its tag requirements; it also reads any attributes that its
+ * modifiers capture as a snapshot. A GE writes the tags it grants and the attributes it modifies. One GE is a
+ * dependent of another GE when it reads a tag or snapshot attribute that the other GE writes.
+ *
+ * Attributes that are captured without a snapshot are not tracked, since GAS already re-evaluates those modifiers when
+ * the attribute changes. Tags, on the other hand, are captured into a GE spec when the spec is created, so a GE that
+ * reads a tag must be re-applied for a tag change to take effect.
+ *
+ * The graph is used by the ASC to determine the minimum set of passive GEs that must be re-applied when tags on a
+ * character change, instead of re-applying every passive GE. The graph also tracks which GEs depend on the level of
+ * the character, so that the ASC can update those GEs in place when the character levels up.
+ */
+class OPENPF2CORE_API FPF2PassiveEffectDependencyGraph
+{
+protected:
+	// =================================================================================================================
+	// Protected Types
+	// =================================================================================================================
+	/**
+	 * The dependencies of a single passive GE.
+	 */
+	struct FNode
+	{
+		/**
+		 * The GE that this node describes.
+		 */
+		TSubclassOf<UGameplayEffect> Effect;
+
+		/**
+		 * The root tags of all tags that the GE reads.
+		 */
+		FGameplayTagContainer TagsRead;
+
+		/**
+		 * Whether the GE reads tags that cannot be determined (e.g., because an MMC does not describe its dependencies).
+		 */
+		bool bReadsAllTags;
+
+		/**
+		 * Whether any magnitude of the GE may change when the level of the GE spec changes.
+		 */
+		bool bReadsLevel;
+
+		/**
+		 * Whether the GE grants abilities, which cannot be updated in place when the level changes.
+		 */
+		bool bGrantsAbilities;
+
+		/**
+		 * The attributes that the GE captures as a snapshot.
+		 */
+		TArray<FGameplayAttribute> AttributesRead;
+
+		/**
+		 * The tags that the GE grants to the character.
+		 */
+		FGameplayTagContainer TagsWritten;
+
+		/**
+		 * The attributes that the GE modifies.
+		 */
+		TArray<FGameplayAttribute> AttributesWritten;
+
+		/**
+		 * The indices of the nodes for GEs that read a tag or attribute that this GE writes.
+		 */
+		TArray<int32> Dependents;
+
+		/**
+		 * Constructor for FNode.
+		 *
+		 * @param Effect
+		 *	The GE for which dependencies are being gathered.
+		 */
+		explicit FNode(const TSubclassOf<UGameplayEffect> Effect);
+
+		/**
+		 * Determines whether this GE reads any of the given tags.
+		 *
+		 * @param Tags
+		 *	The tags to check.
+		 *
+		 * @return
+		 *	- TRUE if this GE reads at least one of the tags, or any tag that is a parent of one of the tags.
+		 *	- FALSE, otherwise.
+		 */
+		bool ReadsAnyTag(const FGameplayTagContainer& Tags) const;
+
+		/**
+		 * Determines whether this GE reads a tag or attribute that the given GE writes.
+		 *
+		 * @param Other
+		 *	The node of the other GE.
+		 *
+		 * @return
+		 *	- TRUE if this GE depends on the output of the other GE.
+		 *	- FALSE, otherwise.
+		 */
+		bool DependsOn(const FNode& Other) const;
+
+		/**
+		 * Determines whether a modifier magnitude may change when the level of the GE spec changes.
+		 *
+		 * @param Magnitude
+		 *	The magnitude to check.
+		 *
+		 * @return
+		 *	- TRUE if the magnitude is, or may be, different at different character levels.
+		 *	- FALSE, otherwise.
+		 */
+		static bool IsMagnitudeLevelDependent(const FGameplayEffectModifierMagnitude& Magnitude);
+	};
+
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The nodes of this graph; one per unique GE.
+	 */
+	TArray<FNode> Nodes;
+
+	/**
+	 * The index of the node for each GE in this graph.
+	 */
+	TMap<TSubclassOf<UGameplayEffect>, int32> NodeIndices;
+
+	// =================================================================================================================
+	// Protected Methods
+	// =================================================================================================================
+	/**
+	 * Gets all of the GEs that are downstream of the given nodes in this graph.
+	 *
+	 * @param StartNodes
+	 *	The indices of the nodes from which to start walking the graph.
+	 * @param bIncludeStartNodes
+	 *	Whether the GEs of the start nodes should be included in the result. If false, a start node is only included if
+	 *	it is downstream of another start node.
+	 *
+	 * @return
+	 *	The GEs downstream of the start nodes.
+	 */
+	TSet<TSubclassOf<UGameplayEffect>> GetDownstreamEffects(
+		const TArray<int32>& StartNodes,
+		const bool           bIncludeStartNodes) const;
+
+public:
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Default constructor for FPF2PassiveEffectDependencyGraph.
+	 *
+	 * Creates an empty graph.
+	 */
+	explicit FPF2PassiveEffectDependencyGraph() = default;
+
+	/**
+	 * Constructor for FPF2PassiveEffectDependencyGraph.
+	 *
+	 * @param Effects
+	 *	The passive GEs from which to build the graph. Duplicate GEs are only included in the graph once.
+	 */
+	explicit FPF2PassiveEffectDependencyGraph(const TArray<TSubclassOf<UGameplayEffect>>& Effects);
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Determines whether this graph contains any GEs.
+	 *
+	 * @return
+	 *	- TRUE if the graph has no GEs.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return this->Nodes.Num() == 0;
+	}
+
+	/**
+	 * Gets all of the GEs in this graph that are affected by a change to the given tags.
+	 *
+	 * The result includes both the GEs that read the tags directly and all GEs downstream of them (i.e., GEs that read
+	 * tags or snapshot attributes that affected GEs write).
+	 *
+	 * @param ChangedTags
+	 *	The tags that have been added to or removed from the character.
+	 *
+	 * @return
+	 *	The GEs that must be re-applied for the tag change to take effect.
+	 */
+	TSet<TSubclassOf<UGameplayEffect>> GetEffectsAffectedByTags(const FGameplayTagContainer& ChangedTags) const;
+
+	/**
+	 * Gets all of the GEs in this graph that depend on the output of any of the given GEs, directly or indirectly.
+	 *
+	 * The given GEs are not included in the result unless one of them depends on another. GEs that are not in this
+	 * graph are ignored.
+	 *
+	 * @param Effects
+	 *	The GEs that have been added or removed.
+	 *
+	 * @return
+	 *	The GEs that must be re-applied for the output of the given GEs to be reflected.
+	 */
+	TSet<TSubclassOf<UGameplayEffect>> GetEffectsDependentOn(const TSet<TSubclassOf<UGameplayEffect>>& Effects) const;
+
+	/**
+	 * Determines whether a GE in this graph directly reads any of the given tags.
+	 *
+	 * Unlike GetEffectsAffectedByTags(), this does not consider GEs upstream of the given GE.
+	 *
+	 * @param Effect
+	 *	The GE to check.
+	 * @param Tags
+	 *	The tags to check.
+	 *
+	 * @return
+	 *	- TRUE if the GE reads at least one of the tags, or the GE is not in this graph.
+	 *	- FALSE, otherwise.
+	 */
+	bool DoesEffectReadAnyTag(const TSubclassOf<UGameplayEffect> Effect, const FGameplayTagContainer& Tags) const;
+
+	/**
+	 * Determines whether a GE in this graph captures any attributes as a snapshot.
+	 *
+	 * @param Effect
+	 *	The GE to check.
+	 *
+	 * @return
+	 *	- TRUE if the GE captures at least one attribute as a snapshot, or the GE is not in this graph.
+	 *	- FALSE, otherwise.
+	 */
+	bool DoesEffectReadSnapshotAttributes(const TSubclassOf<UGameplayEffect> Effect) const;
+
+	/**
+	 * Determines whether a GE in this graph may have a different magnitude at a different character level.
+	 *
+	 * @param Effect
+	 *	The GE to check.
+	 *
+	 * @return
+	 *	- TRUE if the GE depends on the level of its spec, or the GE is not in this graph.
+	 *	- FALSE, otherwise.
+	 */
+	bool DoesEffectReadLevel(const TSubclassOf<UGameplayEffect> Effect) const;
+
+	/**
+	 * Determines whether a GE in this graph directly reads a tag or attribute that another GE in this graph writes.
+	 *
+	 * @param Effect
+	 *	The GE that may depend on the other GE.
+	 * @param OtherEffect
+	 *	The GE that may be depended upon.
+	 *
+	 * @return
+	 *	- TRUE if the first GE depends on the other GE, or either GE is not in this graph.
+	 *	- FALSE, otherwise.
+	 */
+	bool DoesEffectDependOn(
+		const TSubclassOf<UGameplayEffect> Effect,
+		const TSubclassOf<UGameplayEffect> OtherEffect) const;
+
+	/**
+	 * Gets all of the GEs in this graph that must be removed and re-applied when the character level changes.
+	 *
+	 * Most GEs that depend on the level can have the level of their active spec updated in place. The exceptions are
+	 * GEs that grant abilities and GEs that capture a snapshot of an attribute that a level-dependent GE modifies
+	 * (along with all GEs downstream of them).
+	 *
+	 * @return
+	 *	The GEs that must be re-applied for a level change to take effect.
+	 */
+	TSet<TSubclassOf<UGameplayEffect>> GetEffectsToReapplyOnLevelChange() const;
+};
@@ -0,0 +1,249 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayEffect.h>
+
+#include "Abilities/PF2PassiveEffectDependencyGraph.h"
+
+// =====================================================================================================================
+// Forward Declarations (to minimize header dependencies)
+// =====================================================================================================================
+class UPF2CompositeGameplayEffectSubsystem;
+
+// =====================================================================================================================
+// Normal Declarations
+// =====================================================================================================================
+/**
+ * A single passive Gameplay Effect (GE) in a passive effect plan.
+ */
+struct OPENPF2CORE_API FPF2PassiveEffectPlanEntry
+{
+	/**
+	 * The weight group into which the GE is applied.
+	 */
+	FName WeightGroup;
+
+	/**
+	 * The ordinal of the weight group, which controls the order in which the GE is applied.
+	 */
+	int32 WeightGroupOrdinal;
+
+	/**
+	 * The passive GEs that this entry applies.
+	 *
+	 * This is a single GE unless several passive GEs in the weight group have been combined into a composite GE, in
+	 * which case this is all of the GEs that were combined, in order.
+	 */
+	TArray<TSubclassOf<UGameplayEffect>, TInlineAllocator<1>> Effects;
+
+	/**
+	 * The definition of the GE to apply.
+	 *
+	 * This is the default object of the GE unless several passive GEs have been combined, in which case this is the
+	 * composite GE that combines them.
+	 */
+	const UGameplayEffect* Definition;
+
+	/**
+	 * The number of times the GE has been added to the weight group.
+	 *
+	 * This is always 1 unless the GE is stackable, in which case all additions of the GE to the same weight group are
+	 * combined into a single entry that is applied as one GE with this many stacks.
+	 */
+	int32 Count;
+
+	/**
+	 * Determines whether this entry applies the specified passive GE.
+	 *
+	 * @param Effect
+	 *	The GE to check.
+	 *
+	 * @return
+	 *	- TRUE if the GE is one of the GEs that this entry applies.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool ContainsEffect(const TSubclassOf<UGameplayEffect> Effect) const
+	{
+		return this->Effects.Contains(Effect);
+	}
+
+	/**
+	 * Determines whether this entry applies any of the specified passive GEs.
+	 *
+	 * @param OtherEffects
+	 *	The GEs to check.
+	 *
+	 * @return
+	 *	- TRUE if at least one of the GEs is one of the GEs that this entry applies.
+	 *	- FALSE, otherwise.
+	 */
+	bool ContainsAnyEffect(const TSet<TSubclassOf<UGameplayEffect>>& OtherEffects) const;
+};
+
+/**
+ * The range of entries in a passive effect plan that belong to a single weight group.
+ */
+struct OPENPF2CORE_API FPF2PassiveEffectPlanSpan
+{
+	/**
+	 * The weight group that all of the entries in this span belong to.
+	 */
+	FName WeightGroup;
+
+	/**
+	 * The ordinal of the weight group, which controls the order in which the weight group is applied.
+	 */
+	int32 WeightGroupOrdinal;
+
+	/**
+	 * The index of the first entry in the plan that belongs to the weight group.
+	 */
+	int32 StartIndex;
+
+	/**
+	 * The number of entries in the plan that belong to the weight group.
+	 */
+	int32 Num;
+};
+
+/**
+ * An immutable, precomputed list of all the passive Gameplay Effects (GEs) that an ASC applies.
+ *
+ * The GEs in a plan are sorted in the order they must be applied (by weight group), and all of the GEs for each weight
+ * group are stored contiguously. This allows an ASC to activate or deactivate a weight group just by iterating over
+ * a span of the plan, without having to copy or search the list of passive GEs.
+ *
+ * A plan is built once each time the passive GEs of an ASC change, and is then shared by reference until the next
+ * change.
+ */
+class OPENPF2CORE_API FPF2PassiveEffectPlan
+{
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * All of the passive GEs in this plan, in the order that they must be applied.
+	 */
+	TArray<FPF2PassiveEffectPlanEntry> Entries;
+
+	/**
+	 * The range of entries for each weight group, in the order that weight groups must be applied.
+	 */
+	TArray<FPF2PassiveEffectPlanSpan> WeightGroupSpans;
+
+	/**
+	 * The graph of the tags and attributes that each GE in this plan reads and writes.
+	 */
+	FPF2PassiveEffectDependencyGraph DependencyGraph;
+
+public:
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Constructor for FPF2PassiveEffectPlan.
+	 *
+	 * @param Effects
+	 *	The passive GEs to include in the plan. Each value must be a gameplay effect and the key must be the weight group
+	 *	of that GE.
+	 * @param StackableEffects
+	 *	An optional set of GEs that are applied as a single GE with one stack per addition, rather than as a separate GE
+	 *	for each addition. Each of these GEs has at most one entry per weight group in the plan.
+	 * @param CompositeEffects
+	 *	An optional subsystem from which to get composite GEs. If provided, consecutive passive GEs in the same weight
+	 *	group are combined into composite GEs, where possible (see CombineEntries()).
+	 */
+	explicit FPF2PassiveEffectPlan(
+		const TMultiMap<FName, TSubclassOf<UGameplayEffect>>& Effects,
+		const TSet<TSubclassOf<UGameplayEffect>>&             StackableEffects = TSet<TSubclassOf<UGameplayEffect>>(),
+		UPF2CompositeGameplayEffectSubsystem*                 CompositeEffects = nullptr);
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets all of the passive GEs in this plan, in the order that they must be applied.
+	 *
+	 * @return
+	 *	The entries of this plan.
+	 */
+	FORCEINLINE const TArray<FPF2PassiveEffectPlanEntry>& GetEntries() const
+	{
+		return this->Entries;
+	}
+
+	/**
+	 * Gets the range of entries for each weight group in this plan, in the order that weight groups must be applied.
+	 *
+	 * @return
+	 *	The span of each weight group.
+	 */
+	FORCEINLINE const TArray<FPF2PassiveEffectPlanSpan>& GetWeightGroupSpans() const
+	{
+		return this->WeightGroupSpans;
+	}
+
+	/**
+	 * Gets the graph of the tags and attributes that each GE in this plan reads and writes.
+	 *
+	 * @return
+	 *	The dependency graph for this plan.
+	 */
+	FORCEINLINE const FPF2PassiveEffectDependencyGraph& GetDependencyGraph() const
+	{
+		return this->DependencyGraph;
+	}
+
+	/**
+	 * Gets the entries of this plan that belong to the specified span.
+	 *
+	 * @param Span
+	 *	The span of entries to return. Must be one of the spans returned by GetWeightGroupSpans().
+	 *
+	 * @return
+	 *	A view of the entries in the span.
+	 */
+	FORCEINLINE TArrayView<const FPF2PassiveEffectPlanEntry> GetEntriesInSpan(const FPF2PassiveEffectPlanSpan& Span) const
+	{
+		return TArrayView<const FPF2PassiveEffectPlanEntry>(this->Entries).Slice(Span.StartIndex, Span.Num);
+	}
+
+	/**
+	 * Gets the entries of this plan that belong to the specified weight group.
+	 *
+	 * @param WeightGroup
+	 *	The weight group for which entries are desired.
+	 *
+	 * @return
+	 *	A view of the entries in the weight group. The view is empty if the plan has no GEs in the weight group.
+	 */
+	TArrayView<const FPF2PassiveEffectPlanEntry> GetEntriesInWeightGroup(const FName WeightGroup) const;
+
+protected:
+	// =================================================================================================================
+	// Protected Methods
+	// =================================================================================================================
+	/**
+	 * Combines runs of consecutive entries in the same weight group into entries that apply a single composite GE.
+	 *
+	 * An entry joins the current run only if its GE can be combined (see UPF2CompositeGameplayEffect::CanCombine()),
+	 * it is not a stack of a stackable GE, and its GE does not depend on the output of any GE already in the run. A
+	 * dependent GE has to see the output of the GEs before it when its spec is made, so it starts a new run instead.
+	 * Runs are never reordered, so the order in which modifiers are evaluated is preserved.
+	 *
+	 * Entries must already be sorted by weight group, and the dependency graph must already be built.
+	 *
+	 * @param StackableEffects
+	 *	The GEs that are applied as a single GE with one stack per addition. These are never combined.
+	 * @param CompositeEffects
+	 *	The subsystem from which to get composite GEs.
+	 */
+	void CombineEntries(const TSet<TSubclassOf<UGameplayEffect>>& StackableEffects,
+	                    UPF2CompositeGameplayEffectSubsystem&     CompositeEffects);
+};
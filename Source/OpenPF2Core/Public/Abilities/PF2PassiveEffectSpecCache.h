@@ -0,0 +1,126 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayEffect.h>
+
+/**
+ * A cache of the specs that an ASC has created for its passive Gameplay Effects (GEs).
+ *
+ * Specs are cached per GE definition, weight group, and character level, so that re-activating a passive GE can
+ * re-use the spec from the last time the GE was activated instead of allocating a new effect context and spec. All
+ * specs are for the same level; caching a spec for a different level discards all specs that were cached for the
+ * previous level.
+ *
+ * The cache does not know which inputs a spec depends upon; it is up to the ASC to confirm that a cached spec is still
+ * valid before re-using it.
+ */
+class OPENPF2CORE_API FPF2PassiveEffectSpecCache
+{
+protected:
+	// =================================================================================================================
+	// Protected Types
+	// =================================================================================================================
+	/**
+	 * The key under which a spec is cached.
+	 */
+	struct FKey
+	{
+		/**
+		 * The definition of the GE from which the spec was made.
+		 */
+		const UGameplayEffect* Definition;
+
+		/**
+		 * The weight group into which the GE was applied.
+		 */
+		FName WeightGroup;
+
+		friend bool operator==(const FKey& A, const FKey& B)
+		{
+			return (A.Definition == B.Definition) && (A.WeightGroup == B.WeightGroup);
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Definition), GetTypeHash(Key.WeightGroup));
+		}
+	};
+
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The character level of all specs in this cache.
+	 */
+	int32 Level;
+
+	/**
+	 * The cached specs.
+	 */
+	TMap<FKey, FGameplayEffectSpecHandle> Specs;
+
+public:
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Default constructor for FPF2PassiveEffectSpecCache.
+	 *
+	 * Creates an empty cache.
+	 */
+	explicit FPF2PassiveEffectSpecCache() : Level(INDEX_NONE)
+	{
+	}
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the spec that was cached for a GE in a weight group at the given level.
+	 *
+	 * @param Definition
+	 *	The definition of the GE for which a spec is desired.
+	 * @param WeightGroup
+	 *	The weight group into which the GE is being applied.
+	 * @param CharacterLevel
+	 *	The level of the character to which the GE is being applied.
+	 *
+	 * @return
+	 *	Either the cached spec handle; or, an invalid handle if there is no spec cached for the GE, weight group, and
+	 *	level.
+	 */
+	FGameplayEffectSpecHandle Find(
+		const UGameplayEffect* Definition,
+		const FName            WeightGroup,
+		const int32            CharacterLevel) const;
+
+	/**
+	 * Caches the spec for a GE in a weight group at the given level.
+	 *
+	 * If the level differs from the level of specs already in this cache, all of the other specs are discarded.
+	 *
+	 * @param Definition
+	 *	The definition of the GE from which the spec was made.
+	 * @param WeightGroup
+	 *	The weight group into which the GE is being applied.
+	 * @param CharacterLevel
+	 *	The level of the character for which the spec was made.
+	 * @param SpecHandle
+	 *	The spec to cache.
+	 */
+	void Add(
+		const UGameplayEffect*           Definition,
+		const FName                      WeightGroup,
+		const int32                      CharacterLevel,
+		const FGameplayEffectSpecHandle& SpecHandle);
+
+	/**
+	 * Discards all specs in this cache.
+	 */
+	void Reset();
+};
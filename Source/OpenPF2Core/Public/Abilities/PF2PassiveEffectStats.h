@@ -0,0 +1,111 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "PF2PassiveEffectStats.generated.h"
+
+/**
+ * Counters for the work that an ASC has done on its passive Gameplay Effects (GEs) on behalf of an entry point.
+ */
+USTRUCT(BlueprintType)
+struct OPENPF2CORE_API FPF2PassiveEffectStats
+{
+	GENERATED_BODY()
+
+	/**
+	 * The number of times the entry point was invoked.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumCalls;
+
+	/**
+	 * The number of invocations of the entry point that removed or applied at least one passive GE.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumReapplyCycles;
+
+	/**
+	 * The number of active passive GEs that were removed.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumEffectsRemoved;
+
+	/**
+	 * The number of passive GEs that were applied.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumEffectsApplied;
+
+	/**
+	 * The number of active passive GEs that had their level updated in place.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumEffectsLevelUpdated;
+
+	/**
+	 * The number of times an OpenPF2 custom magnitude calculation (MMC) was evaluated.
+	 *
+	 * This counts every evaluation made while the entry point was running, including the re-evaluations that GAS makes
+	 * when an attribute that an MMC captures without a snapshot changes. MMCs that do not derive from one of the
+	 * OpenPF2 calculation base classes are not counted.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumMagnitudeEvaluations;
+
+	/**
+	 * The total wall time spent in the entry point, in seconds.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	double WallTimeSeconds;
+
+	/**
+	 * Default constructor for FPF2PassiveEffectStats.
+	 */
+	explicit FPF2PassiveEffectStats() :
+		NumCalls(0),
+		NumReapplyCycles(0),
+		NumEffectsRemoved(0),
+		NumEffectsApplied(0),
+		NumEffectsLevelUpdated(0),
+		NumMagnitudeEvaluations(0),
+		WallTimeSeconds(0.0)
+	{
+	}
+
+	/**
+	 * Determines whether any passive GEs were removed, applied, or updated.
+	 *
+	 * @return
+	 *	- TRUE if at least one passive GE was removed, applied, or updated.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool HasEffectChanges() const
+	{
+		return (this->NumEffectsRemoved != 0) || (this->NumEffectsApplied != 0) || (this->NumEffectsLevelUpdated != 0);
+	}
+
+	/**
+	 * Adds the counters of other stats to the counters of these stats.
+	 *
+	 * @param Other
+	 *	The stats to add.
+	 *
+	 * @return
+	 *	A reference to these stats.
+	 */
+	FPF2PassiveEffectStats& operator+=(const FPF2PassiveEffectStats& Other)
+	{
+		this->NumCalls                += Other.NumCalls;
+		this->NumReapplyCycles        += Other.NumReapplyCycles;
+		this->NumEffectsRemoved       += Other.NumEffectsRemoved;
+		this->NumEffectsApplied       += Other.NumEffectsApplied;
+		this->NumEffectsLevelUpdated  += Other.NumEffectsLevelUpdated;
+		this->NumMagnitudeEvaluations += Other.NumMagnitudeEvaluations;
+		this->WallTimeSeconds         += Other.WallTimeSeconds;
+
+		return *this;
+	}
+};
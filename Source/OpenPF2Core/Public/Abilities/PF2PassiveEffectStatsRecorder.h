@@ -0,0 +1,205 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayEffect.h>
+
+#include "Abilities/PF2PassiveEffectStats.h"
+#include "Abilities/PF2PassiveEffectTrigger.h"
+
+/**
+ * Records the work that an ASC does on its passive Gameplay Effects (GEs), attributed to the entry point of the ASC
+ * that caused it.
+ *
+ * Each entry point of the ASC opens a scope (see FPF2PassiveEffectStatsScope) for the duration of the call. Scopes can
+ * be nested; all of the work done in nested scopes is attributed to the entry point of the outermost scope. Work that
+ * is done outside of any scope is attributed to EPF2PassiveEffectTrigger::Other.
+ *
+ * While a scope is open, its recorder is also the active recorder of the calling thread, so that custom magnitude
+ * calculations (MMCs) can report each evaluation no matter how GAS came to evaluate them (see
+ * RecordMagnitudeEvaluation()).
+ */
+class OPENPF2CORE_API FPF2PassiveEffectStatsRecorder
+{
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The stats that have been recorded for each entry point.
+	 */
+	TMap<EPF2PassiveEffectTrigger, FPF2PassiveEffectStats> Stats;
+
+	/**
+	 * The entry point of the outermost open scope.
+	 */
+	EPF2PassiveEffectTrigger ScopeTrigger;
+
+	/**
+	 * The number of scopes that are currently open.
+	 */
+	int32 ScopeDepth;
+
+	/**
+	 * The time at which the outermost open scope was opened, in seconds.
+	 */
+	double ScopeStartTime;
+
+	/**
+	 * The work that has been done since the outermost open scope was opened.
+	 */
+	FPF2PassiveEffectStats ScopeStats;
+
+	/**
+	 * The recorder that was active on the calling thread before the outermost open scope was opened.
+	 */
+	FPF2PassiveEffectStatsRecorder* PreviousActiveRecorder;
+
+public:
+	// =================================================================================================================
+	// Public Static Methods
+	// =================================================================================================================
+	/**
+	 * Records that a custom magnitude calculation (MMC) was evaluated.
+	 *
+	 * The evaluation is attributed to the recorder that has a scope open on the calling thread, if any. This includes
+	 * evaluations that GAS performs when an attribute captured without a snapshot changes and the modifiers that
+	 * depend on it are re-aggregated, which is not tied to any one GE being applied.
+	 */
+	static void RecordMagnitudeEvaluation();
+
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Default constructor for FPF2PassiveEffectStatsRecorder.
+	 */
+	explicit FPF2PassiveEffectStatsRecorder() :
+		ScopeTrigger(EPF2PassiveEffectTrigger::Other),
+		ScopeDepth(0),
+		ScopeStartTime(0.0),
+		PreviousActiveRecorder(nullptr)
+	{
+	}
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the stats that have been recorded for each entry point.
+	 *
+	 * @return
+	 *	The stats, keyed by entry point. Entry points that have not been invoked are omitted.
+	 */
+	FORCEINLINE const TMap<EPF2PassiveEffectTrigger, FPF2PassiveEffectStats>& GetStats() const
+	{
+		return this->Stats;
+	}
+
+	/**
+	 * Discards all of the stats that have been recorded.
+	 *
+	 * Scopes that are currently open are unaffected.
+	 */
+	void Reset();
+
+	/**
+	 * Notifies this recorder that an entry point has been invoked.
+	 *
+	 * @param Trigger
+	 *	The entry point being invoked. Ignored if a scope is already open.
+	 */
+	void BeginScope(const EPF2PassiveEffectTrigger Trigger);
+
+	/**
+	 * Notifies this recorder that the most recently invoked entry point has returned.
+	 *
+	 * Scopes must be closed in the reverse of the order in which they were opened, across all recorders on the calling
+	 * thread. Closing the outermost scope of this recorder while a scope of another recorder that was opened after it is
+	 * still open is a fatal error.
+	 */
+	void EndScope();
+
+	/**
+	 * Records that an active passive GE was removed.
+	 */
+	void RecordEffectRemoved();
+
+	/**
+	 * Records that a passive GE was applied.
+	 */
+	void RecordEffectApplied();
+
+	/**
+	 * Records that the level of an active passive GE was updated in place.
+	 */
+	void RecordEffectLevelUpdated();
+
+protected:
+	// =================================================================================================================
+	// Protected Methods
+	// =================================================================================================================
+	/**
+	 * Gets the stats to which work that is being done right now should be added.
+	 *
+	 * @return
+	 *	Either the stats of the open scope; or, if no scope is open, the stats for EPF2PassiveEffectTrigger::Other.
+	 */
+	FPF2PassiveEffectStats& GetCurrentStats();
+};
+
+/**
+ * A scope that attributes all of the passive GE work that an ASC does during the lifetime of the scope to an entry
+ * point of the ASC.
+ */
+class OPENPF2CORE_API FPF2PassiveEffectStatsScope
+{
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The recorder in which the scope is open.
+	 */
+	FPF2PassiveEffectStatsRecorder& Recorder;
+
+public:
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Constructor for FPF2PassiveEffectStatsScope.
+	 *
+	 * @param Recorder
+	 *	The recorder in which to open the scope.
+	 * @param Trigger
+	 *	The entry point that is being invoked.
+	 */
+	explicit FPF2PassiveEffectStatsScope(
+		FPF2PassiveEffectStatsRecorder& Recorder,
+		const EPF2PassiveEffectTrigger  Trigger) :
+		Recorder(Recorder)
+	{
+		this->Recorder.BeginScope(Trigger);
+	}
+
+	FPF2PassiveEffectStatsScope(const FPF2PassiveEffectStatsScope&) = delete;
+	FPF2PassiveEffectStatsScope& operator=(const FPF2PassiveEffectStatsScope&) = delete;
+
+	// =================================================================================================================
+	// Public Destructors
+	// =================================================================================================================
+	/**
+	 * Destructor for FPF2PassiveEffectStatsScope.
+	 *
+	 * Closes the scope.
+	 */
+	~FPF2PassiveEffectStatsScope()
+	{
+		this->Recorder.EndScope();
+	}
+};
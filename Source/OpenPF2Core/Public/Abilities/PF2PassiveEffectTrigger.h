@@ -0,0 +1,76 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <Misc/EnumRange.h>
+
+#include "PF2PassiveEffectTrigger.generated.h"
+
+/**
+ * An enumeration of the entry points of an ASC that can cause passive Gameplay Effects (GEs) to be removed or applied.
+ *
+ * The work that an ASC does on its passive GEs is attributed to the outermost entry point that was invoked, so that
+ * the cost of a call that is made by another call (e.g., ApplyAbilityBoost() calling
+ * AddPassiveGameplayEffectWithWeight()) is attributed to the caller.
+ */
+UENUM(BlueprintType)
+enum class EPF2PassiveEffectTrigger : uint8
+{
+	/**
+	 * Work that was not done on behalf of any of the other entry points.
+	 */
+	Other,
+
+	/**
+	 * A dynamic tag was added or removed (e.g., through AddDynamicTag() or SetDynamicTags()).
+	 */
+	DynamicTags,
+
+	/**
+	 * An ability boost was applied through ApplyAbilityBoost().
+	 */
+	AbilityBoost,
+
+	/**
+	 * A passive GE was added through AddPassiveGameplayEffect() or AddPassiveGameplayEffectWithWeight().
+	 */
+	AddPassiveEffect,
+
+	/**
+	 * All passive GEs were replaced through SetPassiveGameplayEffects().
+	 */
+	SetPassiveEffects,
+
+	/**
+	 * All passive GEs were removed through RemoveAllPassiveGameplayEffects().
+	 */
+	RemovePassiveEffects,
+
+	/**
+	 * The level of the owning character changed.
+	 */
+	LevelChange,
+
+	/**
+	 * Weight groups were activated (e.g., through ActivateAllPassiveGameplayEffects()).
+	 */
+	ActivatePassiveEffects,
+
+	/**
+	 * Weight groups were deactivated (e.g., through DeactivateAllPassiveGameplayEffects()).
+	 */
+	DeactivatePassiveEffects,
+
+	/**
+	 * A passive GE batch ended, applying all of the changes that were made during the batch.
+	 */
+	Batch,
+
+	Count UMETA(Hidden)
+};
+
+// Allow enum to be iterated by foreach loops.
+ENUM_RANGE_BY_COUNT(EPF2PassiveEffectTrigger, EPF2PassiveEffectTrigger::Count)
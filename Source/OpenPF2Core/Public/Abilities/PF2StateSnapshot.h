@@ -0,0 +1,128 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <AttributeSet.h>
+#include <CoreMinimal.h>
+#include <GameplayEffect.h>
+#include <GameplayTagContainer.h>
+
+#include "PF2StateSnapshot.generated.h"
+
+/**
+ * A handle to a snapshot of the attribute values, dynamic tags, and passive GEs of an ASC.
+ *
+ * See UPF2AbilitySystemComponent::TakeStateSnapshot().
+ */
+USTRUCT(BlueprintType)
+struct OPENPF2CORE_API FPF2StateSnapshotHandle
+{
+	GENERATED_BODY()
+
+	/**
+	 * The unique ID of the snapshot within the ASC that took it. 0 if this handle does not refer to a snapshot.
+	 */
+	UPROPERTY()
+	int32 Id;
+
+	/**
+	 * Default constructor for FPF2StateSnapshotHandle.
+	 */
+	explicit FPF2StateSnapshotHandle() : Id(0)
+	{
+	}
+
+	/**
+	 * Constructor for FPF2StateSnapshotHandle.
+	 *
+	 * @param Id
+	 *	The unique ID of the snapshot.
+	 */
+	explicit FPF2StateSnapshotHandle(const int32 Id) : Id(Id)
+	{
+	}
+
+	/**
+	 * Determines whether this handle refers to a snapshot.
+	 *
+	 * @return
+	 *	- TRUE if this handle was returned by an ASC for a snapshot.
+	 *	- FALSE, otherwise.
+	 */
+	FORCEINLINE bool IsValid() const
+	{
+		return this->Id != 0;
+	}
+};
+
+/**
+ * The state that an ASC had when a snapshot was taken, for only the parts of that state that have changed since.
+ *
+ * A layer starts out empty, so taking a snapshot costs the same no matter how much state an ASC has. The first time a
+ * part of the state changes after the snapshot is taken, its old value is copied into the layer; later changes to the
+ * same part leave the layer alone. Restoring the snapshot therefore only touches the parts of the state that changed.
+ */
+struct OPENPF2CORE_API FPF2StateSnapshotLayer
+{
+	/**
+	 * The unique ID of the snapshot.
+	 */
+	int32 Id;
+
+	/**
+	 * The base value of each attribute that has changed since the snapshot was taken.
+	 */
+	TMap<FGameplayAttribute, float> AttributeBaseValues;
+
+	/**
+	 * The dynamic tags of the ASC, if they have changed since the snapshot was taken.
+	 */
+	TOptional<FGameplayTagContainer> DynamicTags;
+
+	/**
+	 * The passive GEs of the ASC, if they have changed since the snapshot was taken.
+	 */
+	TOptional<TMultiMap<FName, TSubclassOf<UGameplayEffect>>> PassiveGameplayEffects;
+
+	/**
+	 * Constructor for FPF2StateSnapshotLayer.
+	 *
+	 * @param Id
+	 *	The unique ID of the snapshot.
+	 */
+	explicit FPF2StateSnapshotLayer(const int32 Id) : Id(Id)
+	{
+	}
+
+	/**
+	 * Adds the state in this layer to the layer of a snapshot that was taken before this one.
+	 *
+	 * State that the older layer already has is left alone, since it is older than the state in this layer.
+	 *
+	 * @param OlderLayer
+	 *	The layer of the snapshot taken before this one.
+	 */
+	void MergeInto(FPF2StateSnapshotLayer& OlderLayer) const
+	{
+		for (const TPair<FGameplayAttribute, float>& AttributeValue : this->AttributeBaseValues)
+		{
+			if (!OlderLayer.AttributeBaseValues.Contains(AttributeValue.Key))
+			{
+				OlderLayer.AttributeBaseValues.Add(AttributeValue.Key, AttributeValue.Value);
+			}
+		}
+
+		if (!OlderLayer.DynamicTags.IsSet())
+		{
+			OlderLayer.DynamicTags = this->DynamicTags;
+		}
+
+		if (!OlderLayer.PassiveGameplayEffects.IsSet())
+		{
+			OlderLayer.PassiveGameplayEffects = this->PassiveGameplayEffects;
+		}
+	}
+};
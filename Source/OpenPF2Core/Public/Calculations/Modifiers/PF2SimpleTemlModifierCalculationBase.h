@@ -35,6 +35,15 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Attributes")
 	FGameplayTag ProficiencyRootTag;
 
+public:
+	// =================================================================================================================
+	// Public Methods - IPF2CalculationDependencyInterface Implementation
+	// =================================================================================================================
+	virtual FGameplayTagContainer GetSourceTagDependencies() const override;
+
+	virtual bool IsLevelDependent() const override;
+
+protected:
 	// =================================================================================================================
 	// Protected Methods
 	// =================================================================================================================
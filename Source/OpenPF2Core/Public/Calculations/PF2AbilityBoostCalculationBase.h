@@ -13,6 +13,9 @@
 /**
  * An MMC for boosting a single ability score.
  *
+ * All of the boosts to the same ability score can be applied through a single GE that has one stack per boost. In that
+ * case, this MMC calculates the combined boost of all stacks and returns the portion of it that each stack contributes.
+ *
  * Ability boosts are available via both an MMC and a "Gameplay Effect Execution Calculation" (GEX). Prefer the GEX
  * variation instead of this MMC variation whenever possible, as the GEX variation automatically increments the count of
  * how many boosts are applied.
@@ -39,8 +42,8 @@ class OPENPF2CORE_API UPF2AbilityBoostCalculationBase : public UPF2AbilityCalcul
 	 *	The current base value of the ability attribute.
 	 *
 	 * @return
-	 *	The amount of the boost to apply to the ability score. (This is just the boost; the ability score has not been
-	 *	added to the result).
+	 *	The amount of the boost that each stack of the GE applies to the ability score. (This is just the boost; the
+	 *	ability score has not been added to the result).
 	 */
 	virtual float DoCalculation(
 		const FGameplayEffectSpec& Spec,
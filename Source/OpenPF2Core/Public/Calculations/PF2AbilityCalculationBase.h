@@ -7,13 +7,17 @@
 
 #include <GameplayModMagnitudeCalculation.h>
 #include <CoreMinimal.h>
+
+#include "Calculations/PF2CalculationDependencyInterface.h"
+
 #include "PF2AbilityCalculationBase.generated.h"
 
 /**
  * Base class for MMCs that provide values based on captured character ability values.
  */
 UCLASS(Abstract)
-class OPENPF2CORE_API UPF2AbilityCalculationBase : public UGameplayModMagnitudeCalculation
+class OPENPF2CORE_API UPF2AbilityCalculationBase :
+	public UGameplayModMagnitudeCalculation, public IPF2CalculationDependencyInterface
 {
 	GENERATED_BODY()
 
@@ -23,6 +27,32 @@ public:
 	// =================================================================================================================
 	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
 
+	// =================================================================================================================
+	// Public Methods - IPF2CalculationDependencyInterface Implementation
+	// =================================================================================================================
+	/**
+	 * Gets the root tags of all source tags that this calculation reads.
+	 *
+	 * Ability calculations only read the captured ability score, so this default implementation returns no tags.
+	 * Sub-classes that also read tags (e.g., TEML proficiencies) must override this.
+	 *
+	 * @return
+	 *	The tags that this calculation depends upon.
+	 */
+	virtual FGameplayTagContainer GetSourceTagDependencies() const override;
+
+	/**
+	 * Determines whether the result of this calculation depends on the level of the GE spec (i.e., character level).
+	 *
+	 * Ability modifiers do not scale with level, so this default implementation returns false. Sub-classes that apply
+	 * a TEML proficiency bonus (which includes the character level) must override this.
+	 *
+	 * @return
+	 *	- TRUE if a change to the level of the spec may change the result of this calculation.
+	 *	- FALSE, otherwise.
+	 */
+	virtual bool IsLevelDependent() const override;
+
 protected:
 	// =================================================================================================================
 	// Protected Methods
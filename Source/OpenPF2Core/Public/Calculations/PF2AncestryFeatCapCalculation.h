@@ -7,13 +7,17 @@
 
 #include <GameplayModMagnitudeCalculation.h>
 #include <CoreMinimal.h>
+
+#include "Calculations/PF2CalculationDependencyInterface.h"
+
 #include "PF2AncestryFeatCapCalculation.generated.h"
 
 /**
  * An MMC for calculating how many ancestry feats a character is entitled to have at their current level.
  */
 UCLASS()
-class OPENPF2CORE_API UPF2AncestryFeatCapCalculation : public UGameplayModMagnitudeCalculation
+class OPENPF2CORE_API UPF2AncestryFeatCapCalculation :
+	public UGameplayModMagnitudeCalculation, public IPF2CalculationDependencyInterface
 {
 	GENERATED_BODY()
 
@@ -22,4 +26,11 @@ public:
 	// Public Methods
 	// =================================================================================================================
 	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
+
+	// =================================================================================================================
+	// Public Methods - IPF2CalculationDependencyInterface Implementation
+	// =================================================================================================================
+	virtual FGameplayTagContainer GetSourceTagDependencies() const override;
+
+	virtual bool IsLevelDependent() const override;
 };
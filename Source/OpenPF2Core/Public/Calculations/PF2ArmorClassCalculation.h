@@ -15,6 +15,9 @@
 #include <CoreMinimal.h>
 
 #include "GameplayModMagnitudeCalculation.h"
+
+#include "Calculations/PF2CalculationDependencyInterface.h"
+
 #include "PF2ArmorClassCalculation.generated.h"
 
 /**
@@ -26,7 +29,8 @@
  * bonus with their armor, plus their armor’s item bonus to AC and any other permanent bonuses and penalties."
  */
 UCLASS()
-class OPENPF2CORE_API UPF2ArmorClassCalculation : public UGameplayModMagnitudeCalculation
+class OPENPF2CORE_API UPF2ArmorClassCalculation :
+	public UGameplayModMagnitudeCalculation, public IPF2CalculationDependencyInterface
 {
 	GENERATED_BODY()
 
@@ -56,6 +60,50 @@ public:
 	 */
 	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
 
+	/**
+	 * Calculates this stat based on the given Dexterity modifier, character tags, and character level.
+	 *
+	 * This is the calculation that CalculateBaseMagnitude_Implementation() performs once it has captured the inputs
+	 * from a GE spec. It is also used to derive AC on clients (see FPF2DerivedStatistics).
+	 *
+	 * @param DexterityModifier
+	 *	The character's Dexterity modifier.
+	 * @param CharacterTags
+	 *	The tags on the character, which indicate the equipped armor and the character's armor proficiencies.
+	 * @param CharacterLevel
+	 *	The level of the character.
+	 *
+	 * @return
+	 *	The calculated stat value.
+	 */
+	float CalculateArmorClass(
+		const float                  DexterityModifier,
+		const FGameplayTagContainer* CharacterTags,
+		const float                  CharacterLevel) const;
+
+	// =================================================================================================================
+	// Public Methods - IPF2CalculationDependencyInterface Implementation
+	// =================================================================================================================
+	/**
+	 * Gets the root tags of all source tags that this calculation reads.
+	 *
+	 * AC depends only on the equipped armor type and the character's proficiency in each armor category.
+	 *
+	 * @return
+	 *	The tags that this calculation depends upon.
+	 */
+	virtual FGameplayTagContainer GetSourceTagDependencies() const override;
+
+	/**
+	 * Determines whether the result of this calculation depends on the level of the GE spec (i.e., character level).
+	 *
+	 * The armor proficiency bonus includes the character level, so this always returns true.
+	 *
+	 * @return
+	 *	TRUE.
+	 */
+	virtual bool IsLevelDependent() const override;
+
 protected:
 	// =================================================================================================================
 	// Protected Fields
@@ -79,13 +127,17 @@ protected:
 	/**
 	 * Calculates the bonus to AC gained from the type of armor being worn.
 	 *
-	 * @param Spec
-	 *	The Gameplay Effect (GE) specification that provides information about the character's attributes and tags.
+	 * @param SourceTags
+	 *	The tags on the character, which indicate the equipped armor and the character's armor proficiencies.
+	 * @param CharacterLevel
+	 *	The level of the character.
 	 *
 	 * @return
 	 *	The amount that the current armor type contributes to the character's AC modifier.
 	 */
-	float CalculateArmorTypeProficiencyBonus(const FGameplayEffectSpec& Spec) const;
+	float CalculateArmorTypeProficiencyBonus(
+		const FGameplayTagContainer* SourceTags,
+		const float                  CharacterLevel) const;
 
 	/**
 	 * Returns the type of armor that the character is wearing.
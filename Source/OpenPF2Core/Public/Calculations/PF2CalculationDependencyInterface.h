@@ -0,0 +1,58 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <GameplayTagContainer.h>
+#include <UObject/Interface.h>
+
+#include "PF2CalculationDependencyInterface.generated.h"
+
+UINTERFACE(MinimalAPI, meta=(CannotImplementInterfaceInBlueprint))
+class UPF2CalculationDependencyInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * An interface for OpenPF2 calculations (MMCs) that can describe which inputs influence their result.
+ *
+ * The ASC uses this information to determine which passive Gameplay Effects must be re-evaluated when the tags on a
+ * character change. Calculations that do not implement this interface are assumed to depend on every tag a character
+ * has, so they are always re-evaluated.
+ */
+class OPENPF2CORE_API IPF2CalculationDependencyInterface
+{
+	GENERATED_BODY()
+
+public:
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the root tags of all source tags that this calculation reads.
+	 *
+	 * A change to any tag that matches one of the returned tags (i.e., the tag itself or any of its children) may
+	 * change the result of the calculation. For example, a skill MMC that reads "Skill.Arcana" is affected by a change
+	 * to "Skill.Arcana.Trained" but not by a change to "Language.Common".
+	 *
+	 * @return
+	 *	The tags that this calculation depends upon. An empty container signifies that the calculation does not read
+	 *	any tags.
+	 */
+	virtual FGameplayTagContainer GetSourceTagDependencies() const = 0;
+
+	/**
+	 * Determines whether the result of this calculation depends on the level of the GE spec (i.e., character level).
+	 *
+	 * When a character levels up, the ASC updates the level of active passive GEs that use level-dependent
+	 * calculations in place, instead of removing and re-applying all passive GEs.
+	 *
+	 * @return
+	 *	- TRUE if a change to the level of the spec may change the result of this calculation.
+	 *	- FALSE, otherwise.
+	 */
+	virtual bool IsLevelDependent() const = 0;
+};
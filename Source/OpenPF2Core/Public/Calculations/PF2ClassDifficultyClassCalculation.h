@@ -38,4 +38,22 @@ public:
 	 * Default constructor for UPF2ClassDifficultyClassCalculation.
 	 */
 	explicit UPF2ClassDifficultyClassCalculation();
+
+	// =================================================================================================================
+	// Public Methods - UPF2KeyAbilityTemlCalculationBase Overrides
+	// =================================================================================================================
+	/**
+	 * Calculates the Class DC based on the Key Attribute captured by the provided GE specification.
+	 *
+	 * If the Class DC of the character was precalculated from the same inputs (see FPF2DerivedStatistics), the
+	 * precalculated value is used instead of calculating it again.
+	 *
+	 * @param Spec
+	 *	The Gameplay Effect (GE) specification that provides information about the character attributes for which a
+	 *	calculated stat is desired.
+	 *
+	 * @return
+	 *	The calculated Class DC.
+	 */
+	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
 };
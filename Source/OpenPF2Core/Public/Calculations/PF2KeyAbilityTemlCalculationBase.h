@@ -15,13 +15,16 @@
 #include <CoreMinimal.h>
 #include <GameplayModMagnitudeCalculation.h>
 
+#include "Calculations/PF2CalculationDependencyInterface.h"
+
 #include "PF2KeyAbilityTemlCalculationBase.generated.h"
 
 /**
  * Base class for MMCs that are based on the key ability of the character (Class DC, Spell Attack Roll, Spell DC, etc.).
  */
 UCLASS(Abstract)
-class OPENPF2CORE_API UPF2KeyAbilityTemlCalculationBase : public UGameplayModMagnitudeCalculation
+class OPENPF2CORE_API UPF2KeyAbilityTemlCalculationBase :
+	public UGameplayModMagnitudeCalculation, public IPF2CalculationDependencyInterface
 {
 	GENERATED_BODY()
 
@@ -74,6 +77,54 @@ public:
 	 */
 	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
 
+	/**
+	 * Calculates this stat based on the modifiers of the character's abilities.
+	 *
+	 * This performs the same calculation as CalculateBaseMagnitude_Implementation(), but without a GE spec. It is used
+	 * to derive this stat on clients and to precalculate it off the game thread (see FPF2DerivedStatistics).
+	 *
+	 * @param GetAbilityModifier
+	 *	A function that returns the modifier of the character in the ability of the given attribute.
+	 * @param CharacterTags
+	 *	The tags on the character, which indicate the character's Key Ability and their proficiency in this stat.
+	 * @param CharacterLevel
+	 *	The level of the character.
+	 * @param OutKeyAbilityModifier
+	 *	The variable to which the modifier of the character's Key Ability is written. This is 0 if the character has
+	 *	no Key Ability.
+	 *
+	 * @return
+	 *	The calculated stat value.
+	 */
+	float CalculateFromAbilityModifiers(
+		const TFunctionRef<float (const FGameplayAttribute&)> GetAbilityModifier,
+		const FGameplayTagContainer*                          CharacterTags,
+		const float                                           CharacterLevel,
+		float&                                                OutKeyAbilityModifier) const;
+
+	// =================================================================================================================
+	// Public Methods - IPF2CalculationDependencyInterface Implementation
+	// =================================================================================================================
+	/**
+	 * Gets the root tags of all source tags that this calculation reads.
+	 *
+	 * This includes the TEML proficiency tags of this stat and the tags that select the character's key ability.
+	 *
+	 * @return
+	 *	The tags that this calculation depends upon.
+	 */
+	virtual FGameplayTagContainer GetSourceTagDependencies() const override;
+
+	/**
+	 * Determines whether the result of this calculation depends on the level of the GE spec (i.e., character level).
+	 *
+	 * The TEML proficiency bonus of the stat includes the character level, so this always returns true.
+	 *
+	 * @return
+	 *	TRUE.
+	 */
+	virtual bool IsLevelDependent() const override;
+
 protected:
 	// =================================================================================================================
 	// Protected Fields
@@ -143,6 +194,24 @@ protected:
 	 */
 	float CalculateKeyAbilityModifier(const FGameplayEffectSpec& Spec) const;
 
+	/**
+	 * Calculates this stat from the character's Key Ability modifier and their proficiency in this stat.
+	 *
+	 * @param CharacterTags
+	 *	The tags on the character, which indicate the character's proficiency in this stat.
+	 * @param CharacterLevel
+	 *	The level of the character.
+	 * @param KeyAbilityModifier
+	 *	The modifier of the character's Key Ability.
+	 *
+	 * @return
+	 *	The calculated stat value.
+	 */
+	float CalculateAbilityScore(
+		const FGameplayTagContainer* CharacterTags,
+		const float                  CharacterLevel,
+		const float                  KeyAbilityModifier) const;
+
 	/**
 	 * Determines which ability is the character's key modifier.
 	 *
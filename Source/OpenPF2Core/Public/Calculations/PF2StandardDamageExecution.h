@@ -12,6 +12,9 @@
 
 /**
  * Damage execution calculation for applying damage and resistance logic according to standard PF2 rules.
+ *
+ * The immunity, weakness, and resistance of the target to the type of damage are looked up by damage type ordinal in
+ * the damage type table of the target's attribute set, rather than being captured as separate attributes.
  */
 UCLASS()
 // ReSharper disable once CppClassCanBeFinal
@@ -33,6 +36,11 @@ protected:
 	 */
 	const FName ResistanceParameterTagName = "GameplayEffect.Parameter.Resistance";
 
+	/**
+	 * Name of the tag under which all damage type tags are nested.
+	 */
+	const FName DamageTypeTagName = "DamageType";
+
 	// =================================================================================================================
 	// Protected Fields
 	// =================================================================================================================
@@ -45,14 +53,23 @@ protected:
 	FGameplayTag DamageParameterTag;
 
 	/**
-	 * The tag that is used to pass a dynamic damage amount into the calculation.
+	 * The tag for the parameter that is used to pass the resistance of the target into the calculation.
 	 *
-	 * The parameter should be provided via an attribute-based modifier that reads it from the appropriate resistance
-	 * attribute of the character's attribute set (e.g., typically an attribute having a name that starts with "Rst",
-	 * such as "RstPhysicalBludgeoning", "RstEnergyCold", etc.).
+	 * This is optional. When a GE does not supply it, the resistance of the target to the type of damage is looked up in
+	 * the damage type table of the target (see FPF2DamageTypeTable). When a GE does supply it, it replaces the
+	 * resistance from the table rather than adding to it, so that GEs that were written to capture the resistance of the
+	 * target themselves do not reduce damage twice. Immunity and weakness still come from the table either way.
 	 */
 	FGameplayTag ResistanceParameterTag;
 
+	/**
+	 * The tag under which all damage type tags are nested.
+	 *
+	 * The type of damage that a GE deals is the most specific tag under this tag in the asset tags of the GE spec,
+	 * including any dynamic asset tags (e.g., the damage type of the weapon that a GA used to make the attack).
+	 */
+	FGameplayTag DamageTypeTagParent;
+
 public:
 	// =================================================================================================================
 	// Constructors
@@ -65,4 +82,21 @@ public:
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams,
 										OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
 
+protected:
+	// =================================================================================================================
+	// Protected Methods
+	// =================================================================================================================
+	/**
+	 * Determines the type of damage that a GE deals from the asset tags of its spec.
+	 *
+	 * If the tags include both a damage category and a type within it (e.g., "DamageType.Physical" and
+	 * "DamageType.Physical.Slashing"), the deepest tag wins, since it is the most specific.
+	 *
+	 * @param AssetTags
+	 *	The asset tags of the GE spec, including dynamic asset tags.
+	 *
+	 * @return
+	 *	The tag of the type of damage; or an empty tag, if the GE spec has no damage type tags.
+	 */
+	FGameplayTag DetermineDamageType(const FGameplayTagContainer& AssetTags) const;
 };
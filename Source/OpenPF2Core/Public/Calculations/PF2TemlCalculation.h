@@ -18,6 +18,9 @@
  * character with the "SavingThrow.Reflex.Trained" and "Perception.Master" tags has a "Trained" proficiency in reflex
  * saving throws and "Master" proficiency in Perception, with the "SavingThrow.Reflex" and "Perception" tag prefixes,
  * respectively.
+ *
+ * A calculation only reads the tags and level it is given and has no shared state, so calculations can be performed
+ * on any thread.
  */
 class OPENPF2CORE_API FPF2TemlCalculation
 {
@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include <Tickable.h>
 #include <UObject/ScriptInterface.h>
 
 #include "PF2CharacterInterface.h"
+#include "PF2EncounterParticipantTable.h"
 #include "PF2ModeOfPlayRuleSetBase.h"
 #include "PF2QueuedActionInterface.h"
 
@@ -25,10 +27,15 @@
  * when it is their turn. This gives Blueprint sub-classes full control over how they want to implement combat, either
  * allowing each character to act one-by-one; or, cycling through characters at a rapid clip to keep combat flowing
  * despite the turn-based nature of PF2 rules.
+ *
+ * While an encounter is in progress, this class also publishes the stats of every participant once per frame, so that
+ * code running on worker threads (e.g., AI target selection) can read them without touching any UObjects.
  */
 UCLASS(Abstract, Blueprintable)
 // ReSharper disable once CppClassCanBeFinal
-class OPENPF2CORE_API UPF2EncounterModeOfPlayRuleSetBase : public UPF2ModeOfPlayRuleSetBase
+class OPENPF2CORE_API UPF2EncounterModeOfPlayRuleSetBase :
+	public UPF2ModeOfPlayRuleSetBase,
+	public FTickableGameObject
 {
 	GENERATED_BODY()
 
@@ -123,6 +130,11 @@ protected:
 	 */
 	int32 NextActionHandleId;
 
+	/**
+	 * The stats of the characters in the encounter, as of the last frame, for reading from other threads.
+	 */
+	FPF2EncounterParticipantTable ParticipantTable;
+
 public:
 	// =================================================================================================================
 	// Public Constructors
@@ -137,6 +149,34 @@ public:
 	{
 	}
 
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Gets the table of the stats of the characters in the encounter.
+	 *
+	 * The table is updated once per frame on the game thread, and can be read from any thread through
+	 * FPF2EncounterParticipantTable::Read().
+	 *
+	 * @return
+	 *	The participant table.
+	 */
+	FORCEINLINE const FPF2EncounterParticipantTable& GetParticipantTable() const
+	{
+		return this->ParticipantTable;
+	}
+
+	// =================================================================================================================
+	// Public Methods - FTickableGameObject Implementation
+	// =================================================================================================================
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
 protected:
 	// =================================================================================================================
 	// Protected Methods
@@ -381,4 +421,12 @@ protected:
 	 *	The character being removed from the map.
 	 */
 	void RemoveCharacterFromInitiativeMap(const IPF2CharacterInterface* Character);
+
+	/**
+	 * Captures the stats of every character in the encounter and publishes them to the participant table.
+	 *
+	 * If a reader on another thread is still holding onto the stats from two frames ago, nothing is published this
+	 * frame, and readers keep getting the stats from the last frame.
+	 */
+	void PublishParticipantStats();
 };
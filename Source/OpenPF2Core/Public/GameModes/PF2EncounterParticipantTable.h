@@ -0,0 +1,238 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <atomic>
+
+#include <CoreMinimal.h>
+#include <GameFramework/Actor.h>
+
+/**
+ * The stats of every participant in an encounter, as of a single frame, stored as a structure of arrays.
+ *
+ * Each array has one element per participant, in initiative order, so code that only needs one stat of every
+ * participant (e.g., AI looking for the most wounded foe) can scan a single packed array.
+ */
+struct OPENPF2CORE_API FPF2EncounterParticipantStats
+{
+	/**
+	 * The number of the frame during which these stats were captured (see GFrameCounter).
+	 */
+	uint64 FrameNumber;
+
+	/**
+	 * The actor of each participant.
+	 *
+	 * This is for identifying participants only. Actors must not be dereferenced off of the game thread.
+	 */
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	/**
+	 * The location of each participant in the world.
+	 */
+	TArray<FVector> Locations;
+
+	/**
+	 * The current hit points of each participant.
+	 */
+	TArray<float> HitPoints;
+
+	/**
+	 * The maximum hit points of each participant.
+	 */
+	TArray<float> MaxHitPoints;
+
+	/**
+	 * The armor class of each participant.
+	 */
+	TArray<float> ArmorClasses;
+
+	/**
+	 * The Fortitude saving throw modifier of each participant.
+	 */
+	TArray<float> FortitudeModifiers;
+
+	/**
+	 * The Reflex saving throw modifier of each participant.
+	 */
+	TArray<float> ReflexModifiers;
+
+	/**
+	 * The Will saving throw modifier of each participant.
+	 */
+	TArray<float> WillModifiers;
+
+	/**
+	 * Default constructor for FPF2EncounterParticipantStats.
+	 */
+	explicit FPF2EncounterParticipantStats() : FrameNumber(0)
+	{
+	}
+
+	/**
+	 * Gets the number of participants.
+	 *
+	 * @return
+	 *	The number of elements in each array.
+	 */
+	FORCEINLINE int32 Num() const
+	{
+		return this->Actors.Num();
+	}
+
+	/**
+	 * Sizes every array for the specified number of participants, keeping the memory that has already been allocated.
+	 *
+	 * @param NumParticipants
+	 *	The number of participants.
+	 */
+	void SetNum(const int32 NumParticipants);
+};
+
+/**
+ * A double-buffered table of the stats of the participants in an encounter, which other threads can read without locks.
+ *
+ * The game thread writes the stats for the next frame into the back buffer while other threads read the front buffer,
+ * and then the buffers are swapped. A reader holds onto the buffer it is reading through an FReadScope, which keeps the
+ * game thread from writing to that buffer until the reader is done with it. Readers should only hold onto a buffer for
+ * the duration of a single task; while a reader holds onto a buffer that is no longer the front buffer, the game thread
+ * keeps publishing to the other buffer, which means that new stats are not published.
+ */
+class OPENPF2CORE_API FPF2EncounterParticipantTable
+{
+public:
+	// =================================================================================================================
+	// Public Types
+	// =================================================================================================================
+	/**
+	 * A scope during which a reader has access to the most recently published stats.
+	 */
+	class OPENPF2CORE_API FReadScope
+	{
+	protected:
+		// =============================================================================================================
+		// Protected Fields
+		// =============================================================================================================
+		/**
+		 * The table being read.
+		 */
+		const FPF2EncounterParticipantTable& Table;
+
+		/**
+		 * The index of the buffer being read.
+		 */
+		const int32 BufferIndex;
+
+	public:
+		// =============================================================================================================
+		// Public Constructors
+		// =============================================================================================================
+		/**
+		 * Constructor for FReadScope.
+		 *
+		 * @param Table
+		 *	The table being read.
+		 * @param BufferIndex
+		 *	The index of the buffer being read. The reader count of the buffer must already have been incremented.
+		 */
+		explicit FReadScope(const FPF2EncounterParticipantTable& Table, const int32 BufferIndex) :
+			Table(Table),
+			BufferIndex(BufferIndex)
+		{
+		}
+
+		FReadScope(const FReadScope&) = delete;
+
+		FReadScope& operator=(const FReadScope&) = delete;
+
+		// =============================================================================================================
+		// Public Destructor
+		// =============================================================================================================
+		~FReadScope()
+		{
+			this->Table.ReaderCounts[this->BufferIndex].fetch_sub(1);
+		}
+
+		// =============================================================================================================
+		// Public Methods
+		// =============================================================================================================
+		/**
+		 * Gets the stats being read.
+		 *
+		 * @return
+		 *	The stats that were most recently published when this scope was opened.
+		 */
+		FORCEINLINE const FPF2EncounterParticipantStats& GetStats() const
+		{
+			return this->Table.Buffers[this->BufferIndex];
+		}
+	};
+
+protected:
+	// =================================================================================================================
+	// Protected Fields
+	// =================================================================================================================
+	/**
+	 * The front and back buffers.
+	 */
+	FPF2EncounterParticipantStats Buffers[2];
+
+	/**
+	 * The index of the front buffer, which is the one that readers get.
+	 */
+	std::atomic<int32> FrontBufferIndex;
+
+	/**
+	 * The number of readers of each buffer.
+	 */
+	mutable std::atomic<int32> ReaderCounts[2];
+
+public:
+	// =================================================================================================================
+	// Public Constructors
+	// =================================================================================================================
+	/**
+	 * Default constructor for FPF2EncounterParticipantTable.
+	 */
+	explicit FPF2EncounterParticipantTable() : FrontBufferIndex(0), ReaderCounts{{0}, {0}}
+	{
+	}
+
+	FPF2EncounterParticipantTable(const FPF2EncounterParticipantTable&) = delete;
+
+	FPF2EncounterParticipantTable& operator=(const FPF2EncounterParticipantTable&) = delete;
+
+	// =================================================================================================================
+	// Public Methods
+	// =================================================================================================================
+	/**
+	 * Opens a scope for reading the most recently published stats.
+	 *
+	 * This can be called from any thread.
+	 *
+	 * @return
+	 *	A scope through which the stats can be read until it goes out of scope.
+	 */
+	FReadScope Read() const;
+
+	/**
+	 * Gets the back buffer, so the game thread can write the next stats to it.
+	 *
+	 * This must only be called from the game thread, and must be followed by a call to Publish() if it succeeds.
+	 *
+	 * @return
+	 *	Either the back buffer; or, nullptr if a reader is still reading the back buffer, in which case no stats can be
+	 *	published until that reader is done.
+	 */
+	FPF2EncounterParticipantStats* BeginWrite();
+
+	/**
+	 * Swaps the buffers, making the stats that were written to the back buffer available to readers.
+	 *
+	 * This must only be called from the game thread, after a successful call to BeginWrite().
+	 */
+	void Publish();
+};
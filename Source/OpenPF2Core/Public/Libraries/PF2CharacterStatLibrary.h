@@ -18,6 +18,8 @@
 
 /**
  * Function library for standard PF2 character statistic calculations.
+ *
+ * All of the functions in this library are pure and have no shared state, so they can be called from any thread.
  */
 UCLASS()
 class UPF2CharacterStatLibrary final : public UBlueprintFunctionLibrary
@@ -26,6 +26,7 @@
 
 #include "Abilities/PF2AbilityBoostBase.h"
 #include "Abilities/PF2AbilitySystemComponent.h"
+#include "Abilities/PF2AbilitySystemReplicationPolicy.h"
 #include "Abilities/PF2AttributeSet.h"
 #include "Abilities/PF2CharacterAbilityScoreType.h"
 #include "Utilities/PF2GameplayAbilityUtilities.h"
@@ -124,6 +125,11 @@ protected:
 	 */
 	TMultiMap<FName, TSubclassOf<UGameplayEffect>> CoreGameplayEffects;
 
+	/**
+	 * The group of attributes that each of the core Gameplay Effects calculates.
+	 */
+	TMap<TSubclassOf<UGameplayEffect>, EPF2AttributeGroup> CoreGameplayEffectGroups;
+
 	/**
 	 * The list of passive Gameplay Effects (GEs) that are generated from other values specified on this character.
 	 *
@@ -162,9 +168,31 @@ protected:
 	/**
 	 * The current level of this character.
 	 */
-	UPROPERTY(EditAnywhere, Replicated, meta=(ClampMin=1), Category="Character")
+	UPROPERTY(EditAnywhere, ReplicatedUsing=OnRep_CharacterLevel, meta=(ClampMin=1), Category="Character")
 	int32 CharacterLevel;
 
+	/**
+	 * How the Gameplay Effects (GEs) on the ASC of this character are replicated to clients.
+	 *
+	 * Replicating active GEs to every client is expensive when there are many characters in play, and clients
+	 * typically only need the active GEs of the character they control. Background NPCs should use "Minimal"
+	 * replication, which still replicates attributes, tags, and cues. The policy is applied each time this character is
+	 * possessed.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Character")
+	EPF2AbilitySystemReplicationPolicy AbilitySystemReplicationPolicy;
+
+	/**
+	 * The groups of attributes that this character uses.
+	 *
+	 * Player characters use every group. NPCs and hazards that have no use for some groups (e.g., skills, or the
+	 * attributes used for character building) should exclude them, so that the core GEs that calculate those
+	 * attributes are not applied to this character and the attributes keep their default values. Attributes that never
+	 * change from their defaults are never replicated.
+	 */
+	UPROPERTY(EditDefaultsOnly, meta=(Bitmask, BitmaskEnum="EPF2AttributeGroup"), Category="Character")
+	int32 AttributeGroups;
+
 	/**
 	 * The ancestry and heritage of this character.
 	 *
@@ -343,16 +371,20 @@ protected:
 	explicit APF2CharacterBase(TPF2CharacterComponentFactory<AscType, AttributeSetType> ComponentFactory) :
 		bManagedPassiveEffectsGenerated(false),
 		CharacterName(FText::FromString(TEXT("Character"))),
-		CharacterLevel(1)
+		CharacterLevel(1),
+		AbilitySystemReplicationPolicy(EPF2AbilitySystemReplicationPolicy::Automatic),
+		AttributeGroups(static_cast<int32>(EPF2AttributeGroup::All))
 	{
 		this->AbilitySystemComponent = ComponentFactory.CreateAbilitySystemComponent(this);
 		this->AttributeSet           = ComponentFactory.CreateAttributeSet(this);
 
 		for (const TTuple<FString, FName>& EffectInfo : PF2CharacterConstants::GeCoreCharacterBlueprintPaths)
 		{
-			const FString Subfolder  = EffectInfo.Key;
-			const FName   EffectName = EffectInfo.Value;
-			const FString EffectPath = PF2CharacterConstants::GetBlueprintPath(EffectName, Subfolder);
+			const FString             Subfolder   = EffectInfo.Key;
+			const FName               EffectName  = EffectInfo.Value;
+			const FString             EffectPath  = PF2CharacterConstants::GetBlueprintPath(EffectName, Subfolder);
+			const EPF2AttributeGroup* EffectGroup =
+				PF2CharacterConstants::GeCoreCharacterAttributeGroups.Find(EffectName);
 
 			const ConstructorHelpers::FObjectFinder<UClass> EffectFinder(*EffectPath);
 			const TSubclassOf<UGameplayEffect>              GameplayEffect = EffectFinder.Object;
@@ -360,6 +392,11 @@ protected:
 			const FName WeightGroup = PF2GameplayAbilityUtilities::GetWeightGroupOfGameplayEffect(GameplayEffect);
 
 			this->CoreGameplayEffects.Add(WeightGroup, GameplayEffect);
+
+			this->CoreGameplayEffectGroups.Add(
+				GameplayEffect,
+				(EffectGroup == nullptr) ? EPF2AttributeGroup::Core : *EffectGroup
+			);
 		}
 	}
 
@@ -504,6 +541,18 @@ public:
 	virtual void RemoveRedundantPendingAbilityBoosts();
 
 protected:
+	// =================================================================================================================
+	// Protected Replication Callbacks
+	// =================================================================================================================
+	/**
+	 * Callback invoked on clients when the level of this character has been replicated.
+	 *
+	 * @param OldLevel
+	 *	The level that this character had before replication.
+	 */
+	UFUNCTION()
+	void OnRep_CharacterLevel(const int32 OldLevel);
+
 	// =================================================================================================================
 	// Protected Methods
 	// =================================================================================================================
@@ -519,6 +568,14 @@ protected:
 	 */
 	bool IsAuthorityForEffects() const;
 
+	/**
+	 * Gets the replication mode for the ASC of this character, according to the replication policy of this character.
+	 *
+	 * @return
+	 *	The replication mode that corresponds to AbilitySystemReplicationPolicy, given who controls this character.
+	 */
+	EGameplayEffectReplicationMode GetAbilitySystemReplicationMode() const;
+
 	/**
 	 * Activates the specified ability boost ability with the provided selections of which abilities to boost.
 	 */
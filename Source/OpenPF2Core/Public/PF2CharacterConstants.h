@@ -5,11 +5,18 @@
 
 #pragma once
 
+#include "Abilities/PF2AttributeGroup.h"
+
 /**
  * Constants related to PF2 character logic.
  */
 namespace PF2CharacterConstants
 {
+	/**
+	 * The highest level that a PF2 character can reach.
+	 */
+	static const int32 MaxCharacterLevel = 20;
+
 	/**
 	 * The name of each weight "group" for passive GEs on a character.
 	 *
@@ -95,16 +102,6 @@ namespace PF2CharacterConstants
 	 */
 	static const FString GeBlueprintBoostNameFormat = TEXT("GE_Boost{0}");
 
-	/**
-	 * The name of the Gameplay Effect that is used to apply tags that have been set on the character.
-	 */
-	static const FString GeDynamicTagsName = TEXT("GE_ApplyDynamicTags");
-
-	/**
-	* The name of the Gameplay Effect that is used to apply tags that have been set on the character.
-	*/
-	static const FString GeDynamicTagsClassName = FString::Format(TEXT("{0}_C"), { GeDynamicTagsName });
-
 	/**
 	 * Paths to Gameplay Effect Blueprints for core stat calculations in characters.
 	 *
@@ -112,11 +109,12 @@ namespace PF2CharacterConstants
 	 * first, followed by ancestry and class GEs, ability boost GEs, additional passive GEs, and then all other core
 	 * GEs. GEs that have the same weight group are applied in the order they have been added/listed here.
 	 *
-	 * Each key in this map is the sub-folder that contains the GE, while the value is the name of the GE.
+	 * Each entry is a pair of the sub-folder that contains the GE and the name of the GE. This is not a map, since
+	 * several GEs share the same sub-folder.
 	 *
 	 * TODO: Consider whether we want to move this list into a Blueprint UPROPERTY, so that it's not hard-coded.
 	 */
-	static const TMap<FString, FName> GeCoreCharacterBlueprintPaths = {
+	static const TArray<TTuple<FString, FName>> GeCoreCharacterBlueprintPaths = {
 		// Initialize base stats.
 		{BlueprintSubfolderRoot,                   TEXT("GE_ApplyBaseCharacterStats")     },
 		{BlueprintSubfolderRoot,                   TEXT("GE_GrantCharacterBaseAbilities") },
@@ -134,6 +132,18 @@ namespace PF2CharacterConstants
 		{BlueprintSubfolderCalculations,           TEXT("GE_CalcAncestryFeatLimit")       },
 	};
 
+	/**
+	 * The group of attributes calculated by each core GE that does not calculate core attributes.
+	 *
+	 * Each key in this map is the name of a GE in GeCoreCharacterBlueprintPaths, while the value is the group of
+	 * attributes that the GE calculates. GEs that are not listed here calculate attributes in the "Core" group. A core
+	 * GE is only applied to characters that use its group of attributes (see EPF2AttributeGroup).
+	 */
+	static const TMap<FName, EPF2AttributeGroup> GeCoreCharacterAttributeGroups = {
+		{TEXT("GE_CalcSkillModifiers"),    EPF2AttributeGroup::Skills            },
+		{TEXT("GE_CalcAncestryFeatLimit"), EPF2AttributeGroup::CharacterBuilding },
+	};
+
 	/**
 	 * Returns the path to the Blueprint having the given name.
 	 *
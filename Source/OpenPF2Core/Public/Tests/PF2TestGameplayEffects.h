@@ -0,0 +1,44 @@
+﻿// OpenPF2 for UE Game Logic, Copyright 2022, Guy Elsmore-Paddock. All Rights Reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayEffect.h>
+
+#include "PF2TestGameplayEffects.generated.h"
+
+/**
+ * A passive GE that grants "Armor.Equipped.Light" to elves, for testing dependencies between passive GEs.
+ *
+ * This GE reads "Trait.Creature.Elf" and writes "Armor.Equipped.Light", so GEs that read armor tags depend on it.
+ */
+UCLASS(NotBlueprintable)
+class OPENPF2CORE_API UPF2TestGrantArmorTagEffect : public UGameplayEffect
+{
+	GENERATED_UCLASS_BODY()
+};
+
+/**
+ * A passive GE that increases speed in light armor, for testing dependencies between passive GEs.
+ *
+ * This GE reads "Armor.Equipped.Light", so it depends on UPF2TestGrantArmorTagEffect.
+ */
+UCLASS(NotBlueprintable)
+class OPENPF2CORE_API UPF2TestArmorTagReaderEffect : public UGameplayEffect
+{
+	GENERATED_UCLASS_BODY()
+};
+
+/**
+ * A passive GE that sets max hit points from a snapshot of armor class, for testing dependencies between passive GEs.
+ *
+ * This GE reads the ArmorClass attribute as a snapshot, so it depends on any GE that modifies armor class.
+ */
+UCLASS(NotBlueprintable)
+class OPENPF2CORE_API UPF2TestArmorClassSnapshotEffect : public UGameplayEffect
+{
+	GENERATED_UCLASS_BODY()
+};
@@ -112,6 +112,9 @@ namespace PF2GameplayAbilityUtilities
 	 * If the GE does not define a default weight group, PF2CharacterConstants::GeWeightGroups::PreAbilityBoosts is
 	 * returned.
 	 *
+	 * The weight group tag of each GE is only looked up once and then cached, so this is cheap to call repeatedly. This
+	 * is safe to call from any thread.
+	 *
 	 * @param GameplayEffect
 	 *	The effect for which a weight group is desired.
 	 * @param DefaultWeight
@@ -125,6 +128,75 @@ namespace PF2GameplayAbilityUtilities
 		const FName DefaultWeight = PF2CharacterConstants::GeWeightGroups::PreAbilityBoosts
 	);
 
+	/**
+	 * Gets the ordinal of a weight group, for ordering weight groups relative to each other.
+	 *
+	 * The ordinal is the numeric prefix of the last part of the weight group name. For example, the ordinal of
+	 * "GameplayEffect.WeightGroup.15_PreAbilityBoosts" is 15. Weight groups with lower ordinals are applied before
+	 * weight groups with higher ordinals. The ordinal of each weight group is only parsed once and then cached. This is
+	 * safe to call from any thread.
+	 *
+	 * Weight groups are designer-extensible, so a weight group without a numeric prefix is not fatal; an error is logged
+	 * and the weight group is given the highest possible ordinal, so it gets applied after every weight group that has a
+	 * prefix (which matches where it fell when weight groups were ordered by name).
+	 *
+	 * @param WeightGroup
+	 *	The name of the weight group for which an ordinal is desired.
+	 *
+	 * @return
+	 *	The ordinal of the weight group.
+	 */
+	OPENPF2CORE_API int32 GetWeightGroupOrdinal(const FName WeightGroup);
+
+	/**
+	 * Determines whether one weight group is applied before another.
+	 *
+	 * Weight groups are ordered by ordinal, and then by name for weight groups that share the same ordinal. This is the
+	 * order in which a passive effect plan applies weight groups.
+	 *
+	 * @param WeightGroupA
+	 *	The name of the first weight group.
+	 * @param OrdinalA
+	 *	The ordinal of the first weight group (see GetWeightGroupOrdinal()).
+	 * @param WeightGroupB
+	 *	The name of the second weight group.
+	 * @param OrdinalB
+	 *	The ordinal of the second weight group (see GetWeightGroupOrdinal()).
+	 *
+	 * @return
+	 *	- TRUE if the first weight group is applied before the second weight group.
+	 *	- FALSE, otherwise.
+	 */
+	OPENPF2CORE_API bool IsWeightGroupBefore(const FName WeightGroupA,
+	                                         const int32 OrdinalA,
+	                                         const FName WeightGroupB,
+	                                         const int32 OrdinalB);
+
+	/**
+	 * Gets all of the damage type tags known to the project, in ordinal order.
+	 *
+	 * This is every tag under "DamageType" (see Config/Tags/PF2DamageTypes.ini), including the tags for categories of
+	 * damage (e.g., "DamageType.Physical"). Tags are in the order of the gameplay tag tree, which is sorted by name, so
+	 * the ordinal of each damage type is the same on every machine that loads the same tag configuration. The list is
+	 * built the first time this is called after the gameplay tags have been loaded, and then cached.
+	 *
+	 * @return
+	 *	The tag of each damage type, indexed by damage type ordinal. Empty if the gameplay tags have not been loaded.
+	 */
+	OPENPF2CORE_API const TArray<FGameplayTag>& GetDamageTypeTags();
+
+	/**
+	 * Gets the ordinal of a damage type, for indexing into arrays that have one element per damage type.
+	 *
+	 * @param DamageType
+	 *	The tag of the damage type for which an ordinal is desired.
+	 *
+	 * @return
+	 *	Either the ordinal of the damage type, from 0 to the number of tags returned by GetDamageTypeTags() - 1; or
+	 *	INDEX_NONE if the tag is not a damage type.
+	 */
+	OPENPF2CORE_API int32 GetDamageTypeOrdinal(const FGameplayTag DamageType);
+
 	/**
 	 * Gets the ASC of the given actor, as an implementation of IPF2CharacterAbilitySystemComponentInterface.
 	 *